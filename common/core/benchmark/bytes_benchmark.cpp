@@ -0,0 +1,89 @@
+/**
+ * @file
+ * @brief SIMD kernels of ara/core/bytes.h versus their scalar fallbacks
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+
+#include "ara/core/bytes.h"
+#include "ara/core/string.h"
+#include "ara/core/vector.h"
+
+namespace {
+
+using ara::core::Byte;
+using ara::core::Span;
+using ara::core::Vector;
+
+Vector<Byte> MakeData(std::size_t size) {
+  std::mt19937 random(42U);
+  Vector<Byte> data(size);
+  for (auto& b : data) {
+    b = static_cast<Byte>(random());
+  }
+  return data;
+}
+
+void BM_Crc32cScalar(benchmark::State& state) {
+  const auto data = MakeData(static_cast<std::size_t>(state.range(0)));
+  const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ara::core::bytes::internal::Crc32cScalar(~0U, p, data.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Crc32c(benchmark::State& state) {
+  const auto data = MakeData(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ara::core::bytes::Crc32c(Span<const Byte>(data.data(), data.size())));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_HexEncodeScalar(benchmark::State& state) {
+  const auto data = MakeData(static_cast<std::size_t>(state.range(0)));
+  ara::core::String out(2U * data.size(), '\0');
+  const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+  for (auto _ : state) {
+    ara::core::bytes::internal::HexEncodeScalar(p, data.size(), &out[0], ara::core::bytes::internal::kHexLower);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_HexEncode(benchmark::State& state) {
+  const auto data = MakeData(static_cast<std::size_t>(state.range(0)));
+  ara::core::String out(2U * data.size(), '\0');
+  for (auto _ : state) {
+    ara::core::bytes::HexEncode(Span<const Byte>(data.data(), data.size()), Span<char>(&out[0], out.size()));
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Base64Encode(benchmark::State& state) {
+  const auto data = MakeData(static_cast<std::size_t>(state.range(0)));
+  ara::core::String out(ara::core::bytes::Base64EncodedSize(data.size()), '\0');
+  for (auto _ : state) {
+    ara::core::bytes::Base64Encode(Span<const Byte>(data.data(), data.size()), Span<char>(&out[0], out.size()));
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_Crc32cScalar)->Arg(64)->Arg(4096);
+BENCHMARK(BM_Crc32c)->Arg(64)->Arg(4096);
+BENCHMARK(BM_HexEncodeScalar)->Arg(64)->Arg(4096);
+BENCHMARK(BM_HexEncode)->Arg(64)->Arg(4096);
+BENCHMARK(BM_Base64Encode)->Arg(64)->Arg(4096);
+
+BENCHMARK_MAIN();
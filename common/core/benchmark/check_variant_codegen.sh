@@ -0,0 +1,32 @@
+#!/bin/sh
+# Compile variant_codegen.cpp to assembly and check that every Visit*
+# function is instruction for instruction the same as its Switch* twin.
+#
+# usage: check_variant_codegen.sh <c++ compiler> <common/core directory>
+
+set -eu
+
+CXX=${1:-c++}
+ROOT=${2:-$(dirname "$0")/..}
+ASM=$(mktemp)
+trap 'rm -f "$ASM" "$ASM".a "$ASM".b' EXIT
+
+"$CXX" -std=c++14 -O2 -S -I"$ROOT/include/public" "$ROOT/benchmark/variant_codegen.cpp" -o "$ASM"
+
+# Body of function $1 without directives, labels renamed so that only the
+# instructions are compared.
+body() {
+  awk -v f="$1:" '$0 == f { p = 1; next } p && /\.cfi_endproc/ { exit } p' "$ASM" |
+    grep -v '^[[:space:]]*\.' | sed 's/\.L[A-Za-z0-9_]*/.L/g'
+}
+
+status=0
+for pair in Single Double; do
+  body "Visit$pair" > "$ASM".a
+  body "Switch$pair" > "$ASM".b
+  if [ ! -s "$ASM".a ] || ! diff -u "$ASM".b "$ASM".a; then
+    echo "Visit$pair does not compile to the same code as Switch$pair" >&2
+    status=1
+  fi
+done
+exit $status
@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @brief FlatMap versus Map for lookup, build and iteration
+ *
+ * Run with e.g. --benchmark_filter=Find to compare lookups only.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include "ara/core/flat_map.h"
+#include "ara/core/map.h"
+#include "ara/core/string.h"
+#include "ara/core/string_view.h"
+#include "ara/core/vector.h"
+
+namespace {
+
+using ara::core::FlatMap;
+using ara::core::Map;
+using ara::core::String;
+using ara::core::StringView;
+using ara::core::Vector;
+
+Vector<int> MakeIntKeys(std::size_t n) {
+  Vector<int> keys(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    keys[i] = static_cast<int>(i * 2U);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42U));
+  return keys;
+}
+
+Vector<String> MakeStringKeys(std::size_t n) {
+  Vector<String> keys;
+  keys.reserve(n);
+  char buffer[48];
+  for (int key : MakeIntKeys(n)) {
+    std::snprintf(buffer, sizeof(buffer), "/vehicle/sensor/topic_%08d", key);
+    keys.emplace_back(buffer);
+  }
+  return keys;
+}
+
+template <typename M, typename Keys>
+M MakeMap(const Keys& keys) {
+  M m;
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    m.emplace(keys[i], static_cast<int>(i));
+  }
+  return m;
+}
+
+template <typename M>
+void BM_FindInt(benchmark::State& state) {
+  const auto keys = MakeIntKeys(static_cast<std::size_t>(state.range(0)));
+  const auto m = MakeMap<M>(keys);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(m.find(keys[i]));
+    if (++i == keys.size()) {
+      i = 0;
+    }
+  }
+}
+
+template <typename M>
+void BM_FindString(benchmark::State& state) {
+  const auto keys = MakeStringKeys(static_cast<std::size_t>(state.range(0)));
+  const auto m = MakeMap<M>(keys);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(m.find(keys[i]));
+    if (++i == keys.size()) {
+      i = 0;
+    }
+  }
+}
+
+// What a caller holding a StringView pays: FlatMap searches with it directly,
+// Map<String, int> has to materialize a String first.
+void BM_FindStringViewFlatMap(benchmark::State& state) {
+  const auto keys = MakeStringKeys(static_cast<std::size_t>(state.range(0)));
+  const auto m = MakeMap<FlatMap<String, int>>(keys);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(m.find(StringView(keys[i].data(), keys[i].size())));
+    if (++i == keys.size()) {
+      i = 0;
+    }
+  }
+}
+
+void BM_FindStringViewMap(benchmark::State& state) {
+  const auto keys = MakeStringKeys(static_cast<std::size_t>(state.range(0)));
+  const auto m = MakeMap<Map<String, int>>(keys);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    StringView view(keys[i].data(), keys[i].size());
+    benchmark::DoNotOptimize(m.find(String(view.data(), view.size())));
+    if (++i == keys.size()) {
+      i = 0;
+    }
+  }
+}
+
+template <typename M>
+void BM_Iterate(benchmark::State& state) {
+  const auto m = MakeMap<M>(MakeIntKeys(static_cast<std::size_t>(state.range(0))));
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    for (const auto& kv : m) {
+      sum += kv.second;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Build from unsorted input: one insert per element for Map, a single sort
+// for FlatMap.
+void BM_BuildMap(benchmark::State& state) {
+  const auto keys = MakeIntKeys(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    Map<int, int> m;
+    for (int key : keys) {
+      m.emplace(key, key);
+    }
+    benchmark::DoNotOptimize(m);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BuildFlatMap(benchmark::State& state) {
+  const auto keys = MakeIntKeys(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    Vector<std::pair<int, int>> input;
+    input.reserve(keys.size());
+    for (int key : keys) {
+      input.emplace_back(key, key);
+    }
+    FlatMap<int, int> m(std::move(input));
+    benchmark::DoNotOptimize(m);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+#define ARA_CORE_FLAT_MAP_SIZES RangeMultiplier(8)->Range(16, 100000)
+
+BENCHMARK_TEMPLATE(BM_FindInt, Map<int, int>)->ARA_CORE_FLAT_MAP_SIZES;
+BENCHMARK_TEMPLATE(BM_FindInt, FlatMap<int, int>)->ARA_CORE_FLAT_MAP_SIZES;
+BENCHMARK_TEMPLATE(BM_FindString, Map<String, int>)->ARA_CORE_FLAT_MAP_SIZES;
+BENCHMARK_TEMPLATE(BM_FindString, FlatMap<String, int>)->ARA_CORE_FLAT_MAP_SIZES;
+BENCHMARK(BM_FindStringViewMap)->ARA_CORE_FLAT_MAP_SIZES;
+BENCHMARK(BM_FindStringViewFlatMap)->ARA_CORE_FLAT_MAP_SIZES;
+BENCHMARK_TEMPLATE(BM_Iterate, Map<int, int>)->ARA_CORE_FLAT_MAP_SIZES;
+BENCHMARK_TEMPLATE(BM_Iterate, FlatMap<int, int>)->ARA_CORE_FLAT_MAP_SIZES;
+BENCHMARK(BM_BuildMap)->ARA_CORE_FLAT_MAP_SIZES;
+BENCHMARK(BM_BuildFlatMap)->ARA_CORE_FLAT_MAP_SIZES;
+
+BENCHMARK_MAIN();
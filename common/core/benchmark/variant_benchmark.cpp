@@ -0,0 +1,123 @@
+/**
+ * @file
+ * @brief ara::core::visit versus a hand-written switch on index()
+ *
+ * check_variant_codegen.sh verifies that both compile to the same code, this
+ * measures it, together with the cost of copying a trivially copyable
+ * Variant.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+
+#include "ara/core/variant.h"
+#include "ara/core/vector.h"
+
+namespace {
+
+using ara::core::Variant;
+using ara::core::Vector;
+
+using Message = Variant<std::int32_t, std::int64_t, float, double, char>;
+
+struct Sum {
+  double operator()(std::int32_t v) const { return v * 3; }
+  double operator()(std::int64_t v) const { return static_cast<double>(v + 7); }
+  double operator()(float v) const { return v * 0.5F; }
+  double operator()(double v) const { return v - 1.0; }
+  double operator()(char v) const { return v; }
+
+  double operator()(std::int32_t a, double b) const { return a + b; }
+  template <typename A, typename B>
+  double operator()(A a, B b) const {
+    return (*this)(a) * (*this)(b);
+  }
+};
+
+Vector<Message> MakeMessages(std::size_t n) {
+  std::mt19937 random(42U);
+  Vector<Message> messages;
+  messages.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    switch (random() % 5U) {
+      case 0: messages.emplace_back(static_cast<std::int32_t>(i)); break;
+      case 1: messages.emplace_back(static_cast<std::int64_t>(i)); break;
+      case 2: messages.emplace_back(static_cast<float>(i)); break;
+      case 3: messages.emplace_back(static_cast<double>(i)); break;
+      default: messages.emplace_back(static_cast<char>(i)); break;
+    }
+  }
+  return messages;
+}
+
+double Switch(const Message& m) {
+  switch (m.index()) {
+    case 0: return Sum{}(*ara::core::get_if<0>(&m));
+    case 1: return Sum{}(*ara::core::get_if<1>(&m));
+    case 2: return Sum{}(*ara::core::get_if<2>(&m));
+    case 3: return Sum{}(*ara::core::get_if<3>(&m));
+    default: return Sum{}(*ara::core::get_if<4>(&m));
+  }
+}
+
+void BM_Visit(benchmark::State& state) {
+  const auto messages = MakeMessages(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (const auto& m : messages) {
+      sum += ara::core::visit(Sum{}, m);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Switch(benchmark::State& state) {
+  const auto messages = MakeMessages(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (const auto& m : messages) {
+      sum += Switch(m);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Two variants at once, 25 combinations behind a single dispatch.
+void BM_VisitPair(benchmark::State& state) {
+  const auto messages = MakeMessages(static_cast<std::size_t>(state.range(0)) + 1U);
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i + 1U < messages.size(); ++i) {
+      sum += ara::core::visit(Sum{}, messages[i], messages[i + 1U]);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Trivially copyable alternatives make this a plain memcpy.
+void BM_Copy(benchmark::State& state) {
+  const auto messages = MakeMessages(static_cast<std::size_t>(state.range(0)));
+  Vector<Message> copy(messages.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+      copy[i] = messages[i];
+    }
+    benchmark::DoNotOptimize(copy.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_Visit)->Arg(1024);
+BENCHMARK(BM_Switch)->Arg(1024);
+BENCHMARK(BM_VisitPair)->Arg(1024);
+BENCHMARK(BM_Copy)->Arg(1024);
+
+BENCHMARK_MAIN();
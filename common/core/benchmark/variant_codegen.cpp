@@ -0,0 +1,68 @@
+/**
+ * @file
+ * @brief Pairs of functions that must compile to the same code
+ *
+ * check_variant_codegen.sh compiles this file to assembly and compares each
+ * Visit* function with its hand-written Switch* counterpart. A difference
+ * means ara::core::visit lost its jump table or a valueless check crept back
+ * into the dispatch of trivially copyable alternatives.
+ */
+
+#include <cstdint>
+
+#include "ara/core/variant.h"
+
+namespace {
+
+using Message = ara::core::Variant<std::int32_t, std::int64_t, float, double, char>;
+using Pair = ara::core::Variant<std::int32_t, double>;
+
+struct Scale {
+  double operator()(std::int32_t v) const { return v * 3; }
+  double operator()(std::int64_t v) const { return static_cast<double>(v + 7); }
+  double operator()(float v) const { return v * 0.5F; }
+  double operator()(double v) const { return v - 1.0; }
+  double operator()(char v) const { return v; }
+};
+
+struct Combine {
+  double operator()(std::int32_t a, std::int32_t b) const { return a * b; }
+  double operator()(std::int32_t a, double b) const { return a + b; }
+  double operator()(double a, std::int32_t b) const { return a - b; }
+  double operator()(double a, double b) const { return a / b; }
+};
+
+}  // namespace
+
+extern "C" double VisitSingle(const Message& m) { return ara::core::visit(Scale{}, m); }
+
+extern "C" double SwitchSingle(const Message& m) {
+  switch (m.index()) {
+    case 0: return Scale{}(*ara::core::get_if<0>(&m));
+    case 1: return Scale{}(*ara::core::get_if<1>(&m));
+    case 2: return Scale{}(*ara::core::get_if<2>(&m));
+    case 3: return Scale{}(*ara::core::get_if<3>(&m));
+    case 4: return Scale{}(*ara::core::get_if<4>(&m));
+    default: __builtin_unreachable();
+  }
+}
+
+extern "C" double VisitDouble(const Pair& a, const Pair& b) { return ara::core::visit(Combine{}, a, b); }
+
+extern "C" double SwitchDouble(const Pair& a, const Pair& b) {
+  switch (a.index()) {
+    case 0:
+      switch (b.index()) {
+        case 0: return Combine{}(*ara::core::get_if<0>(&a), *ara::core::get_if<0>(&b));
+        case 1: return Combine{}(*ara::core::get_if<0>(&a), *ara::core::get_if<1>(&b));
+        default: __builtin_unreachable();
+      }
+    case 1:
+      switch (b.index()) {
+        case 0: return Combine{}(*ara::core::get_if<1>(&a), *ara::core::get_if<0>(&b));
+        case 1: return Combine{}(*ara::core::get_if<1>(&a), *ara::core::get_if<1>(&b));
+        default: __builtin_unreachable();
+      }
+    default: __builtin_unreachable();
+  }
+}
@@ -86,3 +86,15 @@ function(build_test project_name)
         DESTINATION ${PROJECT_SOURCE_DIR}/test/)
     set(CMAKE_CLEAN_FILES "${PROJECT_SOURCE_DIR}/test/${project_name};${CMAKE_CLEAN_FILES}" CACHE STRING INSTERNAL FORCE)
 endfunction()
+function(build_benchmark project_name)
+    find_package(benchmark REQUIRED)
+
+    set(PROJECT_SOURCE_DIR ${CMAKE_CURRENT_SOURCE_DIR})
+
+    include_directories(${PROJECT_SOURCE_DIR}/include/public)
+
+    add_executable(${project_name} "${PROJECT_SOURCE_DIR}/benchmark/${project_name}.cpp")
+    target_compile_options(${project_name} PRIVATE -O2)
+    target_link_libraries(${project_name} benchmark::benchmark ${CMAKE_THREAD_LIBS_INIT})
+    target_include_directories(${project_name} PUBLIC core)
+endfunction()
@@ -0,0 +1,394 @@
+/**
+ * @file
+ * @brief Byte utilities over ara::core::Span: CRC32C, hex and base64
+ * encoding, delimiter search and endian aware load/store
+ *
+ * CRC32C and hex encoding pick a SIMD kernel once, at the first call, from
+ * what the CPU supports: SSE4.2 / AVX2 / SSSE3 on x86-64, the CRC and NEON
+ * extensions on AArch64 when the compiler targets them. Every kernel has a
+ * portable scalar fallback with identical results.
+ */
+
+#ifndef TUSIMPLEAP_ARA_CORE_BYTES_H_
+#define TUSIMPLEAP_ARA_CORE_BYTES_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "ara/core/span.h"
+#include "ara/core/string.h"
+#include "ara/core/utility.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ARA_CORE_BYTES_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define ARA_CORE_BYTES_ARM_CRC 1
+#include <arm_acle.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define ARA_CORE_BYTES_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace ara {
+namespace core {
+namespace bytes {
+
+/// @brief Returned by Find() if the byte does not occur.
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+namespace internal {
+
+// ---- CRC32C (Castagnoli, reflected polynomial 0x82f63b78) ----
+
+struct Crc32cTable {
+  std::uint32_t entries[256];
+
+  constexpr Crc32cTable() : entries() {
+    for (std::uint32_t i = 0U; i < 256U; ++i) {
+      std::uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc >> 1) ^ ((crc & 1U) != 0U ? 0x82f63b78U : 0U);
+      }
+      entries[i] = crc;
+    }
+  }
+};
+
+// All CRC kernels work on the inverted state, Crc32c() does the inversion.
+inline std::uint32_t Crc32cScalar(std::uint32_t crc, const unsigned char* data, std::size_t size) noexcept {
+  static constexpr Crc32cTable kTable {};
+  for (std::size_t i = 0U; i < size; ++i) {
+    crc = kTable.entries[(crc ^ data[i]) & 0xffU] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(ARA_CORE_BYTES_X86)
+__attribute__((target("sse4.2"))) inline std::uint32_t Crc32cSse42(
+    std::uint32_t crc, const unsigned char* data, std::size_t size) noexcept {
+  std::uint64_t crc64 = crc;
+  for (; size >= 8U; size -= 8U, data += 8U) {
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+  crc = static_cast<std::uint32_t>(crc64);
+  for (; size > 0U; --size, ++data) {
+    crc = _mm_crc32_u8(crc, *data);
+  }
+  return crc;
+}
+#endif
+
+#if defined(ARA_CORE_BYTES_ARM_CRC)
+inline std::uint32_t Crc32cArm(std::uint32_t crc, const unsigned char* data, std::size_t size) noexcept {
+  for (; size >= 8U; size -= 8U, data += 8U) {
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    crc = __crc32cd(crc, word);
+  }
+  for (; size > 0U; --size, ++data) {
+    crc = __crc32cb(crc, *data);
+  }
+  return crc;
+}
+#endif
+
+using Crc32cKernel = std::uint32_t (*)(std::uint32_t, const unsigned char*, std::size_t);
+
+inline Crc32cKernel SelectCrc32c() noexcept {
+#if defined(ARA_CORE_BYTES_X86)
+  if (__builtin_cpu_supports("sse4.2")) {
+    return &Crc32cSse42;
+  }
+#elif defined(ARA_CORE_BYTES_ARM_CRC)
+  return &Crc32cArm;
+#endif
+  return &Crc32cScalar;
+}
+
+// ---- hex ----
+
+constexpr char kHexLower[] = "0123456789abcdef";
+constexpr char kHexUpper[] = "0123456789ABCDEF";
+
+// Each kernel encodes a whole number of its blocks and returns how many
+// input bytes it consumed, HexEncodeScalar finishes the rest.
+inline std::size_t HexEncodeScalar(const unsigned char* in, std::size_t size, char* out, const char* digits) noexcept {
+  for (std::size_t i = 0U; i < size; ++i) {
+    out[2U * i] = digits[in[i] >> 4];
+    out[2U * i + 1U] = digits[in[i] & 0x0fU];
+  }
+  return size;
+}
+
+#if defined(ARA_CORE_BYTES_X86)
+__attribute__((target("ssse3"))) inline std::size_t HexEncodeSsse3(
+    const unsigned char* in, std::size_t size, char* out, const char* digits) noexcept {
+  const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  std::size_t i = 0U;
+  for (; i + 16U <= size; i += 16U) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+    __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(v, mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2U * i), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2U * i + 16U), _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) inline std::size_t HexEncodeAvx2(
+    const unsigned char* in, std::size_t size, char* out, const char* digits) noexcept {
+  const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  std::size_t i = 0U;
+  for (; i + 32U <= size; i += 32U) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+    __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, mask));
+    // unpack works per 128 bit lane: a holds bytes 0-7 and 16-23, b 8-15
+    // and 24-31.
+    __m256i a = _mm256_unpacklo_epi8(hi, lo);
+    __m256i b = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2U * i), _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2U * i + 32U), _mm256_permute2x128_si256(a, b, 0x31));
+  }
+  return i;
+}
+#endif
+
+#if defined(ARA_CORE_BYTES_NEON)
+inline std::size_t HexEncodeNeon(const unsigned char* in, std::size_t size, char* out, const char* digits) noexcept {
+  const uint8x16_t table = vld1q_u8(reinterpret_cast<const std::uint8_t*>(digits));
+  const uint8x16_t mask = vdupq_n_u8(0x0f);
+  std::size_t i = 0U;
+  for (; i + 16U <= size; i += 16U) {
+    uint8x16_t v = vld1q_u8(in + i);
+    uint8x16x2_t hex;
+    hex.val[0] = vqtbl1q_u8(table, vshrq_n_u8(v, 4));
+    hex.val[1] = vqtbl1q_u8(table, vandq_u8(v, mask));
+    vst2q_u8(reinterpret_cast<std::uint8_t*>(out + 2U * i), hex);  // interleaves hi and lo
+  }
+  return i;
+}
+#endif
+
+using HexKernel = std::size_t (*)(const unsigned char*, std::size_t, char*, const char*);
+
+inline HexKernel SelectHexEncode() noexcept {
+#if defined(ARA_CORE_BYTES_X86)
+  if (__builtin_cpu_supports("avx2")) {
+    return &HexEncodeAvx2;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return &HexEncodeSsse3;
+  }
+#elif defined(ARA_CORE_BYTES_NEON)
+  return &HexEncodeNeon;
+#endif
+  return &HexEncodeScalar;
+}
+
+// ---- endian ----
+
+template <typename T>
+using EnableIfInteger = typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type;
+
+inline std::uint8_t ByteSwap(std::uint8_t v) noexcept { return v; }
+inline std::uint16_t ByteSwap(std::uint16_t v) noexcept { return __builtin_bswap16(v); }
+inline std::uint32_t ByteSwap(std::uint32_t v) noexcept { return __builtin_bswap32(v); }
+inline std::uint64_t ByteSwap(std::uint64_t v) noexcept { return __builtin_bswap64(v); }
+
+template <std::size_t N>
+struct UnsignedOfSize;
+template <>
+struct UnsignedOfSize<1> {
+  using type = std::uint8_t;
+};
+template <>
+struct UnsignedOfSize<2> {
+  using type = std::uint16_t;
+};
+template <>
+struct UnsignedOfSize<4> {
+  using type = std::uint32_t;
+};
+template <>
+struct UnsignedOfSize<8> {
+  using type = std::uint64_t;
+};
+
+template <typename T>
+T ByteSwapValue(T value) noexcept {
+  using U = typename UnsignedOfSize<sizeof(T)>::type;
+  U bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  bits = ByteSwap(bits);
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+constexpr bool kLittleEndian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+}  // namespace internal
+
+/**
+ * @brief CRC32C (Castagnoli) of @a data, as used by iSCSI, ext4 and SCTP.
+ *
+ * Pass the result of a previous call as @a crc to continue a checksum over
+ * several buffers.
+ */
+inline std::uint32_t Crc32c(Span<const Byte> data, std::uint32_t crc = 0U) noexcept {
+  static const internal::Crc32cKernel kernel = internal::SelectCrc32c();
+  return ~kernel(~crc, reinterpret_cast<const unsigned char*>(data.data()), static_cast<std::size_t>(data.size()));
+}
+
+/// @brief Digit case used by HexEncode().
+enum class HexCase : std::uint8_t { kLower, kUpper };
+
+/// @brief Number of characters HexEncode() writes for @a size bytes.
+constexpr std::size_t HexEncodedSize(std::size_t size) noexcept { return 2U * size; }
+
+/**
+ * @brief Write two hex digits per byte of @a in to @a out, no terminator.
+ *
+ * @returns the number of characters written, or 0 if @a out is smaller than
+ *          HexEncodedSize(in.size())
+ */
+inline std::size_t HexEncode(Span<const Byte> in, Span<char> out, HexCase letters = HexCase::kLower) noexcept {
+  static const internal::HexKernel kernel = internal::SelectHexEncode();
+  const std::size_t size = static_cast<std::size_t>(in.size());
+  if (static_cast<std::size_t>(out.size()) < HexEncodedSize(size)) {
+    return 0U;
+  }
+  const char* digits = letters == HexCase::kUpper ? internal::kHexUpper : internal::kHexLower;
+  const auto* src = reinterpret_cast<const unsigned char*>(in.data());
+  std::size_t done = kernel(src, size, out.data(), digits);
+  internal::HexEncodeScalar(src + done, size - done, out.data() + 2U * done, digits);
+  return HexEncodedSize(size);
+}
+
+/// @brief HexEncode() into a new String.
+inline String HexEncode(Span<const Byte> in, HexCase letters = HexCase::kLower) {
+  String result(HexEncodedSize(static_cast<std::size_t>(in.size())), '\0');
+  HexEncode(in, Span<char>(&result[0], result.size()), letters);
+  return result;
+}
+
+/// @brief Number of characters Base64Encode() writes for @a size bytes.
+constexpr std::size_t Base64EncodedSize(std::size_t size) noexcept { return (size + 2U) / 3U * 4U; }
+
+/**
+ * @brief Standard base64 (RFC 4648, with '=' padding) of @a in into @a out,
+ * no terminator.
+ *
+ * @returns the number of characters written, or 0 if @a out is smaller than
+ *          Base64EncodedSize(in.size())
+ */
+inline std::size_t Base64Encode(Span<const Byte> in, Span<char> out) noexcept {
+  static constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  const std::size_t size = static_cast<std::size_t>(in.size());
+  if (static_cast<std::size_t>(out.size()) < Base64EncodedSize(size)) {
+    return 0U;
+  }
+  const auto* src = reinterpret_cast<const unsigned char*>(in.data());
+  char* dst = out.data();
+  std::size_t i = 0U;
+  for (; i + 3U <= size; i += 3U) {
+    const std::uint32_t group = (std::uint32_t {src[i]} << 16) | (std::uint32_t {src[i + 1U]} << 8) | src[i + 2U];
+    *dst++ = kAlphabet[(group >> 18) & 0x3fU];
+    *dst++ = kAlphabet[(group >> 12) & 0x3fU];
+    *dst++ = kAlphabet[(group >> 6) & 0x3fU];
+    *dst++ = kAlphabet[group & 0x3fU];
+  }
+  if (i < size) {
+    const bool two = i + 1U < size;
+    const std::uint32_t group = (std::uint32_t {src[i]} << 16) | (two ? std::uint32_t {src[i + 1U]} << 8 : 0U);
+    *dst++ = kAlphabet[(group >> 18) & 0x3fU];
+    *dst++ = kAlphabet[(group >> 12) & 0x3fU];
+    *dst++ = two ? kAlphabet[(group >> 6) & 0x3fU] : '=';
+    *dst++ = '=';
+  }
+  return static_cast<std::size_t>(dst - out.data());
+}
+
+/// @brief Base64Encode() into a new String.
+inline String Base64Encode(Span<const Byte> in) {
+  String result(Base64EncodedSize(static_cast<std::size_t>(in.size())), '\0');
+  Base64Encode(in, Span<char>(&result[0], result.size()));
+  return result;
+}
+
+/**
+ * @brief Offset of the first @a delimiter in @a data, or npos.
+ *
+ * Backed by memchr(), which the C library already vectorizes for the CPU.
+ */
+inline std::size_t Find(Span<const Byte> data, Byte delimiter) noexcept {
+  if (data.size() == 0) {
+    return npos;
+  }
+  const void* hit = std::memchr(data.data(), static_cast<unsigned char>(delimiter), static_cast<std::size_t>(data.size()));
+  return hit == nullptr ? npos : static_cast<std::size_t>(static_cast<const Byte*>(hit) - data.data());
+}
+
+/// @brief Read a T stored in host byte order from the front of @a data.
+template <typename T, typename = internal::EnableIfInteger<T>>
+T Load(Span<const Byte> data) noexcept {
+  assert(static_cast<std::size_t>(data.size()) >= sizeof(T));
+  T value;
+  std::memcpy(&value, data.data(), sizeof(value));
+  return value;
+}
+
+/// @brief Read a little endian T from the front of @a data.
+template <typename T, typename = internal::EnableIfInteger<T>>
+T LoadLittle(Span<const Byte> data) noexcept {
+  T value = Load<T>(data);
+  return internal::kLittleEndian ? value : internal::ByteSwapValue(value);
+}
+
+/// @brief Read a big endian (network order) T from the front of @a data.
+template <typename T, typename = internal::EnableIfInteger<T>>
+T LoadBig(Span<const Byte> data) noexcept {
+  T value = Load<T>(data);
+  return internal::kLittleEndian ? internal::ByteSwapValue(value) : value;
+}
+
+/// @brief Write @a value in host byte order to the front of @a data.
+template <typename T, typename = internal::EnableIfInteger<T>>
+void Store(Span<Byte> data, T value) noexcept {
+  assert(static_cast<std::size_t>(data.size()) >= sizeof(T));
+  std::memcpy(data.data(), &value, sizeof(value));
+}
+
+/// @brief Write @a value little endian to the front of @a data.
+template <typename T, typename = internal::EnableIfInteger<T>>
+void StoreLittle(Span<Byte> data, T value) noexcept {
+  Store(data, internal::kLittleEndian ? value : internal::ByteSwapValue(value));
+}
+
+/// @brief Write @a value big endian (network order) to the front of @a data.
+template <typename T, typename = internal::EnableIfInteger<T>>
+void StoreBig(Span<Byte> data, T value) noexcept {
+  Store(data, internal::kLittleEndian ? internal::ByteSwapValue(value) : value);
+}
+
+}  // namespace bytes
+}  // namespace core
+}  // namespace ara
+
+#undef ARA_CORE_BYTES_X86
+#undef ARA_CORE_BYTES_ARM_CRC
+#undef ARA_CORE_BYTES_NEON
+
+#endif  // TUSIMPLEAP_ARA_CORE_BYTES_H_
@@ -0,0 +1,317 @@
+/// @file
+/// @brief Interface to ara::core coroutine support
+///
+/// Makes ara::core::Future awaitable and provides ara::core::Task, a
+/// coroutine type whose body runs and resumes on a chosen executor.
+///
+/// The header is only active when compiled as C++20 with coroutine support;
+/// in C++14 builds it is empty, so it can be included unconditionally.
+///
+/// @code
+/// ara::core::Task<std::size_t> Echo(ara::socket::tcp::Connection& conn) {
+///   auto header = co_await conn.Read(kHeaderSize);
+///   if (!header) {
+///     co_return ara::core::Result<std::size_t>::FromError(header.Error());
+///   }
+///   co_return co_await conn.Write(std::move(header).Value());
+/// }
+///
+/// auto done = Echo(conn).Start(pool);
+/// @endcode
+
+#ifndef TUSIMPLEAP_ARA_CORE_COROUTINE_H_
+#define TUSIMPLEAP_ARA_CORE_COROUTINE_H_
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define ARA_CORE_HAS_COROUTINE 1
+#endif
+#endif
+
+#ifdef ARA_CORE_HAS_COROUTINE
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#include "ara/core/error_code.h"
+#include "ara/core/executor.h"
+#include "ara/core/future.h"
+#include "ara/core/optional.h"
+#include "ara/core/promise.h"
+#include "ara/core/result.h"
+
+namespace ara {
+namespace core {
+namespace internal {
+
+/**
+ * @brief Type erased executor a suspended coroutine is resumed on.
+ *
+ * A default constructed Scheduler resumes inline, i.e. on the thread that
+ * completes the awaited operation.
+ */
+class Scheduler final {
+public:
+  Scheduler() noexcept = default;
+
+  template <typename Ex, typename = std::enable_if_t<!std::is_same<std::decay_t<Ex>, Scheduler>::value>>
+  explicit Scheduler(Ex& executor) noexcept :
+      executor_(&executor), post_([](void* ex, std::coroutine_handle<> handle) {
+        ExecutorTraits<Ex>::Execute(*static_cast<Ex*>(ex), [handle]() { handle.resume(); });
+      }) {}
+
+  void Resume(std::coroutine_handle<> handle) const {
+    if (post_ != nullptr) {
+      post_(executor_, handle);
+    } else {
+      handle.resume();
+    }
+  }
+
+private:
+  void* executor_ = nullptr;
+  void (*post_)(void*, std::coroutine_handle<>) = nullptr;
+};
+
+/**
+ * @brief Awaiter for Future, yields the Result of the Future.
+ *
+ * The continuation registered on the Future and await_suspend() race for
+ * handoff_; whoever comes second resumes the coroutine, so a Future that
+ * becomes ready concurrently never suspends the coroutine for nothing.
+ */
+template <typename T, typename E>
+class FutureAwaiter final {
+public:
+  FutureAwaiter(Future<T, E>&& future, Scheduler scheduler) noexcept :
+      future_(std::move(future)), scheduler_(scheduler) {}
+
+  FutureAwaiter(const FutureAwaiter&) = delete;
+  FutureAwaiter& operator=(const FutureAwaiter&) = delete;
+
+  bool await_ready() const { return !future_.valid() || future_.is_ready(); }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    next_ = future_.then([this](const Result<T, E>& result) {
+      result_.emplace(result);
+      if (handoff_.exchange(true, std::memory_order_acq_rel)) {
+        scheduler_.Resume(handle_);
+      }
+    });
+    return !handoff_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  Result<T, E> await_resume() {
+    if (result_.has_value()) {
+      return std::move(*result_);
+    }
+    return future_.GetResult();
+  }
+
+private:
+  Future<T, E> future_;
+  Future<void> next_;
+  Optional<Result<T, E>> result_;
+  Scheduler scheduler_;
+  std::coroutine_handle<> handle_;
+  std::atomic<bool> handoff_ {false};
+};
+
+template <typename T, typename E>
+class Task;
+
+template <typename T, typename E>
+class TaskPromiseBase {
+public:
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+
+  // The frame destroys itself, the result lives on in the Future.
+  std::suspend_never final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception() const noexcept { std::terminate(); }
+
+  template <typename U, typename G>
+  FutureAwaiter<U, G> await_transform(Future<U, G>&& future) const noexcept {
+    return FutureAwaiter<U, G>(std::move(future), scheduler_);
+  }
+
+  template <typename Awaitable>
+  Awaitable&& await_transform(Awaitable&& awaitable) const noexcept {
+    return std::forward<Awaitable>(awaitable);
+  }
+
+protected:
+  friend class Task<T, E>;
+
+  Promise<T, E> promise_;
+  Scheduler scheduler_;
+};
+
+template <typename T, typename E>
+class TaskPromise : public TaskPromiseBase<T, E> {
+public:
+  Task<T, E> get_return_object() noexcept;
+
+  void return_value(Result<T, E>&& result) { this->promise_.SetResult(std::move(result)); }
+
+  void return_value(const Result<T, E>& result) { this->promise_.SetResult(result); }
+};
+
+template <typename E>
+class TaskPromise<void, E> : public TaskPromiseBase<void, E> {
+public:
+  Task<void, E> get_return_object() noexcept;
+
+  void return_void() { this->promise_.set_value(); }
+};
+
+/**
+ * @brief Lazily started coroutine producing a Result<T, E>.
+ *
+ * Nothing runs until Start() is called. Every Future awaited inside the
+ * body resumes the body on the executor passed to Start(), so an I/O
+ * thread completing a Future only posts the resumption.
+ *
+ * Use ara::core::Task, this class only exists to keep the promise types
+ * internal.
+ */
+template <typename T, typename E>
+class Task final {
+public:
+  using promise_type = TaskPromise<T, E>;
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  ~Task() { Reset(); }
+
+  /**
+   * @brief Run the body on @a executor.
+   *
+   * @param executor an executor supported by ExecutorTraits, it has to
+   * outlive the coroutine
+   * @returns a Future for the result of the coroutine
+   */
+  template <typename Ex>
+  Future<T, E> Start(Ex& executor) && {
+    handle_.promise().scheduler_ = Scheduler(executor);
+    return std::move(*this).Start();
+  }
+
+  /**
+   * @brief Run the body on the calling thread.
+   *
+   * Awaited Futures resume the body on whichever thread completes them.
+   *
+   * @returns a Future for the result of the coroutine
+   */
+  Future<T, E> Start() && {
+    auto handle = std::exchange(handle_, nullptr);
+    auto future = handle.promise().promise_.get_future();
+    handle.promise().scheduler_.Resume(handle);
+    return future;
+  }
+
+private:
+  friend class TaskPromise<T, E>;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+  void Reset() noexcept {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename T, typename E>
+Task<T, E> TaskPromise<T, E>::get_return_object() noexcept {
+  return Task<T, E>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+template <typename E>
+Task<void, E> TaskPromise<void, E>::get_return_object() noexcept {
+  return Task<void, E>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+/**
+ * @brief Awaitable that continues the awaiting coroutine on an executor.
+ */
+template <typename Ex>
+class ResumeOnAwaiter final {
+public:
+  explicit ResumeOnAwaiter(Ex& executor) noexcept : executor_(executor) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    ExecutorTraits<Ex>::Execute(executor_, [handle]() { handle.resume(); });
+  }
+
+  void await_resume() const noexcept {}
+
+private:
+  Ex& executor_;
+};
+
+}  // namespace internal
+
+/**
+ * @brief Coroutine type returning Result<T, E> through a Future.
+ *
+ * @code
+ * ara::core::Task<int> Twice(ara::core::Future<int> f) {
+ *   auto r = co_await std::move(f);
+ *   co_return r ? ara::core::Result<int>(*r * 2) : r;
+ * }
+ * @endcode
+ */
+template <typename T, typename E = ErrorCode>
+using Task = internal::Task<T, E>;
+
+/**
+ * @brief Await a Future in any coroutine.
+ *
+ * The coroutine resumes on the thread that fulfils the Promise; await
+ * fut.via(executor) to resume elsewhere.
+ *
+ * @returns an awaitable yielding the Result of @a future
+ */
+template <typename T, typename E>
+internal::FutureAwaiter<T, E> operator co_await(Future<T, E>&& future) noexcept {
+  return internal::FutureAwaiter<T, E>(std::move(future), internal::Scheduler());
+}
+
+/**
+ * @brief Continue the awaiting coroutine on @a executor.
+ *
+ * @param executor an executor supported by ExecutorTraits
+ */
+template <typename Ex>
+internal::ResumeOnAwaiter<Ex> ResumeOn(Ex& executor) noexcept {
+  return internal::ResumeOnAwaiter<Ex>(executor);
+}
+
+}  // namespace core
+}  // namespace ara
+
+#endif  // ARA_CORE_HAS_COROUTINE
+
+#endif  // TUSIMPLEAP_ARA_CORE_COROUTINE_H_
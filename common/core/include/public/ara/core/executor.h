@@ -0,0 +1,108 @@
+/// @file
+/// @brief Interface to ara::core::ExecutorTraits
+///
+/// ExecutorTraits is the glue between ara::core::Future continuations and
+/// the task queues used across the platform. Future::via() and the
+/// executor-aware Future::then() post their work through it, so the thread
+/// that fulfils a Promise only has to hand the result over.
+
+#ifndef TUSIMPLEAP_ARA_CORE_EXECUTOR_H_
+#define TUSIMPLEAP_ARA_CORE_EXECUTOR_H_
+
+#include <type_traits>
+#include <utility>
+
+namespace ara {
+namespace core {
+namespace internal {
+
+template <typename...>
+using void_t = void;
+
+template <typename Ex, typename Task, typename = void>
+struct HasAddExecute : std::false_type {};
+
+template <typename Ex, typename Task>
+struct HasAddExecute<Ex, Task, void_t<decltype(std::declval<Ex&>().AddExecute(std::declval<Task>()))>>
+    : std::true_type {};
+
+template <typename Ex, typename Task, typename = void>
+struct HasEnqueue : std::false_type {};
+
+template <typename Ex, typename Task>
+struct HasEnqueue<Ex, Task, void_t<decltype(std::declval<Ex&>().enqueue(std::declval<Task>()))>>
+    : std::true_type {};
+
+template <typename Ex, typename Task, typename = void>
+struct HasExecute : std::false_type {};
+
+template <typename Ex, typename Task>
+struct HasExecute<Ex, Task, void_t<decltype(std::declval<Ex&>().execute(std::declval<Task>()))>>
+    : std::true_type {};
+
+template <typename Ex, typename Task, typename = void>
+struct HasPost : std::false_type {};
+
+template <typename Ex, typename Task>
+struct HasPost<Ex, Task, void_t<decltype(std::declval<Ex&>().post(std::declval<Task>()))>> : std::true_type {};
+
+// Tag dispatch in order of preference, the first matching member wins.
+template <std::size_t I>
+struct ExecutePriority : ExecutePriority<I - 1> {};
+
+template <>
+struct ExecutePriority<0> {};
+
+// utility::Executor
+template <typename Ex, typename Task>
+auto ExecuteImpl(Ex& executor, Task&& task, ExecutePriority<3>)
+    -> std::enable_if_t<HasAddExecute<Ex, Task>::value> {
+  executor.AddExecute(std::forward<Task>(task));
+}
+
+// ara::threadpool::ThreadPool, the returned std::future is dropped on purpose
+template <typename Ex, typename Task>
+auto ExecuteImpl(Ex& executor, Task&& task, ExecutePriority<2>) -> std::enable_if_t<HasEnqueue<Ex, Task>::value> {
+  static_cast<void>(executor.enqueue(std::forward<Task>(task)));
+}
+
+// asio executors and strands following the standard executor model
+template <typename Ex, typename Task>
+auto ExecuteImpl(Ex& executor, Task&& task, ExecutePriority<1>) -> std::enable_if_t<HasExecute<Ex, Task>::value> {
+  executor.execute(std::forward<Task>(task));
+}
+
+// legacy asio io_context::strand
+template <typename Ex, typename Task>
+auto ExecuteImpl(Ex& executor, Task&& task, ExecutePriority<0>) -> std::enable_if_t<HasPost<Ex, Task>::value> {
+  executor.post(std::forward<Task>(task));
+}
+
+}  // namespace internal
+
+/**
+ * @brief Adapts an executor type to the interface used by Future::via().
+ *
+ * The primary template recognizes, in this order, a member
+ * AddExecute(task) (utility::Executor), enqueue(task)
+ * (ara::threadpool::ThreadPool), execute(task) (asio executors and strands)
+ * and post(task) (asio io_context::strand). Other executor types may
+ * specialize this template.
+ *
+ * Tasks handed to Execute() are copyable nullary callables, so they fit
+ * into std::function based queues.
+ *
+ * @tparam Ex the executor type
+ */
+template <typename Ex>
+struct ExecutorTraits {
+  template <typename Task>
+  static void Execute(Ex& executor, Task&& task) {
+    internal::ExecuteImpl(executor, std::forward<Task>(task), internal::ExecutePriority<3> {});
+  }
+};
+
+}  // namespace core
+}  // namespace ara
+
+#endif  // TUSIMPLEAP_ARA_CORE_EXECUTOR_H_
@@ -0,0 +1,463 @@
+/**
+ * @file
+ * @brief Interface to class ara::core::FlatMap
+ *
+ * ara::core::FlatMap is an associative container with the interface of
+ * ara::core::Map that keeps its elements sorted in one contiguous vector.
+ * Lookups are a binary search over adjacent memory instead of a pointer
+ * chase through tree nodes, and iteration is a linear scan. Inserting or
+ * erasing in the middle moves the elements behind it, so FlatMap suits
+ * tables that are built once (or in bulk) and read often, e.g.
+ * configuration and routing tables.
+ */
+
+#ifndef TUSIMPLEAP_ARA_CORE_FLAT_MAP_H_
+#define TUSIMPLEAP_ARA_CORE_FLAT_MAP_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "ara/core/internal/flat_tree.h"
+#include "ara/core/vector.h"
+
+namespace ara {
+namespace core {
+
+/**
+ * @brief Sorted vector of unique key-value pairs with the interface of Map
+ *
+ * Differences to Map:
+ * - value_type is std::pair<Key, T>, the key must not be modified through
+ *   an iterator
+ * - insert and erase invalidate iterators and references like Vector does
+ * - with a transparent Compare, the default, all lookups accept any type
+ *   comparable to Key, e.g. a StringView for a String key
+ *
+ * Bulk construction and range insert sort the input once instead of
+ * inserting element by element. Of equivalent keys the first one is kept,
+ * as with Map::insert.
+ *
+ * @tparam Key  the type of keys
+ * @tparam T  the type of mapped values
+ * @tparam Compare  the ordering of the keys
+ * @tparam Container  the underlying sequence container
+ */
+template <typename Key,
+          typename T,
+          typename Compare = TransparentLess,
+          typename Container = Vector<std::pair<Key, T>>>
+class FlatMap final {
+  template <typename K>
+  using EnableIfTransparent = std::enable_if_t<internal::IsTransparent<Compare>::value, K>;
+
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using key_compare = Compare;
+  using container_type = Container;
+  using size_type = typename Container::size_type;
+  using difference_type = typename Container::difference_type;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename Container::iterator;
+  using const_iterator = typename Container::const_iterator;
+  using reverse_iterator = typename Container::reverse_iterator;
+  using const_reverse_iterator = typename Container::const_reverse_iterator;
+
+  class value_compare {
+  public:
+    bool operator()(const value_type& a, const value_type& b) const { return comp(a.first, b.first); }
+
+  protected:
+    friend class FlatMap;
+    explicit value_compare(Compare c) : comp(std::move(c)) {}
+    Compare comp;
+  };
+
+  FlatMap() = default;
+
+  explicit FlatMap(const Compare& comp) : comp_(comp) {}
+
+  template <typename InputIt>
+  FlatMap(InputIt first, InputIt last, const Compare& comp = Compare()) : comp_(comp), data_(first, last) {
+    Normalize();
+  }
+
+  FlatMap(std::initializer_list<value_type> init, const Compare& comp = Compare()) :
+      FlatMap(init.begin(), init.end(), comp) {}
+
+  /**
+   * @brief Take over the elements of @a cont and sort them.
+   */
+  explicit FlatMap(Container cont, const Compare& comp = Compare()) : comp_(comp), data_(std::move(cont)) {
+    Normalize();
+  }
+
+  /**
+   * @brief Take over @a cont, which must already be sorted and unique.
+   */
+  FlatMap(SortedUniqueT, Container cont, const Compare& comp = Compare()) : comp_(comp), data_(std::move(cont)) {}
+
+  FlatMap(SortedUniqueT, std::initializer_list<value_type> init, const Compare& comp = Compare()) :
+      comp_(comp), data_(init) {}
+
+  FlatMap(const FlatMap&) = default;
+  FlatMap(FlatMap&&) = default;
+  FlatMap& operator=(const FlatMap&) = default;
+  FlatMap& operator=(FlatMap&&) = default;
+  ~FlatMap() = default;
+
+  FlatMap& operator=(std::initializer_list<value_type> init) {
+    data_.assign(init.begin(), init.end());
+    Normalize();
+    return *this;
+  }
+
+  // iterators
+
+  iterator begin() noexcept { return data_.begin(); }
+  const_iterator begin() const noexcept { return data_.begin(); }
+  const_iterator cbegin() const noexcept { return data_.cbegin(); }
+  iterator end() noexcept { return data_.end(); }
+  const_iterator end() const noexcept { return data_.end(); }
+  const_iterator cend() const noexcept { return data_.cend(); }
+  reverse_iterator rbegin() noexcept { return data_.rbegin(); }
+  const_reverse_iterator rbegin() const noexcept { return data_.rbegin(); }
+  const_reverse_iterator crbegin() const noexcept { return data_.crbegin(); }
+  reverse_iterator rend() noexcept { return data_.rend(); }
+  const_reverse_iterator rend() const noexcept { return data_.rend(); }
+  const_reverse_iterator crend() const noexcept { return data_.crend(); }
+
+  // capacity
+
+  bool empty() const noexcept { return data_.empty(); }
+  size_type size() const noexcept { return data_.size(); }
+  size_type max_size() const noexcept { return data_.max_size(); }
+  size_type capacity() const noexcept { return data_.capacity(); }
+  void reserve(size_type n) { data_.reserve(n); }
+  void shrink_to_fit() { data_.shrink_to_fit(); }
+
+  // element access
+
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  T& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+  T& at(const Key& key) { return AtImpl(*this, key); }
+  const T& at(const Key& key) const { return AtImpl(*this, key); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  T& at(const K& key) {
+    return AtImpl(*this, key);
+  }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  const T& at(const K& key) const {
+    return AtImpl(*this, key);
+  }
+
+  // modifiers
+
+  std::pair<iterator, bool> insert(const value_type& value) { return try_emplace(value.first, value.second); }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+
+  iterator insert(const_iterator, const value_type& value) { return insert(value).first; }
+
+  iterator insert(const_iterator, value_type&& value) { return insert(std::move(value)).first; }
+
+  /**
+   * @brief Insert a range with one sort and one merge.
+   */
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    const auto size = data_.size();
+    data_.insert(data_.end(), first, last);
+    internal::MergeUnique(data_, data_.begin() + static_cast<difference_type>(size), value_comp());
+  }
+
+  /**
+   * @brief Insert a sorted range without duplicates with one merge.
+   */
+  template <typename InputIt>
+  void insert(SortedUniqueT, InputIt first, InputIt last) {
+    const auto size = data_.size();
+    data_.insert(data_.end(), first, last);
+    const auto middle = data_.begin() + static_cast<difference_type>(size);
+    std::inplace_merge(data_.begin(), middle, data_.end(), value_comp());
+    data_.erase(std::unique(data_.begin(),
+                            data_.end(),
+                            [this](const value_type& a, const value_type& b) { return !comp_(a.first, b.first); }),
+                data_.end());
+  }
+
+  void insert(std::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return TryEmplaceImpl(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return TryEmplaceImpl(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  iterator erase(iterator pos) { return data_.erase(pos); }
+  iterator erase(const_iterator pos) { return data_.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) { return data_.erase(first, last); }
+
+  size_type erase(const Key& key) { return EraseImpl(key); }
+
+  template <typename K,
+            typename = EnableIfTransparent<K>,
+            typename = std::enable_if_t<!std::is_convertible<K, const_iterator>::value>>
+  size_type erase(const K& key) {
+    return EraseImpl(key);
+  }
+
+  void swap(FlatMap& other) noexcept {
+    using std::swap;
+    swap(comp_, other.comp_);
+    data_.swap(other.data_);
+  }
+
+  void clear() noexcept { data_.clear(); }
+
+  /**
+   * @brief Move the underlying container out, leaving the map empty.
+   */
+  Container extract() && {
+    Container c = std::move(data_);
+    data_.clear();
+    return c;
+  }
+
+  /**
+   * @brief Replace the elements by @a cont, which must be sorted and unique.
+   */
+  void replace(Container&& cont) { data_ = std::move(cont); }
+
+  // lookup
+
+  size_type count(const Key& key) const { return find(key) != end() ? 1U : 0U; }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  size_type count(const K& key) const {
+    return find(key) != end() ? 1U : 0U;
+  }
+
+  iterator find(const Key& key) { return FindImpl(*this, key); }
+  const_iterator find(const Key& key) const { return FindImpl(*this, key); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  iterator find(const K& key) {
+    return FindImpl(*this, key);
+  }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  const_iterator find(const K& key) const {
+    return FindImpl(*this, key);
+  }
+
+  bool contains(const Key& key) const { return find(key) != end(); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  bool contains(const K& key) const {
+    return find(key) != end();
+  }
+
+  iterator lower_bound(const Key& key) { return LowerBound(*this, key); }
+  const_iterator lower_bound(const Key& key) const { return LowerBound(*this, key); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  iterator lower_bound(const K& key) {
+    return LowerBound(*this, key);
+  }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  const_iterator lower_bound(const K& key) const {
+    return LowerBound(*this, key);
+  }
+
+  iterator upper_bound(const Key& key) { return UpperBound(*this, key); }
+  const_iterator upper_bound(const Key& key) const { return UpperBound(*this, key); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  iterator upper_bound(const K& key) {
+    return UpperBound(*this, key);
+  }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  const_iterator upper_bound(const K& key) const {
+    return UpperBound(*this, key);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) { return EqualRange(*this, key); }
+  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return EqualRange(*this, key); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return EqualRange(*this, key);
+  }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return EqualRange(*this, key);
+  }
+
+  // observers
+
+  key_compare key_comp() const { return comp_; }
+  value_compare value_comp() const { return value_compare(comp_); }
+
+  /**
+   * @brief The sorted elements as one contiguous sequence.
+   */
+  const Container& container() const noexcept { return data_; }
+
+private:
+  void Normalize() { data_.erase(internal::SortUnique(data_.begin(), data_.end(), value_comp()), data_.end()); }
+
+  // Self is FlatMap or const FlatMap, so one body serves both overloads.
+  template <typename Self, typename K>
+  static auto LowerBound(Self& self, const K& key) -> decltype(self.data_.begin()) {
+    return std::lower_bound(self.data_.begin(), self.data_.end(), key, [&self](const value_type& v, const K& k) {
+      return self.comp_(v.first, k);
+    });
+  }
+
+  template <typename Self, typename K>
+  static auto UpperBound(Self& self, const K& key) -> decltype(self.data_.begin()) {
+    return std::upper_bound(self.data_.begin(), self.data_.end(), key, [&self](const K& k, const value_type& v) {
+      return self.comp_(k, v.first);
+    });
+  }
+
+  template <typename Self, typename K>
+  static auto FindImpl(Self& self, const K& key) -> decltype(self.data_.begin()) {
+    auto it = LowerBound(self, key);
+    if (it != self.data_.end() && !self.comp_(key, it->first)) {
+      return it;
+    }
+    return self.data_.end();
+  }
+
+  template <typename Self, typename K>
+  static auto EqualRange(Self& self, const K& key)
+      -> std::pair<decltype(self.data_.begin()), decltype(self.data_.begin())> {
+    auto it = FindImpl(self, key);
+    return {it, it == self.data_.end() ? it : std::next(it)};
+  }
+
+  template <typename Self, typename K>
+  static auto AtImpl(Self& self, const K& key) -> decltype((self.data_.begin()->second)) {
+    auto it = FindImpl(self, key);
+    if (it == self.data_.end()) {
+      throw std::out_of_range("ara::core::FlatMap::at");
+    }
+    return it->second;
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplaceImpl(K&& key, Args&&... args) {
+    auto it = LowerBound(*this, key);
+    if (it != data_.end() && !comp_(key, it->first)) {
+      return {it, false};
+    }
+    it = data_.emplace(it,
+                       std::piecewise_construct,
+                       std::forward_as_tuple(std::forward<K>(key)),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+    return {it, true};
+  }
+
+  template <typename K>
+  size_type EraseImpl(const K& key) {
+    auto it = FindImpl(*this, key);
+    if (it == data_.end()) {
+      return 0U;
+    }
+    data_.erase(it);
+    return 1U;
+  }
+
+  Compare comp_;
+  Container data_;
+};
+
+template <typename Key, typename T, typename Compare, typename Container>
+bool operator==(const FlatMap<Key, T, Compare, Container>& lhs, const FlatMap<Key, T, Compare, Container>& rhs) {
+  return lhs.container() == rhs.container();
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+bool operator!=(const FlatMap<Key, T, Compare, Container>& lhs, const FlatMap<Key, T, Compare, Container>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+bool operator<(const FlatMap<Key, T, Compare, Container>& lhs, const FlatMap<Key, T, Compare, Container>& rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+bool operator>(const FlatMap<Key, T, Compare, Container>& lhs, const FlatMap<Key, T, Compare, Container>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+bool operator<=(const FlatMap<Key, T, Compare, Container>& lhs, const FlatMap<Key, T, Compare, Container>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+bool operator>=(const FlatMap<Key, T, Compare, Container>& lhs, const FlatMap<Key, T, Compare, Container>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+void swap(FlatMap<Key, T, Compare, Container>& lhs, FlatMap<Key, T, Compare, Container>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace core
+}  // namespace ara
+
+#endif  // TUSIMPLEAP_ARA_CORE_FLAT_MAP_H_
@@ -0,0 +1,310 @@
+/**
+ * @file
+ * @brief Interface to class ara::core::FlatSet
+ *
+ * ara::core::FlatSet is the set counterpart of ara::core::FlatMap: unique
+ * keys kept sorted in one contiguous vector.
+ */
+
+#ifndef TUSIMPLEAP_ARA_CORE_FLAT_SET_H_
+#define TUSIMPLEAP_ARA_CORE_FLAT_SET_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "ara/core/internal/flat_tree.h"
+#include "ara/core/vector.h"
+
+namespace ara {
+namespace core {
+
+/**
+ * @brief Sorted vector of unique keys with the interface of std::set
+ *
+ * Iterators are constant. Insert and erase invalidate iterators like Vector
+ * does. With a transparent Compare, the default, all lookups accept any
+ * type comparable to Key.
+ *
+ * @tparam Key  the type of keys
+ * @tparam Compare  the ordering of the keys
+ * @tparam Container  the underlying sequence container
+ */
+template <typename Key, typename Compare = TransparentLess, typename Container = Vector<Key>>
+class FlatSet final {
+  template <typename K>
+  using EnableIfTransparent = std::enable_if_t<internal::IsTransparent<Compare>::value, K>;
+
+public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using container_type = Container;
+  using size_type = typename Container::size_type;
+  using difference_type = typename Container::difference_type;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename Container::const_iterator;
+  using const_iterator = typename Container::const_iterator;
+  using reverse_iterator = typename Container::const_reverse_iterator;
+  using const_reverse_iterator = typename Container::const_reverse_iterator;
+
+  FlatSet() = default;
+
+  explicit FlatSet(const Compare& comp) : comp_(comp) {}
+
+  template <typename InputIt>
+  FlatSet(InputIt first, InputIt last, const Compare& comp = Compare()) : comp_(comp), data_(first, last) {
+    Normalize();
+  }
+
+  FlatSet(std::initializer_list<value_type> init, const Compare& comp = Compare()) :
+      FlatSet(init.begin(), init.end(), comp) {}
+
+  /**
+   * @brief Take over the elements of @a cont and sort them.
+   */
+  explicit FlatSet(Container cont, const Compare& comp = Compare()) : comp_(comp), data_(std::move(cont)) {
+    Normalize();
+  }
+
+  /**
+   * @brief Take over @a cont, which must already be sorted and unique.
+   */
+  FlatSet(SortedUniqueT, Container cont, const Compare& comp = Compare()) : comp_(comp), data_(std::move(cont)) {}
+
+  FlatSet(const FlatSet&) = default;
+  FlatSet(FlatSet&&) = default;
+  FlatSet& operator=(const FlatSet&) = default;
+  FlatSet& operator=(FlatSet&&) = default;
+  ~FlatSet() = default;
+
+  FlatSet& operator=(std::initializer_list<value_type> init) {
+    data_.assign(init.begin(), init.end());
+    Normalize();
+    return *this;
+  }
+
+  // iterators
+
+  const_iterator begin() const noexcept { return data_.begin(); }
+  const_iterator cbegin() const noexcept { return data_.cbegin(); }
+  const_iterator end() const noexcept { return data_.end(); }
+  const_iterator cend() const noexcept { return data_.cend(); }
+  const_reverse_iterator rbegin() const noexcept { return data_.rbegin(); }
+  const_reverse_iterator crbegin() const noexcept { return data_.crbegin(); }
+  const_reverse_iterator rend() const noexcept { return data_.rend(); }
+  const_reverse_iterator crend() const noexcept { return data_.crend(); }
+
+  // capacity
+
+  bool empty() const noexcept { return data_.empty(); }
+  size_type size() const noexcept { return data_.size(); }
+  size_type max_size() const noexcept { return data_.max_size(); }
+  size_type capacity() const noexcept { return data_.capacity(); }
+  void reserve(size_type n) { data_.reserve(n); }
+  void shrink_to_fit() { data_.shrink_to_fit(); }
+
+  // modifiers
+
+  std::pair<iterator, bool> insert(const value_type& value) { return InsertImpl(value); }
+
+  std::pair<iterator, bool> insert(value_type&& value) { return InsertImpl(std::move(value)); }
+
+  iterator insert(const_iterator, const value_type& value) { return insert(value).first; }
+
+  iterator insert(const_iterator, value_type&& value) { return insert(std::move(value)).first; }
+
+  /**
+   * @brief Insert a range with one sort and one merge.
+   */
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    const auto size = data_.size();
+    data_.insert(data_.end(), first, last);
+    internal::MergeUnique(data_, data_.begin() + static_cast<difference_type>(size), comp_);
+  }
+
+  void insert(std::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  iterator erase(const_iterator pos) { return data_.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) { return data_.erase(first, last); }
+
+  size_type erase(const Key& key) { return EraseImpl(key); }
+
+  template <typename K,
+            typename = EnableIfTransparent<K>,
+            typename = std::enable_if_t<!std::is_convertible<K, const_iterator>::value>>
+  size_type erase(const K& key) {
+    return EraseImpl(key);
+  }
+
+  void swap(FlatSet& other) noexcept {
+    using std::swap;
+    swap(comp_, other.comp_);
+    data_.swap(other.data_);
+  }
+
+  void clear() noexcept { data_.clear(); }
+
+  /**
+   * @brief Move the underlying container out, leaving the set empty.
+   */
+  Container extract() && {
+    Container c = std::move(data_);
+    data_.clear();
+    return c;
+  }
+
+  /**
+   * @brief Replace the elements by @a cont, which must be sorted and unique.
+   */
+  void replace(Container&& cont) { data_ = std::move(cont); }
+
+  // lookup
+
+  size_type count(const Key& key) const { return contains(key) ? 1U : 0U; }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  size_type count(const K& key) const {
+    return contains(key) ? 1U : 0U;
+  }
+
+  const_iterator find(const Key& key) const { return FindImpl(key); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  const_iterator find(const K& key) const {
+    return FindImpl(key);
+  }
+
+  bool contains(const Key& key) const { return find(key) != end(); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  bool contains(const K& key) const {
+    return find(key) != end();
+  }
+
+  const_iterator lower_bound(const Key& key) const { return std::lower_bound(begin(), end(), key, comp_); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  const_iterator lower_bound(const K& key) const {
+    return std::lower_bound(begin(), end(), key, comp_);
+  }
+
+  const_iterator upper_bound(const Key& key) const { return std::upper_bound(begin(), end(), key, comp_); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  const_iterator upper_bound(const K& key) const {
+    return std::upper_bound(begin(), end(), key, comp_);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return EqualRange(key); }
+
+  template <typename K, typename = EnableIfTransparent<K>>
+  std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return EqualRange(key);
+  }
+
+  // observers
+
+  key_compare key_comp() const { return comp_; }
+  value_compare value_comp() const { return comp_; }
+
+  /**
+   * @brief The sorted elements as one contiguous sequence.
+   */
+  const Container& container() const noexcept { return data_; }
+
+private:
+  void Normalize() { data_.erase(internal::SortUnique(data_.begin(), data_.end(), comp_), data_.end()); }
+
+  template <typename K>
+  const_iterator FindImpl(const K& key) const {
+    auto it = std::lower_bound(begin(), end(), key, comp_);
+    if (it != end() && !comp_(key, *it)) {
+      return it;
+    }
+    return end();
+  }
+
+  template <typename K>
+  std::pair<const_iterator, const_iterator> EqualRange(const K& key) const {
+    auto it = FindImpl(key);
+    return {it, it == end() ? it : std::next(it)};
+  }
+
+  template <typename V>
+  std::pair<iterator, bool> InsertImpl(V&& value) {
+    auto it = std::lower_bound(data_.begin(), data_.end(), value, comp_);
+    if (it != data_.end() && !comp_(value, *it)) {
+      return {it, false};
+    }
+    return {data_.insert(it, std::forward<V>(value)), true};
+  }
+
+  template <typename K>
+  size_type EraseImpl(const K& key) {
+    auto it = FindImpl(key);
+    if (it == end()) {
+      return 0U;
+    }
+    data_.erase(it);
+    return 1U;
+  }
+
+  Compare comp_;
+  Container data_;
+};
+
+template <typename Key, typename Compare, typename Container>
+bool operator==(const FlatSet<Key, Compare, Container>& lhs, const FlatSet<Key, Compare, Container>& rhs) {
+  return lhs.container() == rhs.container();
+}
+
+template <typename Key, typename Compare, typename Container>
+bool operator!=(const FlatSet<Key, Compare, Container>& lhs, const FlatSet<Key, Compare, Container>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, typename Container>
+bool operator<(const FlatSet<Key, Compare, Container>& lhs, const FlatSet<Key, Compare, Container>& rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Key, typename Compare, typename Container>
+bool operator>(const FlatSet<Key, Compare, Container>& lhs, const FlatSet<Key, Compare, Container>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename Key, typename Compare, typename Container>
+bool operator<=(const FlatSet<Key, Compare, Container>& lhs, const FlatSet<Key, Compare, Container>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Key, typename Compare, typename Container>
+bool operator>=(const FlatSet<Key, Compare, Container>& lhs, const FlatSet<Key, Compare, Container>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename Key, typename Compare, typename Container>
+void swap(FlatSet<Key, Compare, Container>& lhs, FlatSet<Key, Compare, Container>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace core
+}  // namespace ara
+
+#endif  // TUSIMPLEAP_ARA_CORE_FLAT_SET_H_
@@ -167,7 +167,7 @@ private:
 
   template <typename Func>
   static ReturnType InvokeHelper(Function* self, param_t<ArgTypes>... args) noexcept {
-    return static_cast<ReturnType>(invoke(*static_cast<Func*>(access<Func>(self)), static_cast<ArgTypes&&>(args)...));
+    return static_cast<ReturnType>(ara::core::invoke(*static_cast<Func*>(access<Func>(self)), static_cast<ArgTypes&&>(args)...));
   }
 
   mutable FunctionStorage _storage;
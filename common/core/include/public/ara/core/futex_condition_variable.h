@@ -0,0 +1,206 @@
+/**
+ * @file
+ * @brief Interface to class ara::core::FutexConditionVariable
+ *
+ * A condition variable for std::unique_lock<std::mutex> built directly on
+ * the Linux futex. Timed waits are absolute CLOCK_MONOTONIC deadlines, so
+ * wall clock adjustments never stretch or shorten a timeout, and notify
+ * only enters the kernel if a thread is actually waiting.
+ *
+ * On other platforms FutexConditionVariable is std::condition_variable.
+ */
+
+#ifndef TUSIMPLEAP_ARA_CORE_FUTEX_CONDITION_VARIABLE_H_
+#define TUSIMPLEAP_ARA_CORE_FUTEX_CONDITION_VARIABLE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#if defined(__linux__)
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+
+#include "ara/core/condition_variable.h"
+
+namespace ara {
+namespace core {
+namespace internal {
+
+/**
+ * @brief Block while @a word equals @a expected.
+ *
+ * @param abstime absolute CLOCK_MONOTONIC deadline, nullptr waits forever
+ */
+inline void FutexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected, const timespec* abstime) noexcept {
+  static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex word must be 32 bit");
+  // FUTEX_WAIT_BITSET takes an absolute timeout, FUTEX_WAIT a relative one.
+  static_cast<void>(::syscall(SYS_futex,
+                              reinterpret_cast<std::uint32_t*>(&word),
+                              FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+                              expected,
+                              abstime,
+                              nullptr,
+                              FUTEX_BITSET_MATCH_ANY));
+}
+
+/**
+ * @brief Wake up to @a count threads blocked on @a word.
+ */
+inline void FutexWake(std::atomic<std::uint32_t>& word, int count) noexcept {
+  static_cast<void>(
+      ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0));
+}
+
+}  // namespace internal
+
+/**
+ * @brief Condition variable on a futex with a waiter count.
+ *
+ * Drop-in replacement for std::condition_variable; like it, the timed waits
+ * return std::cv_status.
+ * Every notify bumps a sequence number which is also the futex word, so a
+ * notify racing with a thread that is about to block is never lost. The
+ * predicate overloads follow the std::condition_variable semantics, i.e.
+ * the predicate is checked before the first wait.
+ *
+ * Deadlines of clocks other than SteadyClock are converted to SteadyClock
+ * once, like std::condition_variable does.
+ */
+class FutexConditionVariable final {
+public:
+  using clock = SteadyClock;
+
+  FutexConditionVariable() noexcept = default;
+
+  FutexConditionVariable(const FutexConditionVariable&) = delete;
+  FutexConditionVariable& operator=(const FutexConditionVariable&) = delete;
+
+  void wait(std::unique_lock<std::mutex>& lock) noexcept { WaitImpl(lock, nullptr); }
+
+  template <typename Predicate>
+  void wait(std::unique_lock<std::mutex>& lock, Predicate p) {
+    while (!p()) {
+      wait(lock);
+    }
+  }
+
+  template <typename Duration>
+  std::cv_status wait_until(std::unique_lock<std::mutex>& lock, const std::chrono::time_point<clock, Duration>& time) {
+    const auto now = clock::now();
+    if (time <= now) {
+      return std::cv_status::timeout;
+    }
+    if (time == std::chrono::time_point<clock, Duration>::max()) {
+      wait(lock);
+      return std::cv_status::no_timeout;
+    }
+    const auto sec = std::chrono::time_point_cast<std::chrono::seconds>(time);
+    const auto nano_sec = std::chrono::duration_cast<std::chrono::nanoseconds>(time - sec);
+    const timespec ts {static_cast<std::time_t>(sec.time_since_epoch().count()), static_cast<long>(nano_sec.count())};
+    WaitImpl(lock, &ts);
+    return clock::now() < time ? std::cv_status::no_timeout : std::cv_status::timeout;
+  }
+
+  template <typename Clock, typename Duration>
+  std::cv_status wait_until(std::unique_lock<std::mutex>& lock, const std::chrono::time_point<Clock, Duration>& time) {
+    const auto rel_time = time - Clock::now();
+    if (wait_for(lock, rel_time) == std::cv_status::no_timeout) {
+      return std::cv_status::no_timeout;
+    }
+    return Clock::now() < time ? std::cv_status::no_timeout : std::cv_status::timeout;
+  }
+
+  template <typename Clock, typename Duration, typename Predicate>
+  bool wait_until(std::unique_lock<std::mutex>& lock,
+                  const std::chrono::time_point<Clock, Duration>& time,
+                  Predicate p) {
+    while (!p()) {
+      if (wait_until(lock, time) == std::cv_status::timeout) {
+        return static_cast<bool>(p());
+      }
+    }
+    return true;
+  }
+
+  template <typename Rep, typename Period>
+  std::cv_status wait_for(std::unique_lock<std::mutex>& lock, const std::chrono::duration<Rep, Period>& dur) {
+    return wait_until(lock, convert_to_timepoint(dur));
+  }
+
+  template <typename Rep, typename Period, typename Predicate>
+  bool wait_for(std::unique_lock<std::mutex>& lock, const std::chrono::duration<Rep, Period>& dur, Predicate p) {
+    return wait_until(lock, convert_to_timepoint(dur), std::move(p));
+  }
+
+  void notify_one() noexcept {
+    seq_.fetch_add(1, std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) != 0) {
+      internal::FutexWake(seq_, 1);
+    }
+  }
+
+  void notify_all() noexcept {
+    seq_.fetch_add(1, std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) != 0) {
+      internal::FutexWake(seq_, INT_MAX);
+    }
+  }
+
+private:
+  template <typename Rep, typename Period>
+  static std::chrono::time_point<clock, clock::duration> convert_to_timepoint(
+      const std::chrono::duration<Rep, Period>& dur) {
+    const auto now = clock::now();
+    if (dur <= std::chrono::duration<Rep, Period>::zero()) {
+      return now;
+    }
+    // Saturate instead of overflowing for durations like hours::max().
+    if (std::chrono::duration<double>(dur) >= std::chrono::duration<double>(clock::time_point::max() - now)) {
+      return clock::time_point::max();
+    }
+    auto rel_time = std::chrono::duration_cast<clock::duration>(dur);
+    if (rel_time < dur) {
+      ++rel_time;
+    }
+    return now + rel_time;
+  }
+
+  void WaitImpl(std::unique_lock<std::mutex>& lock, const timespec* abstime) noexcept {
+    // Both are read and written seq_cst, see notify_one(): either the
+    // notifier sees the waiter or the waiter sees the new sequence number.
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    const auto seq = seq_.load(std::memory_order_seq_cst);
+    lock.unlock();
+    internal::FutexWait(seq_, seq, abstime);
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+
+  std::atomic<std::uint32_t> seq_ {0};
+  std::atomic<std::uint32_t> waiters_ {0};
+};
+
+}  // namespace core
+}  // namespace ara
+
+#else  // !__linux__
+
+namespace ara {
+namespace core {
+
+using FutexConditionVariable = std::condition_variable;
+
+}  // namespace core
+}  // namespace ara
+
+#endif  // __linux__
+
+#endif  // TUSIMPLEAP_ARA_CORE_FUTEX_CONDITION_VARIABLE_H_
@@ -13,11 +13,13 @@
 
 #include <cassert>
 #include <chrono>
+#include <memory>
 #include <system_error>
 
 #include "ara/core/core_error_domain.h"
 #include "ara/core/error_code.h"
 #include "ara/core/exception.h"
+#include "ara/core/executor.h"
 #include "ara/core/future_error_domain.h"
 #include "ara/core/future_inl.h"
 #include "ara/core/internal/core.h"
@@ -243,6 +245,48 @@ public:
     return f;
   }
 
+  /**
+   * @brief Return a Future that becomes ready on the given executor.
+   *
+   * Once this Future holds a result, the result is posted to @a executor
+   * and the returned Future is satisfied from there. Continuations attached
+   * to the returned Future therefore run on the executor and not on the
+   * thread that fulfilled the Promise.
+   *
+   * @param executor an executor supported by ExecutorTraits, it has to
+   * outlive the hand-over of the result
+   *
+   * @returns a new Future instance carrying the same result
+   */
+  template <typename Ex>
+  Future<T, E> via(Ex& executor) {
+    auto p = std::make_shared<Promise<T, E>>();
+    auto f = p->get_future();
+
+    core_->SetCallback([&executor, p](const R& result) {
+      ExecutorTraits<Ex>::Execute(executor, [p, result]() { p->SetResult(result); });
+    });
+    return f;
+  }
+
+  /**
+   * @brief Register a function that gets called on the given executor when
+   * the future becomes ready.
+   *
+   * Same as then(F&&), except that @a func is always invoked by
+   * @a executor. This keeps heavy continuations off I/O threads.
+   *
+   * @param executor an executor supported by ExecutorTraits
+   * @param func a Callable to register to get the Future result or an
+   * exception
+   *
+   * @returns a new Future instance for the result of the continuation
+   */
+  template <typename Ex, typename F>
+  auto then(Ex& executor, F&& func) -> ThenReturnType<F, R> {
+    return via(executor).then(std::forward<F>(func));
+  }
+
   /**
    * True when the future contains either a result or an exception.
    *
@@ -506,6 +550,48 @@ public:
     return f;
   }
 
+  /**
+   * @brief Return a Future that becomes ready on the given executor.
+   *
+   * Once this Future holds a result, the result is posted to @a executor
+   * and the returned Future is satisfied from there. Continuations attached
+   * to the returned Future therefore run on the executor and not on the
+   * thread that fulfilled the Promise.
+   *
+   * @param executor an executor supported by ExecutorTraits, it has to
+   * outlive the hand-over of the result
+   *
+   * @returns a new Future instance carrying the same result
+   */
+  template <typename Ex>
+  Future<void, E> via(Ex& executor) {
+    auto p = std::make_shared<Promise<void, E>>();
+    auto f = p->get_future();
+
+    core_->SetCallback([&executor, p](const R& result) {
+      ExecutorTraits<Ex>::Execute(executor, [p, result]() { p->SetResult(result); });
+    });
+    return f;
+  }
+
+  /**
+   * @brief Register a function that gets called on the given executor when
+   * the future becomes ready.
+   *
+   * Same as then(F&&), except that @a func is always invoked by
+   * @a executor. This keeps heavy continuations off I/O threads.
+   *
+   * @param executor an executor supported by ExecutorTraits
+   * @param func a Callable to register to get the Future result or an
+   * exception
+   *
+   * @returns a new Future instance for the result of the continuation
+   */
+  template <typename Ex, typename F>
+  auto then(Ex& executor, F&& func) -> ThenReturnType<F, R> {
+    return via(executor).then(std::forward<F>(func));
+  }
+
   /**
    * True when the future contains either a result or an exception.
    *
@@ -23,10 +23,11 @@
 #include "ara/core/error_code.h"
 #include "ara/core/exception.h"
 #include "ara/core/functional.h"
+#include "ara/core/internal/core_allocator.h"
 #include "ara/core/future_error_domain.h"
 #include "ara/core/future_inl.h"
 #include "ara/core/result.h"
-#include "ara/core/condition_variable.h"
+#include "ara/core/futex_condition_variable.h"
 
 namespace ara {
 namespace core {
@@ -97,9 +98,11 @@ public:
    * is_ready() will return true.
    */
   void wait() {
-    while (!is_ready()) {
-      std::this_thread::sleep_for(std::chrono::duration<double>(0.001));
+    if (is_ready()) {
+      return;
     }
+    std::unique_lock<std::mutex> lck(mutex_);
+    cv_.wait(lck, [&]() { return is_ready(); });
   }
 
   /**
@@ -217,7 +220,7 @@ public:
               state,
               State::OnlyResult,
               std::memory_order_seq_cst)) {
-        cv_.notify_all();
+        NotifyWaiters();
         return;
       }
     }
@@ -225,7 +228,7 @@ public:
       state_.store(State::Done, std::memory_order_relaxed);
       callback_(result_);
     }
-    cv_.notify_all();
+    NotifyWaiters();
   }
 
   /**
@@ -242,7 +245,7 @@ public:
               state,
               State::OnlyResult,
               std::memory_order_seq_cst)) {
-        cv_.notify_all();
+        NotifyWaiters();
         return;
       }
     }
@@ -250,33 +253,48 @@ public:
       state_.store(State::Done, std::memory_order_relaxed);
       callback_(result_);
     }
-    cv_.notify_all();
+    NotifyWaiters();
   }
 
   void detach_one() {
     auto count = count_.fetch_sub(1, std::memory_order_acq_rel);
     if (count == 1) {
-      delete this;
+      Destroy();
     }
   }
 
   void promise_detach() {
-    auto count = count_.fetch_sub(1, std::memory_order_acq_rel);
-    cv_.notify_all();
+    std::uint8_t count;
+    {
+      // under mutex_, a waiter in wait_for() sees count_ drop before it sleeps or is woken, and
+      // doesn't return, and detach, before the notify is done
+      std::lock_guard<std::mutex> lck(mutex_);
+      count = count_.fetch_sub(1, std::memory_order_acq_rel);
+      cv_.notify_all();
+    }
     if (count == 1) {
-      delete this;
+      Destroy();
     }
   }
 
   /**
    * @brief use for free self
    */
-  void detach() { delete this; }
+  void detach() { Destroy(); }
 
   /**
    * @brief use for malloc self
+   *
+   * The memory comes from CoreAllocator, so in steady state no heap
+   * allocation happens per Promise.
    */
-  static Core<T, E>* make() { return new (std::nothrow) Core<T, E>(); }
+  static Core<T, E>* make() {
+    void* block = CoreAllocator<Core<T, E>>::Allocate();
+    if (block == nullptr) {
+      return nullptr;
+    }
+    return new (block) Core<T, E>();
+  }
 
   /**
    * @brief Sets the callback.
@@ -332,6 +350,25 @@ public:
   std::uint8_t GetCount() { return count_; }
 
 private:
+  /**
+   * @brief Wake the waiters after state_ changed.
+   *
+   * The waiters check state_ under mutex_ and the setters don't hold it, so notifying under
+   * mutex_ keeps the wakeup from falling between a waiter's check and its sleep.
+   */
+  void NotifyWaiters() {
+    std::lock_guard<std::mutex> lck(mutex_);
+    cv_.notify_all();
+  }
+
+  /**
+   * @brief Counterpart of make()
+   */
+  void Destroy() {
+    this->~Core();
+    CoreAllocator<Core<T, E>>::Deallocate(this);
+  }
+
   union {
     R result_;
   };
@@ -339,7 +376,7 @@ private:
   std::atomic<std::uint8_t> count_;
   CallBack callback_;
 
-  ConditionVariable cv_;
+  FutexConditionVariable cv_;
   std::mutex mutex_;
 };
 
@@ -0,0 +1,214 @@
+/**
+ * @file
+ * @brief Interface to class ara::core::CoreAllocator
+ *
+ * The shared state between a Promise and its Future is created for every
+ * asynchronous call, so it is recycled through per-thread free lists
+ * instead of going to the global heap each time.
+ */
+
+#ifndef TUSIMPLEAP_ARA_CORE_INTERNAL_CORE_ALLOCATOR_HPP_
+#define TUSIMPLEAP_ARA_CORE_INTERNAL_CORE_ALLOCATOR_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace ara {
+namespace core {
+namespace internal {
+
+/**
+ * @brief Free list cache for blocks of one size class.
+ *
+ * Each thread keeps up to kMaxCached blocks for itself. A thread that only
+ * frees (e.g. an I/O thread fulfilling promises created elsewhere) hands
+ * half of its list over to a process wide depot once it is full, and a
+ * thread that runs dry takes a whole batch back from there, so the mutex
+ * is only taken once per kBatch blocks. A thread that only allocates while
+ * the depot is empty goes to the heap without taking the mutex at all.
+ *
+ * @tparam Size size of a block in bytes
+ * @tparam Align alignment of a block
+ */
+template <std::size_t Size, std::size_t Align>
+class BlockCache final {
+public:
+  static constexpr std::size_t kMaxCached = 64;
+  static constexpr std::size_t kBatch = kMaxCached / 2;
+  static constexpr std::size_t kMaxDepotBatches = 64;
+
+  /**
+   * @brief Take a block from the cache or from the heap.
+   *
+   * @returns a block of Size bytes or nullptr if the heap is exhausted
+   */
+  static void* Allocate() noexcept {
+    LocalList& local = Local();
+    if (local.head == nullptr && !local.dead) {
+      static_cast<void>(&reaper_);
+      Refill(local);
+    }
+    if (local.head != nullptr) {
+      Node* node = local.head;
+      local.head = node->next;
+      --local.size;
+      return node;
+    }
+    return ::operator new(kBlockSize, std::nothrow);
+  }
+
+  /**
+   * @brief Return a block to the cache.
+   *
+   * @param block a block obtained from Allocate(), possibly on another thread
+   */
+  static void Deallocate(void* block) noexcept {
+    LocalList& local = Local();
+    if (local.dead) {
+      ::operator delete(block);
+      return;
+    }
+    static_cast<void>(&reaper_);
+    Node* node = static_cast<Node*>(block);
+    node->next = local.head;
+    local.head = node;
+    if (++local.size > kMaxCached) {
+      Flush(local);
+    }
+  }
+
+private:
+  struct Node {
+    Node* next;
+    Node* next_batch;
+  };
+
+  static constexpr std::size_t kBlockSize = Size < sizeof(Node) ? sizeof(Node) : Size;
+  static_assert(Align <= alignof(std::max_align_t), "over-aligned shared state is not supported");
+
+  // Trivially destructible on purpose: it stays usable until the thread is
+  // gone, even while other thread_local destructors free their futures.
+  struct LocalList {
+    Node* head;
+    std::size_t size;
+    bool dead;
+  };
+
+  struct Reaper {
+    ~Reaper() {
+      LocalList& local = Local();
+      while (local.head != nullptr) {
+        Node* node = local.head;
+        local.head = node->next;
+        ::operator delete(node);
+      }
+      local.size = 0;
+      local.dead = true;
+    }
+  };
+
+  struct Depot {
+    std::mutex mutex;
+    Node* batches = nullptr;
+    std::atomic<std::size_t> count {0};  // written under mutex, read without it
+  };
+
+  static LocalList& Local() noexcept {
+    static thread_local LocalList local {nullptr, 0, false};
+    return local;
+  }
+
+  static Depot& GetDepot() noexcept {
+    // Intentionally leaked, blocks may be released after static destruction.
+    static Depot* depot = new Depot;
+    return *depot;
+  }
+
+  static void Refill(LocalList& local) noexcept {
+    Depot& depot = GetDepot();
+    if (depot.count.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(depot.mutex);
+    if (depot.batches != nullptr) {
+      Node* batch = depot.batches;
+      depot.batches = batch->next_batch;
+      depot.count.store(depot.count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+      local.head = batch;
+      local.size = kBatch;
+    }
+  }
+
+  static void Flush(LocalList& local) noexcept {
+    Node* batch = local.head;
+    Node* tail = batch;
+    for (std::size_t i = 1; i < kBatch; ++i) {
+      tail = tail->next;
+    }
+    local.head = tail->next;
+    local.size -= kBatch;
+    tail->next = nullptr;
+
+    {
+      Depot& depot = GetDepot();
+      std::lock_guard<std::mutex> lock(depot.mutex);
+      const std::size_t count = depot.count.load(std::memory_order_relaxed);
+      if (count < kMaxDepotBatches) {
+        batch->next_batch = depot.batches;
+        depot.batches = batch;
+        depot.count.store(count + 1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    while (batch != nullptr) {
+      Node* node = batch;
+      batch = node->next;
+      ::operator delete(node);
+    }
+  }
+
+  static thread_local Reaper reaper_;
+};
+
+template <std::size_t Size, std::size_t Align>
+thread_local typename BlockCache<Size, Align>::Reaper BlockCache<Size, Align>::reaper_;
+
+}  // namespace internal
+
+/**
+ * @brief Allocation hook for the shared state of Promise and Future.
+ *
+ * By default blocks are served from internal::BlockCache, which is shared by
+ * all shared state types of the same size; e.g. Core<std::size_t> and
+ * Core<int> recycle the same blocks. Specialize this template to place the
+ * shared state of a particular type into an arena. Define
+ * ARA_CORE_NO_CORE_POOL to fall back to plain operator new, e.g. for
+ * sanitizer builds.
+ *
+ * @tparam CoreType the shared state type
+ */
+template <typename CoreType>
+struct CoreAllocator {
+  static void* Allocate() noexcept {
+#ifdef ARA_CORE_NO_CORE_POOL
+    return ::operator new(sizeof(CoreType), std::nothrow);
+#else
+    return internal::BlockCache<sizeof(CoreType), alignof(CoreType)>::Allocate();
+#endif
+  }
+
+  static void Deallocate(void* block) noexcept {
+#ifdef ARA_CORE_NO_CORE_POOL
+    ::operator delete(block);
+#else
+    internal::BlockCache<sizeof(CoreType), alignof(CoreType)>::Deallocate(block);
+#endif
+  }
+};
+
+}  // namespace core
+}  // namespace ara
+
+#endif  // TUSIMPLEAP_ARA_CORE_INTERNAL_CORE_ALLOCATOR_HPP_
@@ -0,0 +1,127 @@
+/**
+ * @file
+ * @brief Building blocks shared by ara::core::FlatMap and ara::core::FlatSet
+ */
+
+#ifndef TUSIMPLEAP_ARA_CORE_INTERNAL_FLAT_TREE_H_
+#define TUSIMPLEAP_ARA_CORE_INTERNAL_FLAT_TREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "ara/core/string_view.h"
+
+namespace ara {
+namespace core {
+
+/**
+ * @brief Tag selecting the constructors that take already sorted input
+ * without duplicates, skipping the sort.
+ */
+struct SortedUniqueT {
+  explicit SortedUniqueT() = default;
+};
+
+constexpr SortedUniqueT sorted_unique {};
+
+namespace internal {
+
+template <typename...>
+using flat_void_t = void;
+
+// Anything with contiguous char data(), e.g. String, std::string, StringView
+// and StaticString.
+template <typename T, typename = void>
+struct IsStringLike : std::is_convertible<const T&, const char*> {};
+
+template <typename T>
+struct IsStringLike<
+    T,
+    flat_void_t<std::enable_if_t<std::is_same<decltype(std::declval<const T&>().data()), const char*>::value>,
+                decltype(std::declval<const T&>().size())>> : std::true_type {};
+
+inline StringView AsStringView(const char* s) noexcept { return StringView(s); }
+
+template <typename T, typename = std::enable_if_t<!std::is_convertible<const T&, const char*>::value>>
+StringView AsStringView(const T& s) noexcept {
+  return StringView(s.data(), s.size());
+}
+
+template <typename Compare, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename Compare>
+struct IsTransparent<Compare, flat_void_t<typename Compare::is_transparent>> : std::true_type {};
+
+}  // namespace internal
+
+/**
+ * @brief Default ordering of FlatMap and FlatSet.
+ *
+ * Behaves like std::less<>, and additionally orders all string types by
+ * their characters, so a FlatMap<String, T> can be searched with a
+ * StringView or a string literal without creating a String.
+ */
+struct TransparentLess {
+  using is_transparent = void;
+
+  template <typename A,
+            typename B,
+            std::enable_if_t<internal::IsStringLike<A>::value && internal::IsStringLike<B>::value, int> = 0>
+  bool operator()(const A& a, const B& b) const noexcept {
+    return internal::AsStringView(a).compare(internal::AsStringView(b)) < 0;
+  }
+
+  template <typename A,
+            typename B,
+            std::enable_if_t<!(internal::IsStringLike<A>::value && internal::IsStringLike<B>::value), int> = 0>
+  constexpr bool operator()(const A& a, const B& b) const {
+    return a < b;
+  }
+};
+
+namespace internal {
+
+/**
+ * @brief Sort [first, last) and drop all but the first of equivalent
+ * elements.
+ *
+ * @returns the new end of the range
+ */
+template <typename Iterator, typename Compare>
+Iterator SortUnique(Iterator first, Iterator last, Compare comp) {
+  std::stable_sort(first, last, comp);
+  return std::unique(first, last, [&comp](const typename std::iterator_traits<Iterator>::value_type& a,
+                                          const typename std::iterator_traits<Iterator>::value_type& b) {
+    return !comp(a, b);
+  });
+}
+
+/**
+ * @brief Merge the unsorted tail starting at @a middle into the sorted,
+ * unique container, keeping existing elements over new equivalent ones.
+ */
+template <typename Container, typename Compare>
+void MergeUnique(Container& c, typename Container::iterator middle, Compare comp) {
+  const auto offset = std::distance(c.begin(), middle);
+  auto tail_end = SortUnique(middle, c.end(), comp);
+  c.erase(tail_end, c.end());
+  middle = c.begin() + offset;
+  std::inplace_merge(c.begin(), middle, c.end(), comp);
+  // After a stable merge the existing element precedes its new equivalent.
+  c.erase(std::unique(c.begin(),
+                      c.end(),
+                      [&comp](const typename Container::value_type& a, const typename Container::value_type& b) {
+                        return !comp(a, b);
+                      }),
+          c.end());
+}
+
+}  // namespace internal
+}  // namespace core
+}  // namespace ara
+
+#endif  // TUSIMPLEAP_ARA_CORE_INTERNAL_FLAT_TREE_H_
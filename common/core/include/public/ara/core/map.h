@@ -12,6 +12,8 @@
 #include <memory>
 #include <type_traits>
 
+#include "ara/core/memory_resource.h"
+
 namespace ara {
 namespace core {
 
@@ -55,6 +57,20 @@ void swap(Map<Key, T, C, Allocator>& lhs, Map<Key, T, C, Allocator>& rhs) {
   lhs.swap(rhs);
 }
 
+namespace pmr {
+
+/**
+ * @brief Map whose memory comes from a memory_resource
+ *
+ * @tparam Key  the type of keys in this Map
+ * @tparam T  the type of values in this Map
+ * @tparam C  the type of comparison Callable
+ */
+template <typename Key, typename T, typename C = std::less<Key>>
+using Map = core::Map<Key, T, C, polymorphic_allocator<std::pair<const Key, T>>>;
+
+}  // namespace pmr
+
 }  // namespace core
 }  // namespace ara
 
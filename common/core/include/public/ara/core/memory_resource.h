@@ -0,0 +1,705 @@
+/**
+ * @file
+ * @brief Interface to ara::core::pmr, polymorphic memory resources
+ *
+ * A C++14 implementation of the C++17 <memory_resource> facilities. The
+ * containers ara::core::pmr::Vector, ara::core::pmr::Map and
+ * ara::core::pmr::String take their memory from a memory_resource chosen at
+ * run time, e.g. a monotonic_buffer_resource that releases all temporaries
+ * of a processing cycle at once:
+ *
+ * @code
+ * ara::core::pmr::monotonic_buffer_resource arena(64 * 1024);
+ * for (;;) {
+ *   ara::core::pmr::Vector<Object> objects(&arena);
+ *   ...
+ *   objects = {};
+ *   arena.release();
+ * }
+ * @endcode
+ */
+
+#ifndef TUSIMPLEAP_ARA_CORE_MEMORY_RESOURCE_H_
+#define TUSIMPLEAP_ARA_CORE_MEMORY_RESOURCE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ara {
+namespace core {
+namespace pmr {
+
+/**
+ * @brief Abstract interface to a source of memory.
+ */
+class memory_resource {
+public:
+  static constexpr std::size_t kMaxAlign = alignof(std::max_align_t);
+
+  virtual ~memory_resource() = default;
+
+  /**
+   * @brief Allocate at least @a bytes aligned to @a alignment.
+   *
+   * @throws std::bad_alloc if the request cannot be satisfied
+   */
+  void* allocate(std::size_t bytes, std::size_t alignment = kMaxAlign) { return do_allocate(bytes, alignment); }
+
+  /**
+   * @brief Return memory obtained from allocate() with the same arguments.
+   */
+  void deallocate(void* p, std::size_t bytes, std::size_t alignment = kMaxAlign) {
+    do_deallocate(p, bytes, alignment);
+  }
+
+  /**
+   * @brief Whether memory allocated from @a other can be deallocated here.
+   */
+  bool is_equal(const memory_resource& other) const noexcept { return do_is_equal(other); }
+
+private:
+  virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+  virtual void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) = 0;
+  virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource& lhs, const memory_resource& rhs) noexcept {
+  return &lhs == &rhs || lhs.is_equal(rhs);
+}
+
+inline bool operator!=(const memory_resource& lhs, const memory_resource& rhs) noexcept { return !(lhs == rhs); }
+
+namespace internal {
+
+inline std::size_t AlignUp(std::size_t n, std::size_t alignment) noexcept {
+  return (n + alignment - 1U) & ~(alignment - 1U);
+}
+
+class NewDeleteResource final : public memory_resource {
+private:
+  // Over-aligned requests keep the pointer returned by operator new in front
+  // of the aligned block, C++14 has no aligned operator new.
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    if (alignment <= kMaxAlign) {
+      return ::operator new(bytes);
+    }
+    void* raw = ::operator new(bytes + alignment + sizeof(void*));
+    auto aligned = AlignUp(reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*), alignment);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  void do_deallocate(void* p, std::size_t, std::size_t alignment) override {
+    if (alignment <= kMaxAlign) {
+      ::operator delete(p);
+    } else {
+      ::operator delete(static_cast<void**>(p)[-1]);
+    }
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return dynamic_cast<const NewDeleteResource*>(&other) != nullptr;
+  }
+};
+
+class NullResource final : public memory_resource {
+private:
+  void* do_allocate(std::size_t, std::size_t) override { throw std::bad_alloc(); }
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+  bool do_is_equal(const memory_resource& other) const noexcept override { return &other == this; }
+};
+
+inline std::atomic<memory_resource*>& DefaultResource() noexcept;
+
+}  // namespace internal
+
+/**
+ * @brief Resource forwarding to global operator new and operator delete.
+ */
+inline memory_resource* new_delete_resource() noexcept {
+  // Intentionally leaked, containers may outlive static destruction.
+  static memory_resource* resource = new internal::NewDeleteResource;
+  return resource;
+}
+
+/**
+ * @brief Resource whose allocate() always throws std::bad_alloc.
+ *
+ * Useful as upstream of a monotonic_buffer_resource on a fixed buffer that
+ * must never fall back to the heap.
+ */
+inline memory_resource* null_memory_resource() noexcept {
+  static memory_resource* resource = new internal::NullResource;
+  return resource;
+}
+
+namespace internal {
+
+inline std::atomic<memory_resource*>& DefaultResource() noexcept {
+  static std::atomic<memory_resource*> resource {new_delete_resource()};
+  return resource;
+}
+
+}  // namespace internal
+
+/**
+ * @brief Resource used by default constructed polymorphic_allocator.
+ */
+inline memory_resource* get_default_resource() noexcept {
+  return internal::DefaultResource().load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Replace the default resource.
+ *
+ * @param r the new default resource, nullptr restores new_delete_resource()
+ * @returns the previous default resource
+ */
+inline memory_resource* set_default_resource(memory_resource* r) noexcept {
+  return internal::DefaultResource().exchange(r != nullptr ? r : new_delete_resource(), std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Allocator that forwards to a memory_resource.
+ *
+ * Constructing an element passes the allocator on to elements that are
+ * themselves allocator aware (uses-allocator construction), so e.g. the
+ * strings in a pmr::Vector<pmr::String> live in the same resource as the
+ * vector. The allocator does not propagate on container copy, move or
+ * swap.
+ *
+ * @tparam T the value type
+ */
+template <typename T>
+class polymorphic_allocator {
+public:
+  using value_type = T;
+
+  polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+
+  polymorphic_allocator(memory_resource* r) noexcept : resource_(r) {}
+
+  polymorphic_allocator(const polymorphic_allocator& other) = default;
+
+  template <typename U>
+  polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept : resource_(other.resource()) {}
+
+  polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+
+  T* allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) { resource_->deallocate(p, n * sizeof(T), alignof(T)); }
+
+  template <typename U, typename... Args>
+  void construct(U* p, Args&&... args) {
+    ConstructImpl(UsesAllocatorTag<U, Args...>(), p, std::forward<Args>(args)...);
+  }
+
+  template <typename T1, typename T2, typename... Args1, typename... Args2>
+  void construct(std::pair<T1, T2>* p, std::piecewise_construct_t, std::tuple<Args1...> x, std::tuple<Args2...> y) {
+    ::new (static_cast<void*>(p)) std::pair<T1, T2>(std::piecewise_construct,
+                                                    AddAllocator<T1>(std::move(x)),
+                                                    AddAllocator<T2>(std::move(y)));
+  }
+
+  template <typename T1, typename T2>
+  void construct(std::pair<T1, T2>* p) {
+    construct(p, std::piecewise_construct, std::tuple<>(), std::tuple<>());
+  }
+
+  template <typename T1, typename T2, typename U, typename V>
+  void construct(std::pair<T1, T2>* p, U&& x, V&& y) {
+    construct(p,
+              std::piecewise_construct,
+              std::forward_as_tuple(std::forward<U>(x)),
+              std::forward_as_tuple(std::forward<V>(y)));
+  }
+
+  template <typename T1, typename T2, typename U, typename V>
+  void construct(std::pair<T1, T2>* p, const std::pair<U, V>& pr) {
+    construct(p, std::piecewise_construct, std::forward_as_tuple(pr.first), std::forward_as_tuple(pr.second));
+  }
+
+  template <typename T1, typename T2, typename U, typename V>
+  void construct(std::pair<T1, T2>* p, std::pair<U, V>&& pr) {
+    construct(p,
+              std::piecewise_construct,
+              std::forward_as_tuple(std::forward<U>(pr.first)),
+              std::forward_as_tuple(std::forward<V>(pr.second)));
+  }
+
+  template <typename U>
+  void destroy(U* p) {
+    p->~U();
+  }
+
+  /**
+   * @brief Containers copied from a pmr container use the default resource.
+   */
+  polymorphic_allocator select_on_container_copy_construction() const noexcept { return polymorphic_allocator(); }
+
+  memory_resource* resource() const noexcept { return resource_; }
+
+private:
+  // 0: no allocator, 1: leading allocator_arg, 2: trailing allocator
+  template <int I>
+  using Tag = std::integral_constant<int, I>;
+
+  template <typename U, typename... Args>
+  using UsesAllocatorTag =
+      Tag<!std::uses_allocator<U, polymorphic_allocator>::value
+              ? 0
+              : std::is_constructible<U, std::allocator_arg_t, const polymorphic_allocator&, Args...>::value ? 1 : 2>;
+
+  template <typename U, typename... Args>
+  void ConstructImpl(Tag<0>, U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template <typename U, typename... Args>
+  void ConstructImpl(Tag<1>, U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::allocator_arg, *this, std::forward<Args>(args)...);
+  }
+
+  template <typename U, typename... Args>
+  void ConstructImpl(Tag<2>, U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)..., *this);
+  }
+
+  template <typename U, typename... Args>
+  std::tuple<Args&&...> AddAllocatorImpl(Tag<0>, std::tuple<Args...>&& t) {
+    return std::tuple<Args&&...>(std::move(t));
+  }
+
+  template <typename U, typename... Args>
+  std::tuple<std::allocator_arg_t, const polymorphic_allocator&, Args&&...> AddAllocatorImpl(Tag<1>,
+                                                                                           std::tuple<Args...>&& t) {
+    return std::tuple_cat(std::tuple<std::allocator_arg_t, const polymorphic_allocator&>(std::allocator_arg, *this),
+                          std::tuple<Args&&...>(std::move(t)));
+  }
+
+  template <typename U, typename... Args>
+  std::tuple<Args&&..., const polymorphic_allocator&> AddAllocatorImpl(Tag<2>, std::tuple<Args...>&& t) {
+    return std::tuple_cat(std::tuple<Args&&...>(std::move(t)), std::tuple<const polymorphic_allocator&>(*this));
+  }
+
+  template <typename U, typename... Args>
+  auto AddAllocator(std::tuple<Args...>&& t)
+      -> decltype(AddAllocatorImpl<U>(UsesAllocatorTag<U, Args...>(), std::move(t))) {
+    return AddAllocatorImpl<U>(UsesAllocatorTag<U, Args...>(), std::move(t));
+  }
+
+  memory_resource* resource_;
+};
+
+template <typename T, typename U>
+bool operator==(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept {
+  return *lhs.resource() == *rhs.resource();
+}
+
+template <typename T, typename U>
+bool operator!=(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+/**
+ * @brief Arena that hands out memory by bumping a pointer.
+ *
+ * deallocate() is a no-op; all memory is returned at once by release() or
+ * the destructor. Memory comes from an optional initial buffer first and
+ * then from chunks of the upstream resource whose size grows geometrically.
+ * Not thread safe.
+ */
+class monotonic_buffer_resource : public memory_resource {
+public:
+  static constexpr std::size_t kDefaultChunkSize = 1024U;
+
+  explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource()) noexcept :
+      monotonic_buffer_resource(kDefaultChunkSize, upstream) {}
+
+  monotonic_buffer_resource(std::size_t initial_size, memory_resource* upstream = get_default_resource()) noexcept :
+      upstream_(upstream), next_chunk_size_(initial_size != 0U ? initial_size : 1U), initial_chunk_size_(next_chunk_size_) {}
+
+  monotonic_buffer_resource(void* buffer, std::size_t size, memory_resource* upstream = get_default_resource()) noexcept
+      :
+      upstream_(upstream),
+      buffer_(buffer),
+      buffer_size_(size),
+      current_(static_cast<char*>(buffer)),
+      available_(size),
+      next_chunk_size_(size != 0U ? size * 2U : kDefaultChunkSize),
+      initial_chunk_size_(next_chunk_size_) {}
+
+  monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+  monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+  ~monotonic_buffer_resource() override { release(); }
+
+  /**
+   * @brief Return all chunks to upstream and start over at the initial buffer.
+   */
+  void release() noexcept {
+    while (chunks_ != nullptr) {
+      Chunk* chunk = chunks_;
+      chunks_ = chunk->next;
+      upstream_->deallocate(chunk, chunk->size, chunk->alignment);
+    }
+    current_ = static_cast<char*>(buffer_);
+    available_ = buffer_size_;
+    next_chunk_size_ = initial_chunk_size_;
+  }
+
+  memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+private:
+  struct Chunk {
+    Chunk* next;
+    std::size_t size;
+    std::size_t alignment;
+  };
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void* p = Bump(bytes, alignment);
+    if (p == nullptr) {
+      NewChunk(bytes, alignment);
+      p = Bump(bytes, alignment);
+    }
+    return p;
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+  void* Bump(std::size_t bytes, std::size_t alignment) noexcept {
+    if (current_ == nullptr) {
+      return nullptr;
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(current_);
+    const std::size_t padding = internal::AlignUp(address, alignment) - address;
+    if (padding > available_ || bytes > available_ - padding) {
+      return nullptr;
+    }
+    void* p = current_ + padding;
+    current_ += padding + bytes;
+    available_ -= padding + bytes;
+    return p;
+  }
+
+  void NewChunk(std::size_t bytes, std::size_t alignment) {
+    const std::size_t chunk_alignment = alignment > alignof(Chunk) ? alignment : alignof(Chunk);
+    const std::size_t header = internal::AlignUp(sizeof(Chunk), alignment);
+    std::size_t size = next_chunk_size_;
+    if (size < header + bytes) {
+      size = header + bytes;
+    }
+    auto* chunk = static_cast<Chunk*>(upstream_->allocate(size, chunk_alignment));
+    chunk->next = chunks_;
+    chunk->size = size;
+    chunk->alignment = chunk_alignment;
+    chunks_ = chunk;
+    current_ = reinterpret_cast<char*>(chunk) + header;
+    available_ = size - header;
+    if (next_chunk_size_ <= std::numeric_limits<std::size_t>::max() / 2U) {
+      next_chunk_size_ *= 2U;
+    }
+  }
+
+  memory_resource* upstream_;
+  void* buffer_ = nullptr;
+  std::size_t buffer_size_ = 0U;
+  char* current_ = nullptr;
+  std::size_t available_ = 0U;
+  std::size_t next_chunk_size_;
+  std::size_t initial_chunk_size_;
+  Chunk* chunks_ = nullptr;
+};
+
+/**
+ * @brief Tuning of the pool resources.
+ */
+struct pool_options {
+  /// Upper bound for the number of blocks taken from upstream at once, 0 for
+  /// the default
+  std::size_t max_blocks_per_chunk = 0U;
+  /// Largest request served from a pool, bigger ones go to upstream
+  /// directly; 0 for the default
+  std::size_t largest_required_pool_block = 0U;
+};
+
+/**
+ * @brief Pools of fixed size blocks, not thread safe.
+ *
+ * Requests are rounded up to a power of two between 8 bytes and
+ * largest_required_pool_block and served from a per size free list that is
+ * refilled in growing chunks from upstream. Freed blocks go back to their
+ * free list, so a steady state of allocations and deallocations does not
+ * reach upstream. Larger or over-aligned requests are forwarded to upstream
+ * and tracked so release() can free them as well.
+ */
+class unsynchronized_pool_resource : public memory_resource {
+public:
+  static constexpr std::size_t kMinBlock = 8U;
+  static constexpr std::size_t kDefaultLargestBlock = 4096U;
+  static constexpr std::size_t kDefaultMaxBlocksPerChunk = 1024U;
+
+  unsynchronized_pool_resource(const pool_options& opts, memory_resource* upstream) :
+      upstream_(upstream), options_(Normalize(opts)) {
+    std::size_t count = 0U;
+    for (std::size_t size = kMinBlock; size <= options_.largest_required_pool_block; size *= 2U) {
+      ++count;
+    }
+    pools_ = static_cast<Pool*>(upstream_->allocate(sizeof(Pool) * count, alignof(Pool)));
+    pool_count_ = count;
+    for (std::size_t i = 0U; i < pool_count_; ++i) {
+      ::new (&pools_[i]) Pool {kMinBlock << i, nullptr, nullptr, 1U};
+    }
+  }
+
+  unsynchronized_pool_resource() : unsynchronized_pool_resource(pool_options(), get_default_resource()) {}
+
+  explicit unsynchronized_pool_resource(memory_resource* upstream) :
+      unsynchronized_pool_resource(pool_options(), upstream) {}
+
+  explicit unsynchronized_pool_resource(const pool_options& opts) :
+      unsynchronized_pool_resource(opts, get_default_resource()) {}
+
+  unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+  unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+  ~unsynchronized_pool_resource() override {
+    release();
+    upstream_->deallocate(pools_, sizeof(Pool) * pool_count_, alignof(Pool));
+  }
+
+  /**
+   * @brief Return all memory to upstream, including blocks still in use.
+   */
+  void release() noexcept {
+    for (std::size_t i = 0U; i < pool_count_; ++i) {
+      Pool& pool = pools_[i];
+      while (pool.chunks != nullptr) {
+        Chunk* chunk = pool.chunks;
+        pool.chunks = chunk->next;
+        upstream_->deallocate(chunk, chunk->size, kMaxAlign);
+      }
+      pool.free_list = nullptr;
+      pool.next_blocks = 1U;
+    }
+    while (large_ != nullptr) {
+      Large* large = large_;
+      large_ = large->next;
+      upstream_->deallocate(large->base, large->size, large->alignment);
+    }
+  }
+
+  memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+  pool_options options() const noexcept { return options_; }
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    Pool* pool = Find(bytes, alignment);
+    if (pool == nullptr) {
+      return AllocateLarge(bytes, alignment);
+    }
+    if (pool->free_list == nullptr) {
+      Refill(*pool);
+    }
+    Block* block = pool->free_list;
+    pool->free_list = block->next;
+    return block;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    Pool* pool = Find(bytes, alignment);
+    if (pool == nullptr) {
+      DeallocateLarge(p, alignment);
+      return;
+    }
+    Block* block = static_cast<Block*>(p);
+    block->next = pool->free_list;
+    pool->free_list = block;
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+  struct Block {
+    Block* next;
+  };
+
+  struct Chunk {
+    Chunk* next;
+    std::size_t size;
+  };
+
+  struct Pool {
+    std::size_t block_size;
+    Block* free_list;
+    Chunk* chunks;
+    std::size_t next_blocks;
+  };
+
+  // Header in front of every block forwarded to upstream.
+  struct Large {
+    Large* next;
+    Large* prev;
+    void* base;
+    std::size_t size;
+    std::size_t alignment;
+  };
+
+  static pool_options Normalize(pool_options opts) noexcept {
+    if (opts.max_blocks_per_chunk == 0U) {
+      opts.max_blocks_per_chunk = kDefaultMaxBlocksPerChunk;
+    }
+    if (opts.largest_required_pool_block == 0U) {
+      opts.largest_required_pool_block = kDefaultLargestBlock;
+    }
+    std::size_t largest = kMinBlock;
+    while (largest < opts.largest_required_pool_block) {
+      largest *= 2U;
+    }
+    opts.largest_required_pool_block = largest;
+    return opts;
+  }
+
+  Pool* Find(std::size_t bytes, std::size_t alignment) noexcept {
+    if (bytes > options_.largest_required_pool_block || alignment > kMaxAlign) {
+      return nullptr;
+    }
+    std::size_t size = bytes > alignment ? bytes : alignment;
+    std::size_t index = 0U;
+    while ((kMinBlock << index) < size) {
+      ++index;
+    }
+    return &pools_[index];
+  }
+
+  void Refill(Pool& pool) {
+    const std::size_t header = internal::AlignUp(sizeof(Chunk), kMaxAlign);
+    const std::size_t blocks = pool.next_blocks;
+    const std::size_t size = header + blocks * pool.block_size;
+    auto* chunk = static_cast<Chunk*>(upstream_->allocate(size, kMaxAlign));
+    chunk->next = pool.chunks;
+    chunk->size = size;
+    pool.chunks = chunk;
+
+    char* first = reinterpret_cast<char*>(chunk) + header;
+    for (std::size_t i = blocks; i > 0U; --i) {
+      Block* block = reinterpret_cast<Block*>(first + (i - 1U) * pool.block_size);
+      block->next = pool.free_list;
+      pool.free_list = block;
+    }
+    if (pool.next_blocks * 2U <= options_.max_blocks_per_chunk) {
+      pool.next_blocks *= 2U;
+    }
+  }
+
+  static std::size_t LargeHeader(std::size_t alignment) noexcept {
+    return internal::AlignUp(sizeof(Large), alignment > alignof(Large) ? alignment : alignof(Large));
+  }
+
+  void* AllocateLarge(std::size_t bytes, std::size_t alignment) {
+    const std::size_t header = LargeHeader(alignment);
+    const std::size_t upstream_alignment = alignment > alignof(Large) ? alignment : alignof(Large);
+    void* base = upstream_->allocate(header + bytes, upstream_alignment);
+    auto* large = reinterpret_cast<Large*>(static_cast<char*>(base) + header - sizeof(Large));
+    large->base = base;
+    large->size = header + bytes;
+    large->alignment = upstream_alignment;
+    large->prev = nullptr;
+    large->next = large_;
+    if (large_ != nullptr) {
+      large_->prev = large;
+    }
+    large_ = large;
+    return static_cast<char*>(base) + header;
+  }
+
+  void DeallocateLarge(void* p, std::size_t) noexcept {
+    auto* large = reinterpret_cast<Large*>(static_cast<char*>(p) - sizeof(Large));
+    if (large->prev != nullptr) {
+      large->prev->next = large->next;
+    } else {
+      large_ = large->next;
+    }
+    if (large->next != nullptr) {
+      large->next->prev = large->prev;
+    }
+    upstream_->deallocate(large->base, large->size, large->alignment);
+  }
+
+  memory_resource* upstream_;
+  pool_options options_;
+  Pool* pools_ = nullptr;
+  std::size_t pool_count_ = 0U;
+  Large* large_ = nullptr;
+};
+
+/**
+ * @brief Thread safe variant of unsynchronized_pool_resource.
+ *
+ * All pools share one mutex; use an unsynchronized_pool_resource per thread
+ * where contention matters.
+ */
+class synchronized_pool_resource : public memory_resource {
+public:
+  synchronized_pool_resource(const pool_options& opts, memory_resource* upstream) : pool_(opts, upstream) {}
+
+  synchronized_pool_resource() : pool_() {}
+
+  explicit synchronized_pool_resource(memory_resource* upstream) : pool_(upstream) {}
+
+  explicit synchronized_pool_resource(const pool_options& opts) : pool_(opts) {}
+
+  synchronized_pool_resource(const synchronized_pool_resource&) = delete;
+  synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
+
+  ~synchronized_pool_resource() override = default;
+
+  void release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.release();
+  }
+
+  memory_resource* upstream_resource() const noexcept { return pool_.upstream_resource(); }
+
+  pool_options options() const noexcept { return pool_.options(); }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pool_.allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+  std::mutex mutex_;
+  unsynchronized_pool_resource pool_;
+};
+
+}  // namespace pmr
+}  // namespace core
+}  // namespace ara
+
+#endif  // TUSIMPLEAP_ARA_CORE_MEMORY_RESOURCE_H_
@@ -7,8 +7,10 @@
 #include <string.h>
 #include <algorithm>
 #include <atomic>
+#include <type_traits>
 
 #include "ara/core/core_error_domain.h"
+#include "ara/core/shared_memory.h"
 
 namespace ara {
 namespace core {
@@ -97,6 +99,51 @@ class NvArray {
   NvArray(T *cpu_data_ptr = nullptr, T *gpu_data_ptr = nullptr) 
       : cpu_ptr_(cpu_data_ptr), gpu_ptr_(gpu_data_ptr), length_(N) {}
 
+  /**
+   * @brief Allocate the elements in a new shared memory segment @a name.
+   *
+   * Send Share() to another process, which gets an NvArray over the same
+   * pages from OpenShared(). The segment goes away with the last NvArray
+   * referring to it in any process.
+   */
+  static NvArray CreateShared(StringView name) {
+    static_assert(std::is_trivially_copyable<T>::value && std::is_standard_layout<T>::value,
+                  "only plain data can be shared between processes");
+    NvArray array;
+    array.shm_ = SharedMemorySegment::Create(name, N * sizeof(T)).ValueOrThrow();
+    array.cpu_ptr_ = static_cast<T*>(array.shm_.data());
+    return array;
+  }
+
+  /**
+   * @brief Map the array another process shared with Share().
+   */
+  static NvArray OpenShared(const SharedMemoryDescriptor& descriptor) {
+    static_assert(std::is_trivially_copyable<T>::value && std::is_standard_layout<T>::value,
+                  "only plain data can be shared between processes");
+    if (descriptor.size != N * sizeof(T)) {
+      ErrorCode(CoreErrc::invalid_argument).ThrowAsException();
+    }
+    NvArray array;
+    array.shm_ = SharedMemorySegment::Open(descriptor).ValueOrThrow();
+    array.cpu_ptr_ = static_cast<T*>(array.shm_.data());
+    return array;
+  }
+
+  /**
+   * @brief Describe the shared segment for OpenShared() in another process.
+   *
+   * Each returned descriptor holds a reference and must be opened once.
+   */
+  SharedMemoryDescriptor Share() const {
+    if (!shm_.valid()) {
+      ErrorCode(CoreErrc::invalid_argument).ThrowAsException();
+    }
+    return shm_.Share();
+  }
+
+  bool IsShared() const { return shm_.valid(); }
+
   NvArray(const NvArray& rhs) {
     *this = rhs;
   }
@@ -110,6 +157,7 @@ class NvArray {
     if(this->cpu_ptr_ == rhs.cpu_ptr_ && this->gpu_ptr_ == rhs.gpu_ptr_) {
       this->length_ = rhs.length_;
       this->count_ = rhs.count_;
+      this->shm_ = rhs.shm_;
       return *this;
     }
 
@@ -128,6 +176,7 @@ class NvArray {
       this->gpu_ptr_ = rhs.gpu_ptr_;
       this->length_ = rhs.length_;
       this->count_ = rhs.count_;
+      this->shm_ = rhs.shm_;
     }
 
     return *this;
@@ -166,6 +215,7 @@ class NvArray {
     this->gpu_ptr_ = rhs.gpu_ptr_;
     this->length_ = rhs.length_;
     this->count_ = rhs.count_;
+    this->shm_ = std::move(rhs.shm_);
     rhs.cpu_ptr_ = nullptr;
     rhs.gpu_ptr_ = nullptr;
     rhs.length_ = 0;
@@ -266,7 +316,7 @@ class NvArray {
   }
 
   void Free(T *&ptr) {
-    if (gpu_ptr_ == nullptr && ptr != nullptr && count_.UseCount() == 1) {
+    if (gpu_ptr_ == nullptr && !shm_.valid() && ptr != nullptr && count_.UseCount() == 1) {
       delete [] ptr;
       ptr = nullptr;
     }
@@ -276,6 +326,8 @@ class NvArray {
   T *gpu_ptr_{nullptr};
   std::size_t length_;
   RefCount<std::uint8_t> count_{};
+  // Owns cpu_ptr_ in shared memory mode, reference counted across processes.
+  SharedMemorySegment shm_{};
   // std::mutex allocate_lock_;
 };
 
@@ -369,7 +369,7 @@ struct OptionalBase<Tp, false, true> : OptionalBaseImpl<Tp, OptionalBase<Tp>> {
 
   // Copy and move constructors.
   constexpr OptionalBase(const OptionalBase& other) :
-      _payload(other._payload.engaged, other._payload) {}
+      _payload(other._payload._engaged, other._payload) {}
 
   constexpr OptionalBase(OptionalBase&& other) = default;
 
@@ -407,7 +407,7 @@ struct OptionalBase<Tp, true, false> : OptionalBaseImpl<Tp, OptionalBase<Tp>> {
 
   constexpr OptionalBase(OptionalBase&& other) noexcept(
       std::is_nothrow_move_constructible<Tp>::value) :
-      _payload(other._payload.engaged, std::move(other._payload)) {}
+      _payload(other._payload._engaged, std::move(other._payload)) {}
 
   // Assignment operators.
   OptionalBase& operator=(const OptionalBase&) = default;
@@ -78,29 +78,32 @@ public:
   /// @uptrace{SWS_CORE_00712}
   using error_type = E;
 
+  // The special members are defaulted so that they are trivial whenever
+  // those of Optional<T> and Optional<E> are, i.e. a Result of trivially
+  // copyable T and E is itself trivially copyable. They are deleted along
+  // with those of T or E.
+
   /// @uptrace{SWS_CORE_00725}
-  Result(const Result& other) :
-      mData(other.mData), mError(other.mError) {}
+  Result(const Result& other) = default;
 
   /// @uptrace{SWS_CORE_00726}
-  Result(Result&& other) :
-      mData(std::move(other.mData)), mError(std::move(other.mError)) {}
+  Result(Result&& other) = default;
 
   /// @uptrace{SWS_CORE_00721}
-  Result(const T& t) : mData(t), mError(nullopt) {}
+  constexpr Result(const T& t) : mData(t), mError(nullopt) {}
 
   /// @uptrace{SWS_CORE_00722}
-  Result(T&& t) : mData(std::move(t)), mError(nullopt) {}
+  constexpr Result(T&& t) : mData(std::move(t)), mError(nullopt) {}
 
   /// @uptrace{SWS_CORE_00723}
-  explicit Result(const E& e) :mData(nullopt), mError(e) {}
+  constexpr explicit Result(const E& e) : mData(nullopt), mError(e) {}
   // explicit Result(const E& e) : mData(e) {}
 
   /// @uptrace{SWS_CORE_00724}
   // explicit Result(E&& e) noexcept(
   //    std::is_nothrow_move_constructible<T>::value&&
   //    std::is_nothrow_move_constructible<E>::value) : mData(std::move(e)) {}
-  explicit Result(E&& e) noexcept(
+  constexpr explicit Result(E&& e) noexcept(
       std::is_nothrow_move_constructible<T>::value&&
           std::is_nothrow_move_constructible<E>::value) :
       mData(nullopt),
@@ -111,10 +114,10 @@ public:
   ~Result() = default;
 
   /// @uptrace{SWS_CORE_00731}
-  static Result FromValue(const T& t) { return Result(t); }
+  static constexpr Result FromValue(const T& t) { return Result(t); }
 
   /// @uptrace{SWS_CORE_00732}
-  static Result FromValue(T&& t) { return Result(std::move(t)); }
+  static constexpr Result FromValue(T&& t) { return Result(std::move(t)); }
 
   /// @uptrace{SWS_CORE_00733}
   template <
@@ -127,10 +130,10 @@ public:
   }
 
   /// @uptrace{SWS_CORE_00734}
-  static Result FromError(const E& e) { return Result(e); }
+  static constexpr Result FromError(const E& e) { return Result(e); }
 
   /// @uptrace{SWS_CORE_00735}
-  static Result FromError(E&& e) { return Result(std::move(e)); }
+  static constexpr Result FromError(E&& e) { return Result(std::move(e)); }
 
   /// @uptrace{SWS_CORE_00736}
   template <
@@ -143,22 +146,10 @@ public:
   }
 
   /// @uptrace{SWS_CORE_00741}
-  Result& operator=(const Result& other) & {
-    mData = other.mData;
-    mError = other.mError;
-    return *this;
-  }
+  Result& operator=(const Result& other) & = default;
 
   /// @uptrace{SWS_CORE_00742}
-  Result& operator=(Result&& other) & noexcept(
-      std::is_nothrow_move_constructible<T>::value&&
-          std::is_nothrow_move_assignable<T>::value&&
-              std::is_nothrow_move_constructible<E>::value&&
-                  std::is_nothrow_move_assignable<E>::value) {
-    mData = std::move(other.mData);
-    mError = std::move(other.mError);
-    return *this;
-  }
+  Result& operator=(Result&& other) & = default;
   // ----------------------------------------
 
   /// @uptrace{SWS_CORE_00743}
@@ -191,21 +182,21 @@ public:
   }
 
   /// @uptrace{SWS_CORE_00752}
-  explicit operator bool() const noexcept { return HasValue(); }
+  constexpr explicit operator bool() const noexcept { return HasValue(); }
 
   /// @uptrace{SWS_CORE_00751}
   // bool HasValue() const noexcept { return mData.which() == 0; }
-  bool HasValue() const noexcept { return mData.has_value(); }
+  constexpr bool HasValue() const noexcept { return mData.has_value(); }
 
   /// @uptrace{SWS_CORE_00753}
-  const T& operator*() const& {
+  constexpr const T& operator*() const& {
     // const T* ptr = boost::get<T>(&mData);
     // if (ptr != nullptr) { return *ptr; }
     // std::abort();
     return *mData;
   }
 
-  T&& operator*() && {
+  constexpr T&& operator*() && {
     // T* ptr = boost::get<T>(&mData);
     // if (ptr != nullptr) { return std::move(*ptr); }
     // std::abort();
@@ -216,7 +207,7 @@ public:
   const T* operator->() const { return std::addressof(Value()); }
 
   /// @uptrace{SWS_CORE_00755}
-  const T& Value() const& {
+  constexpr const T& Value() const& {
     // const T* ptr = boost::get<T>(&mData);
     // if (ptr != nullptr) { return *ptr; }
     // std::abort();
@@ -225,7 +216,7 @@ public:
   }
 
   /// @uptrace{SWS_CORE_00756}
-  T&& Value() && {
+  constexpr T&& Value() && {
     // T* ptr = boost::get<T>(&mData);
     // if (ptr != nullptr) { return std::move(*ptr); }
     // std::abort();
@@ -234,7 +225,7 @@ public:
   }
 
   /// @uptrace{SWS_CORE_00757}
-  const E& Error() const& {
+  constexpr const E& Error() const& {
     // const E* ptr = boost::get<E>(&mData);
     // if (ptr != nullptr) { return *ptr; }
     // std::abort();
@@ -243,7 +234,7 @@ public:
   }
 
   /// @uptrace{SWS_CORE_00758}
-  E&& Error() && {
+  constexpr E&& Error() && {
     // E* ptr = boost::get<E>(&mData);
     // if (ptr != nullptr) { return std::move(*ptr); }
     // std::abort();
@@ -448,33 +439,35 @@ public:
 
   /// @uptrace{SWS_CORE_00821}
   // Result() noexcept : mData(T {}) {}
-  Result() noexcept : mError(nullopt) {}
+  constexpr Result() noexcept : mError(nullopt) {}
 
   /// @uptrace{SWS_CORE_00823}
   // explicit Result(const E& e) : mData(e) {}
-  explicit Result(const E& e) : mError(e) {}
+  constexpr explicit Result(const E& e) : mError(e) {}
 
   /// @uptrace{SWS_CORE_00824}
   // explicit Result(E&& e) : mData(std::move(e)) {}
-  explicit Result(E&& e) : mError(std::move(e)) {}
+  constexpr explicit Result(E&& e) : mError(std::move(e)) {}
+
+  // Defaulted, and so trivial for a trivially copyable E, see Result<T, E>.
 
   /// @uptrace{SWS_CORE_00825}
-  Result(const Result& other) : mError(other.mError) {}
+  Result(const Result& other) = default;
 
   /// @uptrace{SWS_CORE_00826}
-  Result(Result&& other) noexcept : mError(std::move(other.mError)) {}
+  Result(Result&& other) = default;
 
   /// @uptrace{SWS_CORE_00827}
   ~Result() = default;
 
   /// @uptrace{SWS_CORE_00831}
-  static Result FromValue() { return Result(); }
+  static constexpr Result FromValue() { return Result(); }
 
   /// @uptrace{SWS_CORE_00834}
-  static Result FromError(const E& e) { return Result(e); }
+  static constexpr Result FromError(const E& e) { return Result(e); }
 
   /// @uptrace{SWS_CORE_00835}
-  static Result FromError(E&& e) { return Result(std::move(e)); }
+  static constexpr Result FromError(E&& e) { return Result(std::move(e)); }
 
   /// @uptrace{SWS_CORE_00836}
   template <
@@ -487,20 +480,10 @@ public:
   }
 
   /// @uptrace{SWS_CORE_00841}
-  Result& operator=(const Result& other) & {
-    // mData = other.mData;
-    mError = other.mError;
-    return *this;
-  }
+  Result& operator=(const Result& other) & = default;
 
   /// @uptrace{SWS_CORE_00842}
-  Result& operator=(Result&& other) & noexcept(
-      std::is_nothrow_move_constructible<E>::value&&
-          std::is_nothrow_move_assignable<E>::value) {
-    // mData = std::move(other.mData);
-    mError = std::move(other.mError);
-    return *this;
-  }
+  Result& operator=(Result&& other) & = default;
 
   /// @uptrace{SWS_CORE_00843}
   template <typename... Args>
@@ -527,11 +510,11 @@ public:
   }
 
   /// @uptrace{SWS_CORE_00852}
-  explicit operator bool() const noexcept { return HasValue(); }
+  constexpr explicit operator bool() const noexcept { return HasValue(); }
 
   /// @uptrace{SWS_CORE_00851}
   // bool HasValue() const noexcept { return mData.which() == 0; }
-  bool HasValue() const noexcept { return !mError.has_value(); }
+  constexpr bool HasValue() const noexcept { return !mError.has_value(); }
 
   /// @uptrace{SWS_CORE_00855}
   void Value() const {
@@ -545,7 +528,7 @@ public:
   }
 
   /// @uptrace{SWS_CORE_00857}
-  const E& Error() const& {
+  constexpr const E& Error() const& {
     return *mError;
     // const E* ptr = boost::get<E>(&mData);
     // if (ptr != nullptr) { return *ptr; }
@@ -554,7 +537,7 @@ public:
   }
 
   /// @uptrace{SWS_CORE_00858}
-  E&& Error() && {
+  constexpr E&& Error() && {
     return std::move(*mError);
     // E* ptr = boost::get<E>(&mData);
     // if (ptr != nullptr) { return std::move(*ptr); }
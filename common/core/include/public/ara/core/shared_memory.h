@@ -0,0 +1,248 @@
+/**
+ * @file
+ * @brief Interface to class ara::core::SharedMemorySegment
+ *
+ * A SharedMemorySegment is a named POSIX shared memory object mapped into
+ * the calling process. The reference count lives in the segment itself, so
+ * handles in different processes keep the pages alive together and the last
+ * one to go removes the name.
+ *
+ * To hand a segment to another process, call Share() and send the returned
+ * SharedMemoryDescriptor, e.g. as the payload of an ara::ipc message. The
+ * descriptor carries one reference that SharedMemorySegment::Open() adopts,
+ * so the segment survives even if the sender drops its handle before the
+ * receiver opens it. A descriptor that is never opened leaks its segment
+ * until the name is unlinked by hand (see /dev/shm).
+ */
+
+#ifndef TUSIMPLEAP_ARA_CORE_SHARED_MEMORY_H_
+#define TUSIMPLEAP_ARA_CORE_SHARED_MEMORY_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "ara/core/core_error_domain.h"
+#include "ara/core/result.h"
+#include "ara/core/string_view.h"
+
+namespace ara {
+namespace core {
+
+/**
+ * @brief Fixed-size, trivially copyable reference to a shared memory
+ * segment, suitable to be sent as raw bytes to another process.
+ */
+struct SharedMemoryDescriptor {
+  static constexpr std::size_t kMaxNameLength = 63U;
+
+  char name[kMaxNameLength + 1U];  ///< NUL terminated, starts with '/'
+  std::uint64_t size;              ///< usable bytes behind the segment header
+};
+
+static_assert(std::is_trivially_copyable<SharedMemoryDescriptor>::value,
+              "SharedMemoryDescriptor is sent as raw bytes");
+
+namespace internal {
+
+// Placed at the start of every segment, the user data follows at
+// kSharedMemoryDataOffset so it is cache line aligned.
+struct SharedMemoryHeader {
+  static constexpr std::uint32_t kMagic = 0x41524153U;  // "ARAS"
+
+  std::uint32_t magic;
+  std::atomic<std::uint32_t> references;
+  std::uint64_t size;
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "the reference count must work across processes");
+
+constexpr std::size_t kSharedMemoryDataOffset = 64U;
+
+static_assert(sizeof(SharedMemoryHeader) <= kSharedMemoryDataOffset, "header must fit in front of the data");
+
+}  // namespace internal
+
+/**
+ * @brief Handle to a reference counted, named shared memory segment
+ *
+ * Copies of a handle share the mapping of their process, the last one
+ * unmaps it. All handles to the same segment, in any process, see the same
+ * bytes.
+ */
+class SharedMemorySegment final {
+public:
+  SharedMemorySegment() noexcept = default;
+
+  /**
+   * @brief Create a new segment of @a size bytes, zero initialized.
+   *
+   * @param name  "/name" style identifier, at most
+   *              SharedMemoryDescriptor::kMaxNameLength characters
+   * @returns the segment, or CoreErrc::file_exists if @a name is taken,
+   *          CoreErrc::invalid_argument / filename_too_long for a bad name,
+   *          or the errno of the failed system call
+   */
+  static Result<SharedMemorySegment> Create(StringView name, std::size_t size) {
+    SharedMemoryDescriptor descriptor {};
+    if (name.empty() || name[0] != '/') {
+      return Result<SharedMemorySegment>::FromError(CoreErrc::invalid_argument);
+    }
+    if (name.size() > SharedMemoryDescriptor::kMaxNameLength) {
+      return Result<SharedMemorySegment>::FromError(CoreErrc::filename_too_long);
+    }
+    std::memcpy(descriptor.name, name.data(), name.size());
+    descriptor.size = size;
+
+    int fd = ::shm_open(descriptor.name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      return LastError();
+    }
+    const std::size_t length = internal::kSharedMemoryDataOffset + size;
+    if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+      int error = errno;
+      ::close(fd);
+      ::shm_unlink(descriptor.name);
+      return Result<SharedMemorySegment>::FromError(static_cast<CoreErrc>(error));
+    }
+    void* address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      int error = errno;
+      ::shm_unlink(descriptor.name);
+      return Result<SharedMemorySegment>::FromError(static_cast<CoreErrc>(error));
+    }
+
+    auto* header = new (address) internal::SharedMemoryHeader;
+    header->references.store(1U, std::memory_order_relaxed);
+    header->size = size;
+    // Publish the magic last, Open() refuses segments that are still being
+    // set up.
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = internal::SharedMemoryHeader::kMagic;
+    return SharedMemorySegment(header, descriptor);
+  }
+
+  /**
+   * @brief Map the segment described by @a descriptor, adopting the
+   * reference that Share() put into it.
+   *
+   * @returns the segment, or CoreErrc::invalid_argument if the segment is
+   *          not an ara::core segment or its size differs from the
+   *          descriptor
+   */
+  static Result<SharedMemorySegment> Open(const SharedMemoryDescriptor& descriptor) {
+    SharedMemoryDescriptor local = descriptor;
+    local.name[SharedMemoryDescriptor::kMaxNameLength] = '\0';
+
+    int fd = ::shm_open(local.name, O_RDWR, 0);
+    if (fd < 0) {
+      return LastError();
+    }
+    const std::size_t length = internal::kSharedMemoryDataOffset + static_cast<std::size_t>(local.size);
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) != length) {
+      ::close(fd);
+      return Result<SharedMemorySegment>::FromError(CoreErrc::invalid_argument);
+    }
+    void* address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      return LastError();
+    }
+
+    auto* header = static_cast<internal::SharedMemoryHeader*>(address);
+    if (header->magic != internal::SharedMemoryHeader::kMagic || header->size != local.size) {
+      ::munmap(address, length);
+      return Result<SharedMemorySegment>::FromError(CoreErrc::invalid_argument);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return SharedMemorySegment(header, local);
+  }
+
+  /**
+   * @brief Add a reference on behalf of a receiver and describe the segment.
+   *
+   * Every descriptor returned here must be passed to Open() exactly once.
+   */
+  SharedMemoryDescriptor Share() const noexcept {
+    mapping_->header->references.fetch_add(1U, std::memory_order_relaxed);
+    return mapping_->descriptor;
+  }
+
+  /**
+   * @brief Drop this handle. The last handle of a process unmaps the
+   * segment.
+   */
+  void Reset() noexcept { mapping_.reset(); }
+
+  void swap(SharedMemorySegment& other) noexcept { mapping_.swap(other.mapping_); }
+
+  bool valid() const noexcept { return mapping_ != nullptr; }
+
+  void* data() noexcept { return mapping_ == nullptr ? nullptr : mapping_->data(); }
+
+  const void* data() const noexcept { return mapping_ == nullptr ? nullptr : mapping_->data(); }
+
+  std::size_t size() const noexcept {
+    return mapping_ == nullptr ? 0U : static_cast<std::size_t>(mapping_->descriptor.size);
+  }
+
+  StringView name() const noexcept { return mapping_ == nullptr ? StringView() : StringView(mapping_->descriptor.name); }
+
+  /**
+   * @brief Mappings and unopened descriptors of the segment in all
+   * processes. Copies of a handle share one mapping.
+   */
+  std::uint32_t UseCount() const noexcept {
+    return mapping_ == nullptr ? 0U : mapping_->header->references.load(std::memory_order_relaxed);
+  }
+
+private:
+  // One per process and segment, owns one reference in the segment.
+  struct Mapping {
+    Mapping(internal::SharedMemoryHeader* h, const SharedMemoryDescriptor& d) noexcept : header(h), descriptor(d) {}
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    ~Mapping() {
+      if (header->references.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+        ::shm_unlink(descriptor.name);
+      }
+      ::munmap(header, internal::kSharedMemoryDataOffset + static_cast<std::size_t>(descriptor.size));
+    }
+
+    char* data() const noexcept { return reinterpret_cast<char*>(header) + internal::kSharedMemoryDataOffset; }
+
+    internal::SharedMemoryHeader* header;
+    SharedMemoryDescriptor descriptor;
+  };
+
+  SharedMemorySegment(internal::SharedMemoryHeader* header, const SharedMemoryDescriptor& descriptor) :
+      mapping_(std::make_shared<Mapping>(header, descriptor)) {}
+
+  static Result<SharedMemorySegment> LastError() {
+    return Result<SharedMemorySegment>::FromError(static_cast<CoreErrc>(errno));
+  }
+
+  std::shared_ptr<Mapping> mapping_;
+};
+
+inline void swap(SharedMemorySegment& lhs, SharedMemorySegment& rhs) noexcept { lhs.swap(rhs); }
+
+}  // namespace core
+}  // namespace ara
+
+#endif  // TUSIMPLEAP_ARA_CORE_SHARED_MEMORY_H_
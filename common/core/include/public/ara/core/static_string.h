@@ -0,0 +1,362 @@
+/**
+ * @file
+ * @brief Interface to class ara::core::StaticString
+ *
+ * ara::core::StaticString is a string with a capacity fixed at compile time
+ * whose characters are stored inline, so creating, copying and appending
+ * never touches the heap. It is meant for short strings of known maximum
+ * length that are built on hot paths, e.g. DLT context IDs, unix domain
+ * socket paths, interface names or formatted timestamps.
+ */
+
+#ifndef TUSIMPLEAP_ARA_CORE_STATIC_STRING_H_
+#define TUSIMPLEAP_ARA_CORE_STATIC_STRING_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "ara/core/string_view.h"
+
+namespace ara {
+namespace core {
+
+/**
+ * @brief Inline string of at most N characters.
+ *
+ * The interface follows BasicString and StringView. The difference is how
+ * overflow is handled: operations that would grow the string beyond N
+ * characters store as much as fits, never throw and set truncated(), which
+ * stays set until the content is replaced by assign(), shrinks or is
+ * resized to a length that fits. Callers
+ * for which a cut string is an error check truncated() once after building
+ * the string. Only at() and substr() throw std::out_of_range, like
+ * StringView.
+ *
+ * The buffer is always NUL terminated, so c_str() is free. The type is
+ * trivially copyable.
+ *
+ * @tparam CharT character type
+ * @tparam N maximal number of characters, not counting the terminator
+ * @tparam Traits character traits
+ */
+template <typename CharT, std::size_t N, typename Traits = std::char_traits<CharT>>
+class BasicStaticString final {
+public:
+  using traits_type = Traits;
+  using value_type = CharT;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using view_type = internal::basic_string_view<CharT, Traits>;
+
+  static constexpr size_type npos = view_type::npos;
+
+  BasicStaticString() noexcept { data_[0] = CharT(); }
+
+  BasicStaticString(const_pointer s) noexcept : BasicStaticString() { append(s); }
+
+  BasicStaticString(const_pointer s, size_type count) noexcept : BasicStaticString() { append(s, count); }
+
+  BasicStaticString(size_type count, CharT ch) noexcept : BasicStaticString() { append(count, ch); }
+
+  explicit BasicStaticString(view_type sv) noexcept : BasicStaticString() { append(sv); }
+
+  template <std::size_t M>
+  BasicStaticString(const BasicStaticString<CharT, M, Traits>& other) noexcept : BasicStaticString() {
+    append(other.data(), other.size());
+    truncated_ = truncated_ || other.truncated();
+  }
+
+  BasicStaticString(const BasicStaticString&) noexcept = default;
+  BasicStaticString& operator=(const BasicStaticString&) noexcept = default;
+  ~BasicStaticString() = default;
+
+  BasicStaticString& operator=(const_pointer s) noexcept { return assign(s); }
+
+  BasicStaticString& operator=(view_type sv) noexcept { return assign(sv); }
+
+  BasicStaticString& operator=(CharT ch) noexcept { return assign(1U, ch); }
+
+  BasicStaticString& assign(view_type sv) noexcept {
+    clear();
+    return append(sv);
+  }
+
+  BasicStaticString& assign(const_pointer s, size_type count) noexcept { return assign(view_type(s, count)); }
+
+  BasicStaticString& assign(const_pointer s) noexcept { return assign(view_type(s)); }
+
+  BasicStaticString& assign(size_type count, CharT ch) noexcept {
+    clear();
+    return append(count, ch);
+  }
+
+  // element access
+
+  reference at(size_type pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("ara::core::StaticString::at");
+    }
+    return data_[pos];
+  }
+
+  const_reference at(size_type pos) const {
+    if (pos >= size_) {
+      throw std::out_of_range("ara::core::StaticString::at");
+    }
+    return data_[pos];
+  }
+
+  reference operator[](size_type pos) noexcept { return data_[pos]; }
+  const_reference operator[](size_type pos) const noexcept { return data_[pos]; }
+
+  reference front() noexcept { return data_[0]; }
+  const_reference front() const noexcept { return data_[0]; }
+
+  reference back() noexcept { return data_[size_ - 1]; }
+  const_reference back() const noexcept { return data_[size_ - 1]; }
+
+  pointer data() noexcept { return data_; }
+  const_pointer data() const noexcept { return data_; }
+  const_pointer c_str() const noexcept { return data_; }
+
+  operator view_type() const noexcept { return view_type(data_, size_); }
+
+  /**
+   * @brief Copy into a heap allocated string, e.g. for an API taking String.
+   */
+  std::basic_string<CharT, Traits> ToString() const { return std::basic_string<CharT, Traits>(data_, size_); }
+
+  // iterators
+
+  iterator begin() noexcept { return data_; }
+  const_iterator begin() const noexcept { return data_; }
+  const_iterator cbegin() const noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+  const_iterator cend() const noexcept { return data_ + size_; }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+  const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+  // capacity
+
+  bool empty() const noexcept { return size_ == 0U; }
+  bool full() const noexcept { return size_ == N; }
+  size_type size() const noexcept { return size_; }
+  size_type length() const noexcept { return size_; }
+  static constexpr size_type capacity() noexcept { return N; }
+  static constexpr size_type max_size() noexcept { return N; }
+
+  /**
+   * @brief Whether characters were dropped since the last assign(), or since the content last
+   * shrank or was resized to a length that fits.
+   */
+  bool truncated() const noexcept { return truncated_; }
+
+  // modifiers
+
+  void clear() noexcept {
+    size_ = 0U;
+    truncated_ = false;
+    data_[0] = CharT();
+  }
+
+  void push_back(CharT ch) noexcept { append(1U, ch); }
+
+  void pop_back() noexcept {
+    data_[--size_] = CharT();
+    truncated_ = false;
+  }
+
+  BasicStaticString& append(view_type sv) noexcept { return append(sv.data(), sv.size()); }
+
+  BasicStaticString& append(const_pointer s) noexcept { return append(view_type(s)); }
+
+  BasicStaticString& append(const_pointer s, size_type count) noexcept {
+    const size_type n = Fit(count);
+    Traits::copy(data_ + size_, s, n);
+    return Grow(n);
+  }
+
+  BasicStaticString& append(size_type count, CharT ch) noexcept {
+    const size_type n = Fit(count);
+    Traits::assign(data_ + size_, n, ch);
+    return Grow(n);
+  }
+
+  BasicStaticString& operator+=(view_type sv) noexcept { return append(sv); }
+  BasicStaticString& operator+=(const_pointer s) noexcept { return append(s); }
+  BasicStaticString& operator+=(CharT ch) noexcept { return append(1U, ch); }
+
+  void resize(size_type count) noexcept { resize(count, CharT()); }
+
+  void resize(size_type count, CharT ch) noexcept {
+    if (count <= N) {
+      truncated_ = false;
+    }
+    if (count <= size_) {
+      size_ = count;
+      data_[size_] = CharT();
+    } else {
+      append(count - size_, ch);
+    }
+  }
+
+  /**
+   * @brief Let @a op write the content directly into the buffer.
+   *
+   * Same as the C++23 std::basic_string member. @a op is called with the
+   * buffer and a length clamped to capacity(); it may write that many
+   * characters plus a terminator, e.g. through snprintf() or strftime(), and
+   * returns the resulting length. A length beyond that, like the one
+   * snprintf() would have written, sets truncated().
+   */
+  template <typename Operation>
+  void resize_and_overwrite(size_type count, Operation op) {
+    truncated_ = count > N;
+    if (truncated_) {
+      count = N;
+    }
+    const size_type written = static_cast<size_type>(op(data_, count));
+    if (written > count) {
+      truncated_ = true;
+    }
+    size_ = std::min(written, count);
+    data_[size_] = CharT();
+  }
+
+  BasicStaticString& erase(size_type pos = 0U, size_type count = npos) {
+    if (pos > size_) {
+      throw std::out_of_range("ara::core::StaticString::erase");
+    }
+    const size_type n = std::min(count, size_ - pos);
+    Traits::move(data_ + pos, data_ + pos + n, size_ - pos - n + 1U);
+    size_ -= n;
+    truncated_ = false;
+    return *this;
+  }
+
+  // operations, forwarded to StringView
+
+  BasicStaticString substr(size_type pos = 0U, size_type count = npos) const {
+    return BasicStaticString(view().substr(pos, count));
+  }
+
+  int compare(view_type sv) const noexcept { return view().compare(sv); }
+
+  size_type find(view_type sv, size_type pos = 0U) const noexcept { return view().find(sv, pos); }
+  size_type find(CharT ch, size_type pos = 0U) const noexcept { return view().find(ch, pos); }
+  size_type rfind(view_type sv, size_type pos = npos) const noexcept { return view().rfind(sv, pos); }
+  size_type rfind(CharT ch, size_type pos = npos) const noexcept { return view().rfind(ch, pos); }
+
+  size_type find_first_of(view_type sv, size_type pos = 0U) const noexcept { return view().find_first_of(sv, pos); }
+  size_type find_last_of(view_type sv, size_type pos = npos) const noexcept { return view().find_last_of(sv, pos); }
+
+  size_type find_first_not_of(view_type sv, size_type pos = 0U) const noexcept {
+    return view().find_first_not_of(sv, pos);
+  }
+
+  size_type find_last_not_of(view_type sv, size_type pos = npos) const noexcept {
+    return view().find_last_not_of(sv, pos);
+  }
+
+private:
+  view_type view() const noexcept { return view_type(data_, size_); }
+
+  size_type Fit(size_type count) noexcept {
+    if (count > N - size_) {
+      truncated_ = true;
+      return N - size_;
+    }
+    return count;
+  }
+
+  BasicStaticString& Grow(size_type n) noexcept {
+    size_ += n;
+    data_[size_] = CharT();
+    return *this;
+  }
+
+  CharT data_[N + 1];
+  size_type size_ = 0U;
+  bool truncated_ = false;
+};
+
+template <typename CharT, std::size_t N, typename Traits>
+constexpr typename BasicStaticString<CharT, N, Traits>::size_type BasicStaticString<CharT, N, Traits>::npos;
+
+/**
+ * @brief Inline string of at most N narrow characters.
+ */
+template <std::size_t N>
+using StaticString = BasicStaticString<char, N>;
+
+// Comparison between static strings of any capacity and with C strings.
+// Comparison with StringView is covered by the StringView operators.
+
+#define ARA_CORE_STATIC_STRING_COMPARE(op)                                                                      \
+  template <typename CharT, std::size_t N, std::size_t M, typename Traits>                                     \
+  bool operator op(const BasicStaticString<CharT, N, Traits>& lhs,                                              \
+                   const BasicStaticString<CharT, M, Traits>& rhs) noexcept {                                   \
+    return lhs.compare(rhs) op 0;                                                                               \
+  }                                                                                                             \
+  template <typename CharT, std::size_t N, typename Traits>                                                     \
+  bool operator op(const BasicStaticString<CharT, N, Traits>& lhs, const CharT* rhs) noexcept {                 \
+    return lhs.compare(rhs) op 0;                                                                               \
+  }                                                                                                             \
+  template <typename CharT, std::size_t N, typename Traits>                                                     \
+  bool operator op(const CharT* lhs, const BasicStaticString<CharT, N, Traits>& rhs) noexcept {                 \
+    return 0 op rhs.compare(lhs);                                                                               \
+  }
+
+ARA_CORE_STATIC_STRING_COMPARE(==)
+ARA_CORE_STATIC_STRING_COMPARE(!=)
+ARA_CORE_STATIC_STRING_COMPARE(<)
+ARA_CORE_STATIC_STRING_COMPARE(<=)
+ARA_CORE_STATIC_STRING_COMPARE(>)
+ARA_CORE_STATIC_STRING_COMPARE(>=)
+
+#undef ARA_CORE_STATIC_STRING_COMPARE
+
+template <typename CharT, std::size_t N, typename Traits>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os,
+                                              const BasicStaticString<CharT, N, Traits>& s) {
+  return os.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+}  // namespace core
+}  // namespace ara
+
+namespace std {
+
+/// @brief Specialization of std::hash for ara::core::StaticString, equal to
+/// the hash of the corresponding ara::core::StringView.
+template <std::size_t N>
+class hash<ara::core::StaticString<N>> final {
+public:
+  using result_type = std::size_t;
+
+  result_type operator()(const ara::core::StaticString<N>& s) const noexcept {
+    return hash<ara::core::StringView>()(s);
+  }
+};
+
+}  // namespace std
+
+#endif  // TUSIMPLEAP_ARA_CORE_STATIC_STRING_H_
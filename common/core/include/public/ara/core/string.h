@@ -12,6 +12,7 @@
 #include <string>
 #include <type_traits>
 
+#include "ara/core/memory_resource.h"
 #include "ara/core/string_view.h"
 
 namespace ara {
@@ -278,6 +279,15 @@ public:
  */
 using String = BasicString<>;
 
+namespace pmr {
+
+/**
+ * @brief String whose memory comes from a memory_resource
+ */
+using String = BasicString<polymorphic_allocator<char>>;
+
+}  // namespace pmr
+
 // Transitional compatibility name; should remove this before R18-10.
 /// @brief Add overload of std::swap for String.
 ///
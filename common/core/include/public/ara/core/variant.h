@@ -848,8 +848,14 @@ namespace core {
           : data_(in_place_index_t<I>{}, variant_forward<Args>(args)...),
             index_(I) {}
 
+      // With only trivially copyable alternatives emplace builds the new
+      // value before it destroys the old one, so the Variant can never become
+      // valueless and visit() and get() need no check for it.
+      static constexpr bool never_valueless =
+          variant_all<std::is_trivially_copyable<Ts>::value...>::value;
+
       inline constexpr bool valueless_by_exception() const noexcept {
-        return index_ == static_cast<index_t<Ts...>>(-1);
+        return !never_valueless && index_ == static_cast<index_t<Ts...>>(-1);
       }
 
       inline constexpr std::size_t index() const noexcept {
@@ -1081,6 +1087,18 @@ namespace core {
       inline /* auto & */ auto emplace(Args &&... args)
           -> decltype(this->construct_alt(access::base::get_alt<I>(*this),
                                           variant_forward<Args>(args)...)) {
+        using T = typename variant_decay_t<decltype(
+            access::base::get_alt<I>(*this))>::value_type;
+        return emplace_impl<I, T>(
+            variant_bool_constant<
+                super::never_valueless &&
+                !std::is_nothrow_constructible<T, Args...>::value>{},
+            variant_forward<Args>(args)...);
+      }
+
+      protected:
+      template <std::size_t I, typename T, typename... Args>
+      inline T &emplace_impl(std::false_type, Args &&... args) {
         this->destroy();
         auto &result = this->construct_alt(access::base::get_alt<I>(*this),
                                            variant_forward<Args>(args)...);
@@ -1088,7 +1106,13 @@ namespace core {
         return result;
       }
 
-      protected:
+      // A throwing constructor leaves the old value in place.
+      template <std::size_t I, typename T, typename... Args>
+      inline T &emplace_impl(std::true_type, Args &&... args) {
+        T tmp(variant_forward<Args>(args)...);
+        return emplace_impl<I, T>(std::false_type{}, variant_move(tmp));
+      }
+
 #ifndef ARA_CORE_GENERIC_LAMBDAS
       template <typename That>
       struct assigner {
@@ -12,6 +12,8 @@
 #include <type_traits>
 #include <vector>
 
+#include "ara/core/memory_resource.h"
+
 namespace ara {
 namespace core {
 
@@ -133,6 +135,18 @@ void swap(Vector<T, Allocator>& lhs, Vector<T, Allocator>& rhs) {
   lhs.swap(rhs);
 }
 
+namespace pmr {
+
+/**
+ * @brief Vector whose memory comes from a memory_resource
+ *
+ * @tparam T  the type of contained values
+ */
+template <typename T>
+using Vector = core::Vector<T, polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace core
 }  // namespace ara
 
@@ -1,8 +1,14 @@
 #include "ara/core/optional.h"
 #include "ara/core/array.h"
 #include "ara/core/map.h"
+#include "ara/core/flat_map.h"
+#include "ara/core/flat_set.h"
 #include "ara/core/vector.h"
+#include "ara/core/memory_resource.h"
+#include "ara/core/nv_array.h"
+#include "ara/core/shared_memory.h"
 #include "ara/core/string.h"
+#include "ara/core/static_string.h"
 #include "ara/core/error_code.h"
 #include "ara/core/error_domain.h"
 #include "ara/core/string_view.h"
@@ -10,10 +16,14 @@
 #include "ara/core/result.h"
 #include "ara/core/core_error_domain.h"
 #include "ara/core/future_error_domain.h"
+#include "ara/core/executor.h"
 #include "ara/core/future.h"
+#include "ara/core/coroutine.h"
 #include "ara/core/promise.h"
 #include "ara/core/utility.h"
 #include "ara/core/span.h"
+#include "ara/core/bytes.h"
 #include "ara/core/functional.h"
 #include "ara/core/initialization.h"
 #include "ara/core/variant.h"
+#include "ara/core/futex_condition_variable.h"
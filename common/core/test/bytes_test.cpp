@@ -0,0 +1,136 @@
+/**
+ * @file
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include "ara/core/bytes.h"
+#include "ara/core/string.h"
+#include "ara/core/vector.h"
+
+using namespace ara::core;
+
+namespace {
+
+Span<const Byte> AsBytes(const char* text) { return Span<const Byte>(text, std::strlen(text)); }
+
+Vector<Byte> RandomBytes(std::size_t size) {
+  std::mt19937 random(static_cast<std::uint32_t>(size));
+  Vector<Byte> data(size);
+  for (auto& b : data) {
+    b = static_cast<Byte>(random());
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(BytesTest, Crc32c) {
+  EXPECT_EQ(bytes::Crc32c(Span<const Byte>()), 0U);
+  EXPECT_EQ(bytes::Crc32c(AsBytes("123456789")), 0xe3069283U);
+  EXPECT_EQ(bytes::Crc32c(AsBytes("The quick brown fox jumps over the lazy dog")), 0x22620404U);
+
+  // Chained over several buffers.
+  std::uint32_t crc = bytes::Crc32c(AsBytes("12345"));
+  EXPECT_EQ(bytes::Crc32c(AsBytes("6789"), crc), 0xe3069283U);
+}
+
+TEST(BytesTest, Crc32cKernelsAgree) {
+  for (std::size_t size : {0U, 1U, 7U, 8U, 9U, 63U, 64U, 1000U}) {
+    auto data = RandomBytes(size);
+    const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+    const std::uint32_t expected = bytes::internal::Crc32cScalar(~0U, p, size);
+    EXPECT_EQ(bytes::internal::SelectCrc32c()(~0U, p, size), expected) << size;
+    EXPECT_EQ(bytes::Crc32c(Span<const Byte>(data.data(), data.size())), ~expected) << size;
+  }
+}
+
+TEST(BytesTest, HexEncode) {
+  const char data[] = {'\x00', '\x01', '\x7f', '\x80', '\xab', '\xff'};
+  EXPECT_EQ(bytes::HexEncode(data), "00017f80abff");
+  EXPECT_EQ(bytes::HexEncode(data, bytes::HexCase::kUpper), "00017F80ABFF");
+  EXPECT_EQ(bytes::HexEncode(Span<const Byte>()), "");
+
+  char out[12];
+  EXPECT_EQ(bytes::HexEncode(data, Span<char>(out, 11U)), 0U);  // too small
+  EXPECT_EQ(bytes::HexEncode(data, out), 12U);
+  EXPECT_EQ(String(out, 12U), "00017f80abff");
+}
+
+TEST(BytesTest, HexKernelsAgree) {
+  for (std::size_t size : {1U, 15U, 16U, 17U, 31U, 32U, 33U, 100U, 257U}) {
+    auto data = RandomBytes(size);
+    String expected(2U * size, '\0');
+    const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+    bytes::internal::HexEncodeScalar(p, size, &expected[0], bytes::internal::kHexLower);
+    EXPECT_EQ(bytes::HexEncode(Span<const Byte>(data.data(), data.size())), expected) << size;
+#if defined(__x86_64__)
+    String simd(2U * size, '\0');
+    std::size_t done = bytes::internal::HexEncodeSsse3(p, size, &simd[0], bytes::internal::kHexLower);
+    EXPECT_EQ(done, size / 16U * 16U);
+    EXPECT_EQ(simd.substr(0U, 2U * done), expected.substr(0U, 2U * done)) << size;
+#endif
+  }
+}
+
+TEST(BytesTest, Base64Encode) {
+  // RFC 4648 test vectors
+  EXPECT_EQ(bytes::Base64Encode(AsBytes("")), "");
+  EXPECT_EQ(bytes::Base64Encode(AsBytes("f")), "Zg==");
+  EXPECT_EQ(bytes::Base64Encode(AsBytes("fo")), "Zm8=");
+  EXPECT_EQ(bytes::Base64Encode(AsBytes("foo")), "Zm9v");
+  EXPECT_EQ(bytes::Base64Encode(AsBytes("foob")), "Zm9vYg==");
+  EXPECT_EQ(bytes::Base64Encode(AsBytes("fooba")), "Zm9vYmE=");
+  EXPECT_EQ(bytes::Base64Encode(AsBytes("foobar")), "Zm9vYmFy");
+
+  const char binary[] = {'\xfb', '\xff', '\x00'};
+  EXPECT_EQ(bytes::Base64Encode(binary), "+/8A");
+
+  char out[8];
+  EXPECT_EQ(bytes::Base64Encode(AsBytes("foob"), Span<char>(out, 7U)), 0U);
+  EXPECT_EQ(bytes::Base64Encode(AsBytes("foob"), out), 8U);
+}
+
+TEST(BytesTest, Find) {
+  EXPECT_EQ(bytes::Find(AsBytes("key=value\n"), '='), 3U);
+  EXPECT_EQ(bytes::Find(AsBytes("key=value\n"), '\n'), 9U);
+  EXPECT_EQ(bytes::Find(AsBytes("key=value"), '\n'), bytes::npos);
+  EXPECT_EQ(bytes::Find(Span<const Byte>(), '\n'), bytes::npos);
+}
+
+TEST(BytesTest, LoadStore) {
+  char buffer[8] = {};
+  bytes::StoreBig<std::uint32_t>(buffer, 0x01020304U);
+  EXPECT_EQ(buffer[0], 1);
+  EXPECT_EQ(buffer[3], 4);
+  EXPECT_EQ(bytes::LoadBig<std::uint32_t>(buffer), 0x01020304U);
+  EXPECT_EQ(bytes::LoadLittle<std::uint32_t>(buffer), 0x04030201U);
+
+  bytes::StoreLittle<std::uint16_t>(buffer, 0x0102U);
+  EXPECT_EQ(buffer[0], 2);
+  EXPECT_EQ(buffer[1], 1);
+
+  bytes::StoreBig<std::int64_t>(buffer, -2);
+  EXPECT_EQ(bytes::LoadBig<std::int64_t>(buffer), -2);
+  EXPECT_EQ(buffer[7], '\xfe');
+
+  bytes::Store<std::uint64_t>(buffer, 0x1122334455667788U);
+  EXPECT_EQ(bytes::Load<std::uint64_t>(buffer), 0x1122334455667788U);
+  std::uint64_t raw;
+  std::memcpy(&raw, buffer, sizeof(raw));
+  EXPECT_EQ(raw, 0x1122334455667788U);
+
+  // Unaligned access is fine.
+  char unaligned[9] = {};
+  bytes::StoreLittle<std::uint64_t>(Span<Byte>(unaligned + 1, 8U), 42U);
+  EXPECT_EQ(bytes::LoadLittle<std::uint64_t>(Span<const Byte>(unaligned + 1, 8U)), 42U);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
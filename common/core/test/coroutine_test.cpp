@@ -0,0 +1,119 @@
+/**
+ * @file
+ */
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "ara/core/coroutine.h"
+
+#ifdef ARA_CORE_HAS_COROUTINE
+
+using namespace ara::core;
+
+namespace {
+
+class QueueExecutor {
+public:
+  void AddExecute(std::function<void()> task) { tasks_.push_back(std::move(task)); }
+
+  std::size_t Run() {
+    std::size_t count = 0;
+    while (!tasks_.empty()) {
+      auto task = std::move(tasks_.front());
+      tasks_.pop_front();
+      task();
+      ++count;
+    }
+    return count;
+  }
+
+private:
+  std::deque<std::function<void()>> tasks_;
+};
+
+Task<int> AddOne(Future<int> f) {
+  auto r = co_await std::move(f);
+  if (!r) {
+    co_return r;
+  }
+  co_return Result<int>(*r + 1);
+}
+
+Task<void> Record(Future<std::string> f, std::string& out, std::thread::id& resumed_on) {
+  auto r = co_await std::move(f);
+  resumed_on = std::this_thread::get_id();
+  out = r.Value();
+}
+
+}  // namespace
+
+TEST(CoroutineTest, AwaitReadyFuture) {
+  Promise<int> p;
+  auto f = p.get_future();
+  p.set_value(1);
+  auto done = AddOne(std::move(f)).Start();
+  ASSERT_TRUE(done.is_ready());
+  ASSERT_EQ(done.GetResult(), 2);
+}
+
+TEST(CoroutineTest, AwaitPendingFuture) {
+  Promise<int> p;
+  auto done = AddOne(p.get_future()).Start();
+  ASSERT_FALSE(done.is_ready());
+  std::thread t([&p]() { p.set_value(41); });
+  t.join();
+  ASSERT_EQ(done.GetResult(), 42);
+}
+
+TEST(CoroutineTest, AwaitError) {
+  Promise<int> p;
+  auto done = AddOne(p.get_future()).Start();
+  p.SetError(ErrorCode(CoreErrc::no_such_file_or_directory));
+  ASSERT_EQ(done.GetResult().Error(), ErrorCode(CoreErrc::no_such_file_or_directory));
+}
+
+TEST(CoroutineTest, ResumeOnExecutor) {
+  QueueExecutor executor;
+  Promise<std::string> p;
+  std::string out;
+  std::thread::id resumed_on;
+  auto done = Record(p.get_future(), out, resumed_on).Start(executor);
+  ASSERT_EQ(executor.Run(), 1U);
+  ASSERT_FALSE(done.is_ready());
+
+  std::thread t([&p]() { p.set_value("abc"); });
+  t.join();
+  ASSERT_TRUE(out.empty());
+
+  ASSERT_EQ(executor.Run(), 1U);
+  ASSERT_EQ(out, "abc");
+  ASSERT_EQ(resumed_on, std::this_thread::get_id());
+  ASSERT_TRUE(done.GetResult());
+}
+
+TEST(CoroutineTest, ResumeOn) {
+  QueueExecutor executor;
+  int step = 0;
+  auto body = [](QueueExecutor& ex, int& s) -> Task<void> {
+    s = 1;
+    co_await ResumeOn(ex);
+    s = 2;
+  };
+  auto done = body(executor, step).Start();
+  ASSERT_EQ(step, 1);
+  executor.Run();
+  ASSERT_EQ(step, 2);
+  ASSERT_TRUE(done.GetResult());
+}
+
+#endif  // ARA_CORE_HAS_COROUTINE
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,236 @@
+/**
+ * @file
+ */
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "ara/core/flat_map.h"
+#include "ara/core/flat_set.h"
+#include "ara/core/map.h"
+#include "ara/core/string.h"
+#include "ara/core/string_view.h"
+
+using namespace ara::core;
+
+TEST(FlatMapTest, ConstructFromUnsortedRange) {
+  Vector<std::pair<int, String>> input {{3, "c"}, {1, "a"}, {2, "b"}, {1, "duplicate"}};
+  FlatMap<int, String> m(input.begin(), input.end());
+  ASSERT_EQ(m.size(), 3U);
+  auto it = m.begin();
+  EXPECT_EQ(it->first, 1);
+  EXPECT_EQ(it->second, "a");  // the first of equivalent keys wins
+  ++it;
+  EXPECT_EQ(it->first, 2);
+  ++it;
+  EXPECT_EQ(it->first, 3);
+
+  FlatMap<int, String> from_list {{5, "e"}, {4, "d"}};
+  EXPECT_EQ(from_list.begin()->first, 4);
+
+  FlatMap<int, String> from_container(std::move(input));
+  EXPECT_EQ(from_container, m);
+
+  FlatMap<int, int> sorted(sorted_unique, {{1, 1}, {2, 2}, {3, 3}});
+  EXPECT_EQ(sorted.size(), 3U);
+  EXPECT_EQ(sorted.at(2), 2);
+}
+
+TEST(FlatMapTest, Lookup) {
+  FlatMap<int, int> m {{10, 1}, {20, 2}, {30, 3}};
+  EXPECT_EQ(m.find(20)->second, 2);
+  EXPECT_EQ(m.find(25), m.end());
+  EXPECT_EQ(m.count(30), 1U);
+  EXPECT_EQ(m.count(31), 0U);
+  EXPECT_TRUE(m.contains(10));
+  EXPECT_FALSE(m.contains(0));
+  EXPECT_EQ(m.lower_bound(15)->first, 20);
+  EXPECT_EQ(m.upper_bound(20)->first, 30);
+  auto range = m.equal_range(20);
+  EXPECT_EQ(std::distance(range.first, range.second), 1);
+  range = m.equal_range(21);
+  EXPECT_EQ(range.first, range.second);
+
+  EXPECT_EQ(m.at(10), 1);
+  EXPECT_THROW(m.at(11), std::out_of_range);
+  const auto& cm = m;
+  EXPECT_EQ(cm.at(30), 3);
+  EXPECT_THROW(cm.at(31), std::out_of_range);
+}
+
+TEST(FlatMapTest, HeterogeneousLookup) {
+  FlatMap<String, int> m {{"beta", 2}, {"alpha", 1}, {"gamma", 3}};
+  StringView key("gamma");
+  EXPECT_EQ(m.find(key)->second, 3);
+  EXPECT_EQ(m.find("alpha")->second, 1);
+  EXPECT_EQ(m.at(StringView("beta")), 2);
+  EXPECT_TRUE(m.contains(StringView("alpha")));
+  EXPECT_FALSE(m.contains("delta"));
+  EXPECT_EQ(m.count("beta"), 1U);
+  EXPECT_EQ(m.lower_bound(StringView("b"))->first, "beta");
+
+  EXPECT_EQ(m.erase(StringView("beta")), 1U);
+  EXPECT_EQ(m.erase("beta"), 0U);
+  EXPECT_EQ(m.size(), 2U);
+
+  // A non-transparent comparator only accepts the key type.
+  FlatMap<int, int, std::less<int>> plain {{2, 2}, {1, 1}};
+  EXPECT_EQ(plain.begin()->first, 1);
+  EXPECT_TRUE(plain.contains(2));
+}
+
+TEST(FlatMapTest, Modifiers) {
+  FlatMap<String, int> m;
+  m["b"] = 2;
+  m["a"] = 1;
+  ++m["a"];
+  EXPECT_EQ(m.at("a"), 2);
+
+  auto result = m.insert({"c", 3});
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(result.first->second, 3);
+  result = m.insert({"c", 30});
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first->second, 3);
+
+  result = m.emplace("d", 4);
+  EXPECT_TRUE(result.second);
+  result = m.try_emplace("d", 40);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(m.at("d"), 4);
+
+  result = m.insert_or_assign("d", 44);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(m.at("d"), 44);
+  result = m.insert_or_assign("e", 5);
+  EXPECT_TRUE(result.second);
+
+  m.insert(m.begin(), {"f", 6});
+  EXPECT_EQ(m.size(), 6U);
+
+  m.erase(m.find("a"));
+  EXPECT_FALSE(m.contains("a"));
+  EXPECT_EQ(m.erase(String("b")), 1U);
+  m.erase(m.begin(), m.begin() + 2);
+  EXPECT_EQ(m.size(), 2U);
+  EXPECT_EQ(m.begin()->first, "e");
+
+  m.clear();
+  EXPECT_TRUE(m.empty());
+}
+
+TEST(FlatMapTest, RangeInsertMerges) {
+  FlatMap<int, int> m {{1, 1}, {3, 3}, {5, 5}};
+  Vector<std::pair<int, int>> more {{6, 6}, {2, 2}, {3, 30}, {4, 4}, {2, 20}};
+  m.insert(more.begin(), more.end());
+  ASSERT_EQ(m.size(), 6U);
+  int expected = 1;
+  for (const auto& kv : m) {
+    EXPECT_EQ(kv.first, expected);
+    EXPECT_EQ(kv.second, expected);  // existing and first-inserted values win
+    ++expected;
+  }
+
+  Vector<std::pair<int, int>> sorted {{0, 0}, {6, 60}, {7, 7}};
+  m.insert(sorted_unique, sorted.begin(), sorted.end());
+  EXPECT_EQ(m.size(), 8U);
+  EXPECT_EQ(m.at(6), 6);
+  EXPECT_EQ(m.begin()->first, 0);
+}
+
+TEST(FlatMapTest, ExtractAndReplace) {
+  FlatMap<int, int> m {{2, 2}, {1, 1}};
+  auto c = std::move(m).extract();
+  EXPECT_TRUE(m.empty());
+  ASSERT_EQ(c.size(), 2U);
+  EXPECT_EQ(c[0].first, 1);
+
+  c.emplace_back(3, 3);
+  m.replace(std::move(c));
+  EXPECT_EQ(m.size(), 3U);
+  EXPECT_EQ(m.container().back().first, 3);
+}
+
+TEST(FlatMapTest, Comparison) {
+  FlatMap<int, int> a {{1, 1}, {2, 2}};
+  FlatMap<int, int> b {{2, 2}, {1, 1}};
+  FlatMap<int, int> c {{1, 1}, {3, 3}};
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_LT(a, c);
+  EXPECT_GT(c, a);
+  EXPECT_LE(a, b);
+  EXPECT_GE(a, b);
+  swap(a, c);
+  EXPECT_EQ(a.at(3), 3);
+}
+
+TEST(FlatMapTest, MatchesMap) {
+  Map<int, int> reference;
+  FlatMap<int, int> flat;
+  unsigned value = 12345U;
+  for (int i = 0; i < 1000; ++i) {
+    value = value * 1103515245U + 12345U;
+    int key = static_cast<int>((value >> 16) % 500U);
+    reference.emplace(key, i);
+    flat.emplace(key, i);
+    if (i % 7 == 0) {
+      reference.erase(i % 500);
+      flat.erase(i % 500);
+    }
+  }
+  ASSERT_EQ(flat.size(), reference.size());
+  auto it = reference.begin();
+  for (const auto& kv : flat) {
+    EXPECT_EQ(kv.first, it->first);
+    EXPECT_EQ(kv.second, it->second);
+    ++it;
+  }
+}
+
+TEST(FlatSetTest, Basic) {
+  FlatSet<int> s {5, 1, 3, 1, 5};
+  ASSERT_EQ(s.size(), 3U);
+  EXPECT_EQ(*s.begin(), 1);
+  EXPECT_TRUE(s.contains(3));
+  EXPECT_FALSE(s.contains(2));
+  EXPECT_EQ(s.count(5), 1U);
+  EXPECT_EQ(*s.lower_bound(2), 3);
+  EXPECT_EQ(*s.upper_bound(3), 5);
+
+  EXPECT_TRUE(s.insert(2).second);
+  EXPECT_FALSE(s.insert(2).second);
+  EXPECT_TRUE(s.emplace(4).second);
+  s.insert({0, 6, 6});
+  EXPECT_EQ(s.size(), 7U);
+  int expected = 0;
+  for (int v : s) {
+    EXPECT_EQ(v, expected++);
+  }
+
+  EXPECT_EQ(s.erase(3), 1U);
+  EXPECT_EQ(s.erase(3), 0U);
+  s.erase(s.begin());
+  EXPECT_EQ(*s.begin(), 1);
+
+  FlatSet<int> same(sorted_unique, s.container());
+  EXPECT_EQ(same, s);
+}
+
+TEST(FlatSetTest, HeterogeneousLookup) {
+  FlatSet<String> s {"topic/b", "topic/a"};
+  EXPECT_TRUE(s.contains(StringView("topic/a")));
+  EXPECT_TRUE(s.contains("topic/b"));
+  EXPECT_FALSE(s.contains("topic"));
+  EXPECT_EQ(*s.find(StringView("topic/b")), "topic/b");
+  EXPECT_EQ(s.erase(StringView("topic/a")), 1U);
+  EXPECT_EQ(s.size(), 1U);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ara/core/futex_condition_variable.h"
+
+using namespace ara::core;
+using namespace std::literals::chrono_literals;
+
+TEST(FutexConditionVariableTest, NotifyOneWakesWaiter) {
+  std::mutex mutex;
+  FutexConditionVariable cv;
+  bool ready = false;
+
+  std::thread waiter([&]() {
+    std::unique_lock<std::mutex> lck(mutex);
+    cv.wait(lck, [&]() { return ready; });
+  });
+
+  std::this_thread::sleep_for(20ms);
+  {
+    std::lock_guard<std::mutex> lck(mutex);
+    ready = true;
+  }
+  cv.notify_one();
+  waiter.join();
+
+  EXPECT_EQ(cv.waiters_.load(), 0U);
+}
+
+TEST(FutexConditionVariableTest, NotifyAllWakesAllWaiters) {
+  std::mutex mutex;
+  FutexConditionVariable cv;
+  bool ready = false;
+  std::atomic<int> woken {0};
+
+  std::vector<std::thread> waiters;
+  for (int i = 0; i < 4; ++i) {
+    waiters.emplace_back([&]() {
+      std::unique_lock<std::mutex> lck(mutex);
+      cv.wait(lck, [&]() { return ready; });
+      ++woken;
+    });
+  }
+
+  std::this_thread::sleep_for(20ms);
+  {
+    std::lock_guard<std::mutex> lck(mutex);
+    ready = true;
+  }
+  cv.notify_all();
+  for (auto& t : waiters) {
+    t.join();
+  }
+
+  EXPECT_EQ(woken.load(), 4);
+}
+
+TEST(FutexConditionVariableTest, NotifyWithoutWaiterOnlyBumpsSequence) {
+  FutexConditionVariable cv;
+  cv.notify_one();
+  cv.notify_all();
+  EXPECT_EQ(cv.seq_.load(), 2U);
+  EXPECT_EQ(cv.waiters_.load(), 0U);
+}
+
+TEST(FutexConditionVariableTest, WaitForTimesOut) {
+  std::mutex mutex;
+  FutexConditionVariable cv;
+  std::unique_lock<std::mutex> lck(mutex);
+  static_assert(std::is_same<decltype(cv.wait_for(lck, 30ms)), std::cv_status>::value, "as std::condition_variable");
+  static_assert(std::is_same<decltype(cv.wait_until(lck, std::chrono::system_clock::now())), std::cv_status>::value,
+                "as std::condition_variable");
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(cv.wait_for(lck, 30ms), std::cv_status::timeout);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 30ms);
+  EXPECT_TRUE(lck.owns_lock());
+
+  EXPECT_EQ(cv.wait_for(lck, -1s), std::cv_status::timeout);
+}
+
+TEST(FutexConditionVariableTest, WaitForPredicateChecksFirst) {
+  std::mutex mutex;
+  FutexConditionVariable cv;
+  std::unique_lock<std::mutex> lck(mutex);
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(cv.wait_for(lck, 1s, []() { return true; }));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+
+  EXPECT_FALSE(cv.wait_for(lck, 10ms, []() { return false; }));
+}
+
+TEST(FutexConditionVariableTest, WaitUntilSystemClock) {
+  std::mutex mutex;
+  FutexConditionVariable cv;
+  std::unique_lock<std::mutex> lck(mutex);
+
+  EXPECT_EQ(cv.wait_until(lck, std::chrono::system_clock::now() + 10ms), std::cv_status::timeout);
+}
+
+TEST(FutexConditionVariableTest, WaitForNotified) {
+  std::mutex mutex;
+  FutexConditionVariable cv;
+  bool ready = false;
+  bool result = false;
+
+  std::thread waiter([&]() {
+    std::unique_lock<std::mutex> lck(mutex);
+    result = cv.wait_for(lck, std::chrono::hours::max(), [&]() { return ready; });
+  });
+
+  std::this_thread::sleep_for(20ms);
+  {
+    std::lock_guard<std::mutex> lck(mutex);
+    ready = true;
+  }
+  cv.notify_one();
+  waiter.join();
+
+  EXPECT_TRUE(result);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
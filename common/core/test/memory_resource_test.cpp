@@ -0,0 +1,179 @@
+/**
+ * @file
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "ara/core/map.h"
+#include "ara/core/memory_resource.h"
+#include "ara/core/string.h"
+#include "ara/core/vector.h"
+
+using namespace ara::core;
+
+namespace {
+
+// Upstream that counts what passes through it.
+class CountingResource : public pmr::memory_resource {
+public:
+  std::size_t allocations = 0U;
+  std::size_t outstanding = 0U;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    outstanding += bytes;
+    return pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    outstanding -= bytes;
+    pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+bool IsAligned(const void* p, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0U;
+}
+
+}  // namespace
+
+TEST(MemoryResourceTest, NewDeleteResource) {
+  pmr::memory_resource* r = pmr::new_delete_resource();
+  void* p = r->allocate(100, 256);
+  EXPECT_TRUE(IsAligned(p, 256));
+  r->deallocate(p, 100, 256);
+  EXPECT_EQ(*r, *pmr::new_delete_resource());
+  EXPECT_NE(*r, *pmr::null_memory_resource());
+  EXPECT_THROW(pmr::null_memory_resource()->allocate(1), std::bad_alloc);
+}
+
+TEST(MemoryResourceTest, DefaultResource) {
+  CountingResource counting;
+  EXPECT_EQ(pmr::get_default_resource(), pmr::new_delete_resource());
+  EXPECT_EQ(pmr::set_default_resource(&counting), pmr::new_delete_resource());
+  {
+    pmr::Vector<int> v;
+    v.push_back(1);
+  }
+  EXPECT_EQ(counting.allocations, 1U);
+  EXPECT_EQ(pmr::set_default_resource(nullptr), &counting);
+  EXPECT_EQ(pmr::get_default_resource(), pmr::new_delete_resource());
+}
+
+TEST(MemoryResourceTest, MonotonicBufferResource) {
+  CountingResource upstream;
+  alignas(std::max_align_t) char buffer[256];
+  pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), &upstream);
+
+  void* a = arena.allocate(10, 1);
+  void* b = arena.allocate(8, 8);
+  EXPECT_EQ(a, buffer);
+  EXPECT_TRUE(IsAligned(b, 8));
+  EXPECT_EQ(upstream.allocations, 0U);
+
+  void* c = arena.allocate(1000, 64);
+  EXPECT_TRUE(IsAligned(c, 64));
+  EXPECT_EQ(upstream.allocations, 1U);
+
+  arena.release();
+  EXPECT_EQ(upstream.outstanding, 0U);
+  EXPECT_EQ(arena.allocate(10, 1), buffer);
+}
+
+TEST(MemoryResourceTest, MonotonicFrameReset) {
+  CountingResource upstream;
+  pmr::monotonic_buffer_resource arena(4096, &upstream);
+  for (int frame = 0; frame < 10; ++frame) {
+    {
+      pmr::Vector<pmr::String> names(&arena);
+      for (int i = 0; i < 32; ++i) {
+        names.emplace_back("a name that does not fit the small string buffer");
+      }
+      EXPECT_EQ(names.back().get_allocator().resource(), &arena);
+      pmr::Map<int, pmr::String> map(&arena);
+      map.emplace(1, "another string that does not fit the small buffer");
+      EXPECT_EQ(map.at(1).get_allocator().resource(), &arena);
+    }
+    arena.release();
+    EXPECT_EQ(upstream.outstanding, 0U);
+  }
+}
+
+TEST(MemoryResourceTest, UnsynchronizedPoolResource) {
+  CountingResource upstream;
+  pmr::pool_options opts;
+  opts.largest_required_pool_block = 100U;
+  pmr::unsynchronized_pool_resource pool(opts, &upstream);
+  EXPECT_EQ(pool.options().largest_required_pool_block, 128U);
+
+  void* a = pool.allocate(24, 8);
+  pool.deallocate(a, 24, 8);
+  const std::size_t allocations = upstream.allocations;
+  void* b = pool.allocate(20, 8);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(upstream.allocations, allocations);
+
+  void* large = pool.allocate(1000, 128);
+  EXPECT_TRUE(IsAligned(large, 128));
+  void* large2 = pool.allocate(2000);
+  pool.deallocate(large, 1000, 128);
+
+  pool.release();
+  EXPECT_NE(upstream.outstanding, 0U);  // the pool table itself
+  static_cast<void>(large2);
+  {
+    pmr::Map<int, int> map(&pool);
+    for (int i = 0; i < 1000; ++i) {
+      map[i] = i;
+    }
+    map.clear();
+    const std::size_t steady = upstream.allocations;
+    for (int i = 0; i < 1000; ++i) {
+      map[i] = i;
+    }
+    EXPECT_EQ(upstream.allocations, steady);
+  }
+}
+
+TEST(MemoryResourceTest, SynchronizedPoolResource) {
+  CountingResource upstream;
+  pmr::synchronized_pool_resource pool(&upstream);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool]() {
+      for (int i = 0; i < 1000; ++i) {
+        pmr::Vector<int> v({1, 2, 3, 4, 5}, &pool);
+        EXPECT_EQ(v.size(), 5U);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  pool.release();
+}
+
+TEST(MemoryResourceTest, PolymorphicAllocator) {
+  pmr::monotonic_buffer_resource arena;
+  pmr::polymorphic_allocator<int> a(&arena);
+  pmr::polymorphic_allocator<double> b(a);
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, pmr::polymorphic_allocator<int>());
+
+  pmr::Vector<int> v(&arena);
+  v.push_back(1);
+  pmr::Vector<int> copy(v);
+  EXPECT_EQ(copy.get_allocator().resource(), pmr::get_default_resource());
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -8,6 +8,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <memory>
+#include <type_traits>
+
 #include "ara/core/optional.h"
 #include "ara/core/vector.h"
 #include "ara/core/string.h"
@@ -166,6 +169,51 @@ TEST(OptionalTest, SimpleTest) {
   }
 }
 
+namespace {
+
+// Trivially copyable, but with a user-provided move constructor.
+struct TrivialCopyOnly {
+  TrivialCopyOnly() = default;
+  TrivialCopyOnly(const TrivialCopyOnly&) = default;
+  TrivialCopyOnly(TrivialCopyOnly&&) noexcept {}
+  TrivialCopyOnly& operator=(const TrivialCopyOnly&) = default;
+  TrivialCopyOnly& operator=(TrivialCopyOnly&&) = default;
+};
+
+}  // namespace
+
+TEST(OptionalTest, TrivialSpecialMembers) {
+  static_assert(std::is_trivially_copyable<Optional<int>>::value, "");
+  static_assert(std::is_trivially_copy_constructible<Optional<double>>::value, "");
+  static_assert(std::is_trivially_move_constructible<Optional<double>>::value, "");
+  static_assert(std::is_trivially_copy_assignable<Optional<double>>::value, "");
+  static_assert(std::is_trivially_move_assignable<Optional<double>>::value, "");
+  static_assert(std::is_trivially_destructible<Optional<double>>::value, "");
+
+  static_assert(!std::is_trivially_copyable<Optional<String>>::value, "");
+  static_assert(!std::is_trivially_destructible<Optional<String>>::value, "");
+  static_assert(!std::is_copy_constructible<Optional<std::unique_ptr<int>>>::value, "");
+  static_assert(std::is_move_constructible<Optional<std::unique_ptr<int>>>::value, "");
+
+  static_assert(std::is_trivially_copy_constructible<Optional<TrivialCopyOnly>>::value, "");
+  static_assert(!std::is_trivially_move_constructible<Optional<TrivialCopyOnly>>::value, "");
+  Optional<TrivialCopyOnly> a(TrivialCopyOnly {});
+  Optional<TrivialCopyOnly> b(a);
+  Optional<TrivialCopyOnly> c(std::move(a));
+  EXPECT_TRUE(b.has_value());
+  EXPECT_TRUE(c.has_value());
+}
+
+TEST(OptionalTest, Constexpr) {
+  constexpr Optional<int> empty;
+  constexpr Optional<int> value(3);
+  constexpr Optional<int> copy(value);
+  static_assert(!empty.has_value(), "");
+  static_assert(value.has_value() && *value == 3, "");
+  static_assert(copy && copy.value() == 3, "");
+  static_assert(empty.value_or(4) == 4, "");
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -10,7 +10,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include "ara/core/promise.h"
 
@@ -204,6 +211,191 @@ TEST(PromiseTest, SimpleTestThen) {
   }
 }
 
+namespace {
+
+// Queues tasks until Run() is called, in the style of utility::Executor.
+class QueueExecutor {
+public:
+  void AddExecute(std::function<void()> task) { tasks_.push_back(std::move(task)); }
+
+  std::size_t Run() {
+    std::size_t count = 0;
+    while (!tasks_.empty()) {
+      auto task = std::move(tasks_.front());
+      tasks_.pop_front();
+      task();
+      ++count;
+    }
+    return count;
+  }
+
+private:
+  std::deque<std::function<void()>> tasks_;
+};
+
+// Exposes post() only, in the style of asio io_context::strand.
+class PostExecutor {
+public:
+  void post(std::function<void()> task) { tasks_.push_back(std::move(task)); }
+
+  void Run() {
+    for (auto& task : tasks_) {
+      task();
+    }
+    tasks_.clear();
+  }
+
+private:
+  std::vector<std::function<void()>> tasks_;
+};
+
+}  // namespace
+
+TEST(PromiseTest, ThenOnExecutor) {
+  {
+    QueueExecutor executor;
+    Promise<int> tmp;
+    auto fut = tmp.get_future();
+    std::thread::id called_on;
+    auto futt = fut.then(executor, [&called_on](const Result<int>& res) {
+      called_on = std::this_thread::get_id();
+      return *res + 1;
+    });
+
+    std::thread t([&tmp]() { tmp.set_value(1); });
+    t.join();
+    ASSERT_FALSE(futt.is_ready());
+
+    ASSERT_EQ(executor.Run(), 1U);
+    ASSERT_EQ(called_on, std::this_thread::get_id());
+    ASSERT_EQ(futt.GetResult(), 2);
+  }
+  {
+    PostExecutor executor;
+    Promise<std::string> tmp;
+    auto fut = tmp.get_future();
+    tmp.set_value("abc");
+    auto futt = fut.via(executor);
+    ASSERT_FALSE(futt.is_ready());
+    executor.Run();
+    ASSERT_EQ(futt.GetResult().Value(), "abc");
+  }
+  {
+    QueueExecutor executor;
+    Promise<void> tmp;
+    auto fut = tmp.get_future();
+    int i = 0;
+    auto futt = fut.then(executor, [&i](const Result<void>& res) { i = res ? 1 : -1; });
+    tmp.set_value();
+    ASSERT_EQ(i, 0);
+    executor.Run();
+    ASSERT_EQ(i, 1);
+    ASSERT_TRUE(futt.GetResult());
+  }
+  {
+    QueueExecutor executor;
+    Promise<int> tmp;
+    auto fut = tmp.get_future();
+    auto futt = fut.via(executor);
+    tmp.SetError(ErrorCode(CoreErrc::no_such_file_or_directory));
+    executor.Run();
+    ASSERT_EQ(futt.GetResult().Error(), ErrorCode(CoreErrc::no_such_file_or_directory));
+  }
+}
+
+TEST(PromiseTest, SharedStateIsRecycled) {
+  const void* first = nullptr;
+  {
+    Promise<std::size_t> tmp;
+    auto fut = tmp.get_future();
+    tmp.set_value(1);
+    first = fut.core_;
+  }
+  {
+    Promise<std::size_t> tmp;
+    auto fut = tmp.get_future();
+    ASSERT_EQ(fut.core_, first);
+  }
+  {
+    // promises fulfilled and released on another thread, like asio handlers
+    std::vector<Promise<std::size_t>> promises;
+    std::vector<Future<std::size_t>> futures;
+    for (std::size_t i = 0; i < 1000; ++i) {
+      promises.emplace_back();
+      futures.push_back(promises.back().get_future());
+    }
+    std::thread t([&promises]() {
+      std::size_t i = 0;
+      for (auto& p : promises) {
+        p.set_value(i++);
+      }
+      promises.clear();
+    });
+    t.join();
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+      ASSERT_EQ(futures[i].GetResult().Value(), i);
+    }
+  }
+}
+
+TEST(PromiseTest, AllocatingWithEmptyDepotSkipsMutex) {
+  using Cache = internal::BlockCache<48, 8>;  // a size class no shared state uses
+  auto& depot = Cache::GetDepot();
+  ASSERT_EQ(depot.count.load(), 0U);
+  std::unique_lock<std::mutex> lock(depot.mutex);
+  auto done = std::async(std::launch::async, []() {
+    std::vector<void*> blocks;
+    for (int round = 0; round < 3; ++round) {
+      for (std::size_t i = 0; i < Cache::kMaxCached; ++i) {
+        blocks.push_back(Cache::Allocate());
+      }
+      for (void* block : blocks) {
+        Cache::Deallocate(block);
+      }
+      blocks.clear();
+    }
+  });
+  const std::future_status status = done.wait_for(std::chrono::seconds(10));
+  lock.unlock();
+  EXPECT_EQ(status, std::future_status::ready);
+}
+
+TEST(PromiseTest, WaitWhileSetOnAnotherThread) {
+  // each wait() races with set_value() on another thread, a lost wakeup hangs the test
+  constexpr std::size_t kPairs = 4;
+  constexpr std::size_t kRounds = 20000;
+  std::vector<std::thread> threads;
+  for (std::size_t pair = 0; pair < kPairs; ++pair) {
+    threads.emplace_back([]() {
+      std::atomic<Promise<std::size_t>*> handoff{nullptr};
+      std::thread setter([&handoff]() {
+        for (std::size_t round = 0; round < kRounds; ++round) {
+          Promise<std::size_t>* promise = nullptr;
+          while ((promise = handoff.load(std::memory_order_acquire)) == nullptr) {
+            std::this_thread::yield();
+          }
+          promise->set_value(round);
+          handoff.store(nullptr, std::memory_order_release);
+        }
+      });
+      for (std::size_t round = 0; round < kRounds; ++round) {
+        Promise<std::size_t> promise;
+        auto fut = promise.get_future();
+        handoff.store(&promise, std::memory_order_release);
+        fut.wait();
+        EXPECT_EQ(fut.GetResult().Value(), round);
+        while (handoff.load(std::memory_order_acquire) != nullptr) {
+          std::this_thread::yield();
+        }
+      }
+      setter.join();
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
 TEST(PromiseTest, SimpleTestVoid) {
   {
     Promise<void> tmp;
@@ -8,6 +8,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <memory>
+#include <type_traits>
+
 #include "ara/core/core_error_domain.h"
 #include "ara/core/error_code.h"
 #include "ara/core/future_error_domain.h"
@@ -247,6 +250,48 @@ TEST(ResultTest, VoidTest) {
   ASSERT_TRUE(Result<void>());
   
 }
+
+namespace {
+
+enum class PlainError : int { failed = 1 };
+
+}  // namespace
+
+TEST(ResultTest, TrivialSpecialMembers) {
+  static_assert(std::is_trivially_copyable<Result<int>>::value, "");
+  static_assert(std::is_trivially_copyable<Result<void>>::value, "");
+  static_assert(std::is_trivially_copy_constructible<Result<double, PlainError>>::value, "");
+  static_assert(std::is_trivially_move_constructible<Result<double, PlainError>>::value, "");
+  static_assert(std::is_trivially_copy_assignable<Result<double, PlainError>>::value, "");
+  static_assert(std::is_trivially_move_assignable<Result<double, PlainError>>::value, "");
+  static_assert(std::is_trivially_destructible<Result<double, PlainError>>::value, "");
+
+  static_assert(!std::is_trivially_copyable<Result<String>>::value, "");
+  static_assert(!std::is_trivially_copyable<Result<void, String>>::value, "");
+  static_assert(!std::is_copy_constructible<Result<std::unique_ptr<int>>>::value, "");
+  static_assert(std::is_nothrow_move_constructible<Result<std::unique_ptr<int>>>::value, "");
+
+  Result<std::unique_ptr<int>> owner(std::unique_ptr<int>(new int(7)));
+  Result<std::unique_ptr<int>> moved(std::move(owner));
+  ASSERT_TRUE(moved.HasValue());
+  EXPECT_EQ(*moved.Value(), 7);
+
+  Result<int> copy(Result<int>::FromError(CoreErrc::invalid_argument));
+  copy = Result<int>(5);
+  EXPECT_EQ(copy.Value(), 5);
+}
+
+TEST(ResultTest, Constexpr) {
+  constexpr Result<int, PlainError> value(5);
+  constexpr auto error = Result<int, PlainError>::FromError(PlainError::failed);
+  constexpr Result<void, PlainError> ok;
+  constexpr auto void_error = Result<void, PlainError>::FromError(PlainError::failed);
+  static_assert(value.HasValue() && value.Value() == 5 && *value == 5, "");
+  static_assert(!error && error.Error() == PlainError::failed, "");
+  static_assert(ok.HasValue(), "");
+  static_assert(!void_error.HasValue() && void_error.Error() == PlainError::failed, "");
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,168 @@
+/**
+ * @file
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "ara/core/nv_array.h"
+#include "ara/core/shared_memory.h"
+#include "ara/core/string.h"
+
+using namespace ara::core;
+
+namespace {
+
+// Unique per test process so parallel runs don't collide in /dev/shm.
+String SegmentName(const char* suffix) {
+  char name[64];
+  std::snprintf(name, sizeof(name), "/ara_core_test_%d_%s", static_cast<int>(::getpid()), suffix);
+  return String(name);
+}
+
+bool SegmentExists(const String& name) {
+  int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+  ::close(fd);
+  return true;
+}
+
+}  // namespace
+
+TEST(SharedMemorySegmentTest, CreateAndOpen) {
+  const String name = SegmentName("segment");
+  {
+    auto created = SharedMemorySegment::Create(StringView(name), 4096U);
+    ASSERT_TRUE(created.HasValue());
+    SharedMemorySegment segment = std::move(created).Value();
+    EXPECT_TRUE(segment.valid());
+    EXPECT_EQ(segment.size(), 4096U);
+    EXPECT_EQ(segment.name(), StringView(name));
+    EXPECT_EQ(segment.UseCount(), 1U);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(segment.data()) % 64U, 0U);
+    EXPECT_EQ(static_cast<const char*>(segment.data())[100], 0);
+
+    std::memcpy(segment.data(), "hello", 6U);
+
+    SharedMemoryDescriptor descriptor = segment.Share();
+    EXPECT_EQ(segment.UseCount(), 2U);
+    auto opened = SharedMemorySegment::Open(descriptor);
+    ASSERT_TRUE(opened.HasValue());
+    SharedMemorySegment other = std::move(opened).Value();
+    EXPECT_NE(other.data(), segment.data());  // a second mapping of the same pages
+    EXPECT_STREQ(static_cast<const char*>(other.data()), "hello");
+    EXPECT_EQ(other.UseCount(), 2U);
+
+    SharedMemorySegment copy = other;  // shares the mapping of other
+    EXPECT_EQ(copy.data(), other.data());
+    EXPECT_EQ(segment.UseCount(), 2U);
+    copy.Reset();
+    EXPECT_FALSE(copy.valid());
+    EXPECT_STREQ(static_cast<const char*>(other.data()), "hello");
+
+    segment.Reset();
+    EXPECT_TRUE(SegmentExists(name));
+  }
+  EXPECT_FALSE(SegmentExists(name));
+}
+
+TEST(SharedMemorySegmentTest, Errors) {
+  auto bad_name = SharedMemorySegment::Create("no_slash", 16U);
+  ASSERT_FALSE(bad_name.HasValue());
+  EXPECT_EQ(bad_name.Error(), CoreErrc::invalid_argument);
+
+  auto too_long = SharedMemorySegment::Create(StringView(String(80U, '/')), 16U);
+  ASSERT_FALSE(too_long.HasValue());
+  EXPECT_EQ(too_long.Error(), CoreErrc::filename_too_long);
+
+  const String name = SegmentName("errors");
+  auto first = SharedMemorySegment::Create(StringView(name), 16U);
+  ASSERT_TRUE(first.HasValue());
+  auto second = SharedMemorySegment::Create(StringView(name), 16U);
+  ASSERT_FALSE(second.HasValue());
+  EXPECT_EQ(second.Error(), CoreErrc::file_exists);
+
+  SharedMemoryDescriptor descriptor = first.Value().Share();
+  descriptor.size = 32U;
+  auto wrong_size = SharedMemorySegment::Open(descriptor);
+  ASSERT_FALSE(wrong_size.HasValue());
+  EXPECT_EQ(wrong_size.Error(), CoreErrc::invalid_argument);
+  descriptor.size = 16U;
+  SharedMemorySegment::Open(descriptor);  // adopt and drop the extra reference
+
+  std::strcpy(descriptor.name, "/ara_core_test_missing");
+  auto missing = SharedMemorySegment::Open(descriptor);
+  ASSERT_FALSE(missing.HasValue());
+  EXPECT_EQ(missing.Error(), CoreErrc::no_such_file_or_directory);
+}
+
+TEST(SharedNvArrayTest, CrossProcess) {
+  const String name = SegmentName("nv_array");
+  auto array = NvArray<std::uint32_t, 1024>::CreateShared(StringView(name));
+  EXPECT_TRUE(array.IsShared());
+  for (std::size_t i = 0; i < array.size(); ++i) {
+    array[i] = static_cast<std::uint32_t>(i);
+  }
+  // The descriptor is plain bytes, as if it came through an ipc message.
+  SharedMemoryDescriptor descriptor = array.Share();
+
+  pid_t pid = ::fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    int status = 0;
+    try {
+      auto view = NvArray<std::uint32_t, 1024>::OpenShared(descriptor);
+      for (std::size_t i = 0; i < view.size(); ++i) {
+        if (view[i] != i) {
+          status = 1;
+        }
+        view[i] *= 2U;
+      }
+    } catch (...) {
+      status = 2;
+    }
+    ::_exit(status);
+  }
+  int status = 0;
+  ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+
+  // The child wrote through its own mapping, nothing was copied.
+  EXPECT_EQ(array[10], 20U);
+  EXPECT_EQ(array.back(), 2046U);
+
+  {
+    NvArray<std::uint32_t, 1024> copy = array;
+    EXPECT_EQ(copy.data(), array.data());
+  }
+  EXPECT_TRUE(SegmentExists(name));
+  array = NvArray<std::uint32_t, 1024>();
+  EXPECT_FALSE(SegmentExists(name));
+}
+
+TEST(SharedNvArrayTest, Errors) {
+  NvArray<int, 4> local;
+  EXPECT_FALSE(local.IsShared());
+  EXPECT_THROW(local.Share(), CoreException);
+
+  auto array = NvArray<int, 4>::CreateShared(StringView(SegmentName("nv_errors")));
+  SharedMemoryDescriptor descriptor = array.Share();
+  EXPECT_THROW((NvArray<int, 8>::OpenShared(descriptor)), CoreException);
+  NvArray<int, 4>::OpenShared(descriptor);
+
+  EXPECT_THROW((NvArray<int, 4>::CreateShared(StringView(SegmentName("nv_errors")))), CoreException);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,191 @@
+/**
+ * @file
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <sstream>
+#include <type_traits>
+#include <unordered_set>
+
+#include "ara/core/static_string.h"
+#include "ara/core/string.h"
+
+using namespace ara::core;
+
+TEST(StaticStringTest, Construct) {
+  StaticString<8> s1;
+  EXPECT_TRUE(s1.empty());
+  EXPECT_STREQ(s1.c_str(), "");
+
+  StaticString<8> s2("abc");
+  EXPECT_EQ(s2.size(), 3U);
+  EXPECT_STREQ(s2.c_str(), "abc");
+  EXPECT_FALSE(s2.truncated());
+
+  StaticString<8> s3(StringView("abcdef", 2));
+  EXPECT_EQ(s3, "ab");
+
+  StaticString<8> s4(3U, 'x');
+  EXPECT_EQ(s4, "xxx");
+
+  StaticString<16> s5(s2);
+  EXPECT_EQ(s5, s2);
+
+  static_assert(sizeof(StaticString<4>) <= 24U, "no hidden heap pointer");
+  static_assert(std::is_trivially_copyable<StaticString<16>>::value, "copy is a memcpy");
+  static_assert(StaticString<16>::capacity() == 16U, "capacity is static");
+}
+
+TEST(StaticStringTest, TruncatesOnOverflow) {
+  StaticString<4> id("CONTEXT");
+  EXPECT_EQ(id.size(), 4U);
+  EXPECT_EQ(id, "CONT");
+  EXPECT_TRUE(id.truncated());
+  EXPECT_TRUE(id.full());
+
+  id.assign("AB");
+  EXPECT_FALSE(id.truncated());
+  id.append("CD");
+  EXPECT_FALSE(id.truncated());
+  id.push_back('E');
+  EXPECT_TRUE(id.truncated());
+  EXPECT_EQ(id, "ABCD");
+  EXPECT_EQ(id.c_str()[4], '\0');
+
+  StaticString<2> narrow(id);
+  EXPECT_EQ(narrow, "AB");
+  EXPECT_TRUE(narrow.truncated());
+
+  id.clear();
+  EXPECT_FALSE(id.truncated());
+  EXPECT_TRUE(id.empty());
+}
+
+TEST(StaticStringTest, ShrinkingClearsTruncated) {
+  StaticString<4> id("CONTEXT");
+  ASSERT_TRUE(id.truncated());
+  id.erase(2U);
+  EXPECT_FALSE(id.truncated());
+  EXPECT_EQ(id, "CO");
+
+  id.append("NTEXT");
+  ASSERT_TRUE(id.truncated());
+  id.pop_back();
+  EXPECT_FALSE(id.truncated());
+  EXPECT_EQ(id, "CON");
+
+  id.resize(8U, 'X');
+  EXPECT_TRUE(id.truncated());
+  EXPECT_EQ(id, "CONX");
+  id.resize(4U);
+  EXPECT_FALSE(id.truncated());
+  id.resize(8U);
+  ASSERT_TRUE(id.truncated());
+  id.resize(1U);
+  EXPECT_FALSE(id.truncated());
+  EXPECT_EQ(id, "C");
+}
+
+TEST(StaticStringTest, OverwriteSetsTruncated) {
+  StaticString<4> id("abcdefg");
+  ASSERT_TRUE(id.truncated());
+  id.resize_and_overwrite(3U, [](char* p, std::size_t) {
+    p[0] = 'x';
+    p[1] = 'y';
+    return 2;
+  });
+  EXPECT_FALSE(id.truncated());
+  EXPECT_EQ(id, "xy");
+
+  id.resize_and_overwrite(3U, [](char* p, std::size_t n) { return std::snprintf(p, n + 1U, "%s", "abcdef"); });
+  EXPECT_TRUE(id.truncated());
+  EXPECT_EQ(id, "abc");
+
+  id.resize_and_overwrite(8U, [](char* p, std::size_t n) { return std::snprintf(p, n + 1U, "%s", "ab"); });
+  EXPECT_TRUE(id.truncated());
+  EXPECT_EQ(id, "ab");
+}
+
+TEST(StaticStringTest, Modify) {
+  StaticString<32> path("/tmp");
+  path += '/';
+  path += StringView("ipc");
+  path.append(".sock");
+  EXPECT_EQ(path, "/tmp/ipc.sock");
+
+  path.erase(4, 4);
+  EXPECT_EQ(path, "/tmp.sock");
+
+  path.pop_back();
+  EXPECT_EQ(path.back(), 'c');
+  EXPECT_EQ(path.front(), '/');
+
+  path.resize(4);
+  EXPECT_EQ(path, "/tmp");
+  path.resize(6, '!');
+  EXPECT_EQ(path, "/tmp!!");
+
+  StaticString<16> buffer;
+  buffer.resize_and_overwrite(buffer.capacity(), [](char* p, std::size_t n) {
+    return std::snprintf(p, n + 1U, "%d-%s", 42, "x");
+  });
+  EXPECT_EQ(buffer, "42-x");
+  buffer.resize_and_overwrite(3U, [](char* p, std::size_t n) { return std::snprintf(p, n + 1U, "%s", "abcdef"); });
+  EXPECT_EQ(buffer, "abc");
+
+  EXPECT_THROW(path.at(6), std::out_of_range);
+  EXPECT_THROW(path.erase(7), std::out_of_range);
+}
+
+TEST(StaticStringTest, StringViewInterop) {
+  StaticString<16> s("hello world");
+  StringView sv = s;
+  EXPECT_EQ(sv.size(), s.size());
+  EXPECT_EQ(sv.data(), s.data());
+
+  EXPECT_TRUE(s == StringView("hello world"));
+  EXPECT_TRUE(StringView("hello") < s);
+  EXPECT_EQ(s.find("world"), 6U);
+  EXPECT_EQ(s.find('o'), 4U);
+  EXPECT_EQ(s.rfind('o'), 7U);
+  EXPECT_EQ(s.find_first_of("wo"), 4U);
+  EXPECT_EQ(s.find_last_not_of("dl"), 8U);
+  EXPECT_EQ(s.substr(6), "world");
+  EXPECT_THROW(s.substr(12), std::out_of_range);
+
+  String str(s.ToString());
+  EXPECT_EQ(str, "hello world");
+  StaticString<16> back(static_cast<StringView>(str));
+  EXPECT_EQ(back, s);
+}
+
+TEST(StaticStringTest, Compare) {
+  StaticString<8> a("abc");
+  StaticString<4> b("abd");
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(a != b);
+  EXPECT_TRUE(b > a);
+  EXPECT_TRUE(a <= "abc");
+  EXPECT_TRUE("abc" == a);
+  EXPECT_TRUE("abb" < a);
+  EXPECT_FALSE(a >= "abd");
+}
+
+TEST(StaticStringTest, StreamAndHash) {
+  StaticString<8> s("abc");
+  std::ostringstream os;
+  os << s;
+  EXPECT_EQ(os.str(), "abc");
+
+  std::unordered_set<StaticString<8>> set;
+  set.insert(s);
+  EXPECT_EQ(set.count(StaticString<8>("abc")), 1U);
+  EXPECT_EQ(std::hash<StaticString<8>>()(s), std::hash<StringView>()(StringView("abc")));
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -2,8 +2,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <stdexcept>
 #include <string>
 #include <sstream>
+#include <type_traits>
 #include "ara/core/variant.h"
 
 using namespace ara::core;
@@ -334,6 +336,60 @@ TEST(Visit_Heterogenous, Quintuple) {
   EXPECT_EQ("101+202=303", ara::core::visit(concat{}, v, w, x, y, z));
 }
 
+/****************************Trivial****************************************/
+
+struct throwing_pod_t {
+  int value;
+  throwing_pod_t() = default;
+  explicit throwing_pod_t(int v) : value(v) {
+    if (v < 0) {
+      throw std::invalid_argument("negative");
+    }
+  }
+};
+
+TEST(Trivial, SpecialMembers) {
+  using TrivialVariant = ara::core::Variant<int, double, char, throwing_pod_t>;
+  static_assert(std::is_trivially_copyable<TrivialVariant>::value, "");
+  static_assert(std::is_trivially_destructible<TrivialVariant>::value, "");
+  static_assert(std::is_trivially_copy_constructible<TrivialVariant>::value, "");
+  static_assert(std::is_trivially_move_constructible<TrivialVariant>::value, "");
+  static_assert(std::is_trivially_copy_assignable<TrivialVariant>::value, "");
+  static_assert(std::is_trivially_move_assignable<TrivialVariant>::value, "");
+
+  using StringVariant = ara::core::Variant<int, std::string>;
+  static_assert(!std::is_trivially_copyable<StringVariant>::value, "");
+  static_assert(!std::is_trivially_destructible<StringVariant>::value, "");
+}
+
+TEST(Trivial, NeverValueless) {
+  ara::core::Variant<int, throwing_pod_t> v(42);
+  EXPECT_THROW(v.emplace<throwing_pod_t>(-1), std::invalid_argument);
+  EXPECT_FALSE(v.valueless_by_exception());
+  EXPECT_EQ(42, ara::core::get<int>(v));
+
+  EXPECT_EQ(7, v.emplace<throwing_pod_t>(7).value);
+  EXPECT_EQ(1u, v.index());
+}
+
+TEST(Trivial, MultiVisit) {
+  struct sum {
+    double operator()(int a, int b) const { return a + b; }
+    double operator()(int a, double b) const { return a + b; }
+    double operator()(double a, int b) const { return a + b; }
+    double operator()(double a, double b) const { return a + b; }
+    double operator()(char, int b) const { return b; }
+    double operator()(char, double b) const { return b; }
+  };
+  ara::core::Variant<int, double, char> v(1), w(0.5), x('c');
+  ara::core::Variant<int, double> y(2);
+  EXPECT_EQ(3.0, ara::core::visit(sum{}, v, y));
+  EXPECT_EQ(2.5, ara::core::visit(sum{}, w, y));
+  EXPECT_EQ(2.0, ara::core::visit(sum{}, x, y));
+  y = 0.25;
+  EXPECT_EQ(0.75, ara::core::visit(sum{}, w, y));
+}
+
 /******************swap*********************/
 
 TEST(Swap, Same) {
@@ -12,9 +12,12 @@
 #ifndef AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_IPC_DOMAIN_SOCKET_H_
 #define AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_IPC_DOMAIN_SOCKET_H_
 
+#include <sys/un.h>
+
 #include <boost/asio.hpp>
 #include <boost/asio/thread_pool.hpp>
 
+#include "ara/core/static_string.h"
 #include "ara/ipc/process_handler.h"
 
 namespace ara {
@@ -46,6 +49,17 @@ class BaseDomainSocket {
    * @return const char*
    */
   const char* getDomainSocketFilePrefixPath();
+  /* Longest path a unix domain socket endpoint can hold */
+  using SocketPath = ara::core::StaticString<sizeof(sockaddr_un::sun_path) - 1>;
+  /**
+   * @brief Get the Domain Socket File Path, i.e. prefix path + "/" + file
+   *
+   * @param socket_file socket file name
+   * @return SocketPath
+   * @throw boost::system::system_error name_too_long if the path does not
+   * fit into sockaddr_un
+   */
+  SocketPath getDomainSocketFilePath(const std::string& socket_file);
   BaseDomainSocket(uint32_t n_threads);
   virtual ~BaseDomainSocket();
 };
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <ara/core/bytes.h>
+#include <ara/core/static_string.h>
 #include <ara/core/string.h>
 #include <sys/time.h>
+#include <time.h>
 
 namespace ara {
 namespace ipc {
@@ -24,50 +27,29 @@ inline uint64_t get_timestamp() {
   // return 0;
 }
 
+// The header fields are written with memcpy, i.e. in host byte order.
 inline uint32_t bytes_to_uint(const char* bytes) {
-#if (BYTE_ORDER == BIG_ENDIAN)
-  uint32_t r = uint32_t((*bytes << 24) + (*(bytes + 1) << 16) +
-                        (*(bytes + 2) << 8) + *(bytes + 3));
-#else
-  uint32_t r = uint32_t((static_cast<uint8_t>(*(bytes + 3)) << 24) +
-                        (static_cast<uint8_t>(*(bytes + 2)) << 16)) +
-               (static_cast<uint8_t>(*(bytes + 1)) << 8) +
-               static_cast<uint8_t>(*bytes);
-#endif
-  return r;
+  return ara::core::bytes::Load<uint32_t>(ara::core::Span<const char>(bytes, sizeof(uint32_t)));
 }
 
 inline uint64_t bytes_to_ulong(const char* bytes) {
-  uint64_t r;
-#if (BYTE_ORDER == BIG_ENDIAN)
-  r = static_cast<uint8_t>(*bytes);
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 1)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 2)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 3)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 4)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 5)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 6)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 7)));
-#else
-  r = static_cast<uint8_t>(*(bytes + 7));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 6)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 5)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 4)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 3)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 2)));
-  r = (r << 8) + static_cast<uint8_t>((*(bytes + 1)));
-  r = (r << 8) + static_cast<uint8_t>(*bytes);
-
-#endif
-  return r;
+  return ara::core::bytes::Load<uint64_t>(ara::core::Span<const char>(bytes, sizeof(uint64_t)));
 }
 
-inline String get_Datetime(const uint64_t& timestamp_ms) {
-  char szTime[25];
+// "YYYY-MM-DD hh:mm:ss" plus room for years beyond 9999
+using DatetimeString = ara::core::StaticString<24>;
+
+inline DatetimeString get_Datetime(const uint64_t& timestamp_ms) {
+  DatetimeString datetime;
   time_t temp = timestamp_ms / 1000;
-  struct tm* timeSet = localtime(&temp);
-  strftime(szTime, sizeof(szTime) - 1, "%F %T", timeSet);
-  return String(szTime);
+  struct tm timeSet;
+  if (localtime_r(&temp, &timeSet) != nullptr) {
+    datetime.resize_and_overwrite(
+        datetime.capacity(), [&timeSet](char* buf, std::size_t size) {
+          return strftime(buf, size + 1, "%F %T", &timeSet);
+        });
+  }
+  return datetime;
 }
 
 }  // namespace utilites
@@ -16,4 +16,5 @@
 #include <ara/ipc/new_ipc_message.h>
 #include <ara/ipc/process_handler.h>
 #include <ara/ipc/server_domain_socket.h>
+#include <ara/ipc/shared_memory_message.h>
 #endif
\ No newline at end of file
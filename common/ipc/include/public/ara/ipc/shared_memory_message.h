@@ -0,0 +1,56 @@
+/*
+ * @Description: Carry an ara::core::SharedMemoryDescriptor in an ipc message
+ * instead of the data itself, so large buffers (e.g. a shared
+ * ara::core::NvArray) cross process boundaries without a copy.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_IPC_SHARED_MEMORY_MESSAGE_H_
+#define AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_IPC_SHARED_MEMORY_MESSAGE_H_
+
+#include <ara/core/result.h>
+#include <ara/core/shared_memory.h>
+#include <ara/ipc/ipc_base_message.h>
+
+#include <cstring>
+
+namespace ara {
+namespace ipc {
+
+/**
+ * @brief Build a message whose payload is @a descriptor.
+ *
+ * The descriptor holds a reference to its segment, send the message exactly
+ * once and have the receiver pass the descriptor to
+ * ara::core::SharedMemorySegment::Open() or NvArray::OpenShared().
+ */
+template <typename Message>
+Message MakeSharedMemoryMessage(const ara::core::SharedMemoryDescriptor& descriptor,
+                                IPCMessageModeType type = IPCMessageMode::RPC) {
+  return Message(sizeof(descriptor), &descriptor, type);
+}
+
+/**
+ * @brief Read back the descriptor of a message made by
+ * MakeSharedMemoryMessage().
+ *
+ * @returns the descriptor, or CoreErrc::bad_message if the payload has the
+ *          wrong size
+ */
+template <typename Message>
+ara::core::Result<ara::core::SharedMemoryDescriptor> ReadSharedMemoryDescriptor(const Message& msg) {
+  using ResultType = ara::core::Result<ara::core::SharedMemoryDescriptor>;
+  if (msg.payload_length() != sizeof(ara::core::SharedMemoryDescriptor) || msg.payload() == nullptr) {
+    return ResultType::FromError(ara::core::CoreErrc::bad_message);
+  }
+  ara::core::SharedMemoryDescriptor descriptor;
+  std::memcpy(&descriptor, msg.payload(), sizeof(descriptor));
+  descriptor.name[ara::core::SharedMemoryDescriptor::kMaxNameLength] = '\0';
+  return ResultType::FromValue(descriptor);
+}
+
+}  // namespace ipc
+}  // namespace ara
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_IPC_SHARED_MEMORY_MESSAGE_H_
@@ -42,7 +42,7 @@ class ClientDomainSocket<T>::pImpl : public BaseDomainSocket {
   // boost::asio::strand<boost::asio::io_context::executor_type> strand_2_;
   boost::asio::io_service::strand strand_2_;
   std::atomic_bool connected{false};
-  std::string real_socket_path = "/tmp";
+  SocketPath real_socket_path;
   stream_protocol::endpoint endpoint_;
   boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work;
   uint32_t request_id = 0;
@@ -55,10 +55,8 @@ class ClientDomainSocket<T>::pImpl : public BaseDomainSocket {
         strand_1_(io_context_),
         // strand_2_(io_context_.get_executor()),
         strand_2_(io_context_),
-        real_socket_path(
-            std::string(BaseDomainSocket::getDomainSocketFilePrefixPath()) +
-            "/" + socket_file),
-        endpoint_(real_socket_path),
+        real_socket_path(getDomainSocketFilePath(socket_file)),
+        endpoint_(real_socket_path.c_str()),
         work(boost::asio::make_work_guard(io_context_)) {}
 
   ~pImpl() {
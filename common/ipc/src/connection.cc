@@ -52,7 +52,8 @@ void connection<T>::read_header(const boost::system::error_code& ec) {
         std::bind(&connection::read_payload, shared_from_this(),
                   std::placeholders::_1));
   } else {
-    logger.LogWarn() << "server: read header error:" << ec.message();
+    ARA_LOG_EVERY_MS(logger.ap_logger(), ara::log::LogLevel::kWarn, 1000)
+        << "server: read header error:" << ec.message();
     if (ec != boost::asio::error::operation_aborted) {
       logger.LogInfo() << "server close connection.";
       Handler<T>::handler_manager_.stop(shared_from_this());
@@ -73,7 +74,8 @@ void connection<NewIpcMessage>::read_header(
         std::bind(&connection::read_payload, shared_from_this(),
                   std::placeholders::_1));
   } else {
-    logger.LogWarn() << "server: read header error:" << ec.message();
+    ARA_LOG_EVERY_MS(logger.ap_logger(), ara::log::LogLevel::kWarn, 1000)
+        << "server: read header error:" << ec.message();
     if (ec != boost::asio::error::operation_aborted) {
       logger.LogInfo() << "server close connection.";
       Handler<NewIpcMessage>::handler_manager_.stop(shared_from_this());
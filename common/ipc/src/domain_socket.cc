@@ -37,6 +37,18 @@ const char* BaseDomainSocket::getDomainSocketFilePrefixPath() {
   }
 }
 
+BaseDomainSocket::SocketPath BaseDomainSocket::getDomainSocketFilePath(
+    const std::string& socket_file) {
+  SocketPath path(getDomainSocketFilePrefixPath());
+  path += '/';
+  path.append(socket_file.data(), socket_file.size());
+  if (path.truncated()) {
+    // same error stream_protocol::endpoint raises for an overlong path
+    boost::asio::detail::throw_error(boost::asio::error::name_too_long);
+  }
+  return path;
+}
+
 void BaseDomainSocket::Run() {
   for (uint32_t i = 0; i < thread_nums; i++) {
     boost::asio::post(pool, [this, i]() {
@@ -183,7 +183,7 @@ IPCMessageModeType IPCMessage::ipc_mode() const {
 }
 
 String IPCMessage::timestamp_format() {
-  return ara::ipc::utilites::get_Datetime(timestamp());
+  return String(ara::ipc::utilites::get_Datetime(timestamp()));
 }
 
 }  // namespace ipc
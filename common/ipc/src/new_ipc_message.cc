@@ -249,7 +249,7 @@ uint64_t NewIpcMessage::timestamp() const {
 }
 
 String NewIpcMessage::timestamp_format() {
-  return pImpl_ != nullptr ? ara::ipc::utilites::get_Datetime(timestamp()) : "";
+  return pImpl_ != nullptr ? String(ara::ipc::utilites::get_Datetime(timestamp())) : String();
 }
 
 }  // namespace ipc
@@ -78,8 +78,9 @@ void request<T>::do_read() {
     }
 
   } else {
-    logger.LogWarn() << "Client read header error:" << ec.message()
-                     << "request id:" << request_id;
+    ARA_LOG_EVERY_MS(logger.ap_logger(), ara::log::LogLevel::kWarn, 1000)
+        << "Client read header error:" << ec.message()
+        << "request id:" << request_id;
     if (ec == boost::asio::error::broken_pipe) {
       connected_ = false;
       promise_.SetError(ara::core::CoreErrc::broken_pipe);
@@ -119,8 +120,9 @@ void request<NewIpcMessage>::do_read() {
     }
 
   } else {
-    logger.LogWarn() << "Client read header error:" << ec.message()
-                     << "request id:" << request_id;
+    ARA_LOG_EVERY_MS(logger.ap_logger(), ara::log::LogLevel::kWarn, 1000)
+        << "Client read header error:" << ec.message()
+        << "request id:" << request_id;
     if (ec == boost::asio::error::broken_pipe) {
       connected_ = false;
       promise_.SetError(ara::core::CoreErrc::broken_pipe);
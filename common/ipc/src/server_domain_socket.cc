@@ -38,7 +38,7 @@ class ServerDomainSocket<T>::pImpl : public BaseDomainSocket {
   /* This acceptor will be bound to a unix socket when initialized */
   stream_protocol::acceptor acceptor_;
   uint32_t connection_nums_;
-  std::string real_socket_path = "/tmp";
+  SocketPath real_socket_path;
   stream_protocol::endpoint endpoint_;
   ProcessHandlerPtr<T> handler_;
 
@@ -47,10 +47,8 @@ class ServerDomainSocket<T>::pImpl : public BaseDomainSocket {
         ProcessHandlerPtr<T> handler)
       : BaseDomainSocket(n_threads),
         acceptor_(io_context_),
-        real_socket_path(
-            std::string(BaseDomainSocket::getDomainSocketFilePrefixPath()) +
-            "/" + socket_file),
-        endpoint_(real_socket_path),
+        real_socket_path(getDomainSocketFilePath(socket_file)),
+        endpoint_(real_socket_path.c_str()),
         handler_(handler) {
     // remove the socket file before acceptor is bound to it
     std::remove(real_socket_path.c_str());
@@ -10,7 +10,9 @@
  */
 #include <ara/ipc/ipc_message.h>
 #include <ara/ipc/new_ipc_message.h>
+#include <ara/ipc/shared_memory_message.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
 using namespace ara::ipc;
 
@@ -214,6 +216,29 @@ TEST(NewIpcMessage, destroy) {
   EXPECT_EQ(d[29], 'a');
 }
 
+TEST(SharedMemoryMessage, roundtrip) {
+  std::string name = "/ara_ipc_test_" + std::to_string(::getpid());
+  auto created =
+      ara::core::SharedMemorySegment::Create(ara::core::StringView(name.c_str()), 1U << 20U);
+  ASSERT_TRUE(created.HasValue());
+  ara::core::SharedMemorySegment segment = std::move(created).Value();
+  static_cast<char*>(segment.data())[12345] = 'x';
+
+  // Only the descriptor travels, not the megabyte behind it.
+  auto msg = MakeSharedMemoryMessage<NewIpcMessage>(segment.Share());
+  EXPECT_EQ(msg.payload_length(), sizeof(ara::core::SharedMemoryDescriptor));
+  NewIpcMessage received(msg);
+
+  auto descriptor = ReadSharedMemoryDescriptor(received);
+  ASSERT_TRUE(descriptor.HasValue());
+  auto opened = ara::core::SharedMemorySegment::Open(descriptor.Value());
+  ASSERT_TRUE(opened.HasValue());
+  EXPECT_EQ(static_cast<const char*>(opened.Value().data())[12345], 'x');
+
+  NewIpcMessage other(5U, "hello");
+  EXPECT_FALSE(ReadSharedMemoryDescriptor(other).HasValue());
+}
+
 int main(int argc, char** argv) {
   try {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,168 @@
+/*
+ * @Description: Shared main() of the ara::log benchmarks: sets up the log mode
+ * under test and reports per statement latency percentiles.
+ *
+ * Options, besides the Google Benchmark ones:
+ *   --log_mode=remote|console|file|native_file  back-end written to, default remote
+ *   --log_async                                  enable "log_async_mode"
+ * Remote without a DLT daemon measures the application side only: DLT buffers
+ * and drops. Log files go to a new directory in $TMPDIR, default /tmp, which is removed at the end. Use --benchmark_out=<file> --benchmark_out_format=json for
+ * results, console mode also prints the records to stdout.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_ARA_LOG_BENCHMARK_MAIN_H_
+#define AEG_ADAPTIVE_AUTOSAR_ARA_LOG_BENCHMARK_MAIN_H_
+
+#include <benchmark/benchmark.h>
+#include <ftw.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ara/log/logger.h"
+
+namespace ara {
+namespace log {
+namespace benchmark_support {
+
+/**
+ * @brief Per statement latency of one benchmark thread, reported as the counters p50_ns,
+ * p99_ns and p999_ns, averaged over the threads. Includes two clock reads, ~20ns.
+ */
+class LatencySamples final {
+ public:
+  explicit LatencySamples(const benchmark::State& state) {
+    samples_.reserve(static_cast<std::size_t>(state.max_iterations));
+  }
+
+  template <typename Statement>
+  void Measure(const Statement& statement) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    statement();
+    samples_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start).count());
+  }
+
+  void Report(benchmark::State& state) {
+    if (samples_.empty()) {
+      return;
+    }
+    std::sort(samples_.begin(), samples_.end());
+    state.counters["p50_ns"] = benchmark::Counter(Percentile(0.5), benchmark::Counter::kAvgThreads);
+    state.counters["p99_ns"] = benchmark::Counter(Percentile(0.99), benchmark::Counter::kAvgThreads);
+    state.counters["p999_ns"] = benchmark::Counter(Percentile(0.999), benchmark::Counter::kAvgThreads);
+  }
+
+ private:
+  double Percentile(double rank) const {
+    const std::size_t index = static_cast<std::size_t>(rank * static_cast<double>(samples_.size() - 1U));
+    return static_cast<double>(samples_[index]);
+  }
+
+  std::vector<int64_t> samples_;
+};
+
+/**
+ * @brief Directory of the configuration and log files, created by InitializeLogging().
+ */
+inline std::string& LogDirectory() {
+  static std::string directory;
+  return directory;
+}
+
+/**
+ * @brief Remove LogDirectory() with everything in it.
+ */
+inline void RemoveLogDirectory() {
+  if (LogDirectory().empty()) {
+    return;
+  }
+  (void)::nftw(
+      LogDirectory().c_str(), [](const char* path, const struct stat*, int, struct FTW*) { return std::remove(path); },
+      16, FTW_DEPTH | FTW_PHYS);
+  LogDirectory().clear();
+}
+
+/**
+ * @brief Take --log_mode and --log_async out of argv and initialize logging from a configuration
+ * file written for them, so that the native file sink and the async back-end can be selected too.
+ */
+inline bool InitializeLogging(int& argc, char** argv) {
+  std::string mode = "remote";
+  bool async = false;
+  int kept = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--log_mode=", 11U) == 0) {
+      mode = argv[i] + 11;
+    } else if (std::strcmp(argv[i], "--log_async") == 0) {
+      async = true;
+    } else {
+      argv[kept++] = argv[i];
+    }
+  }
+  argc = kept;
+
+  std::string log_mode;
+  bool native = false;
+  if (mode == "remote") {
+    log_mode = "\"kRemote\"";
+  } else if (mode == "console") {
+    log_mode = "\"kConsole\"";
+  } else if ((mode == "file") || (mode == "native_file")) {
+    log_mode = "\"kFile\"";
+    native = (mode == "native_file");
+  } else {
+    std::fprintf(stderr, "unknown --log_mode=%s, expected remote, console, file or native_file\n", mode.c_str());
+    return false;
+  }
+  const char* const temporary = std::getenv("TMPDIR");
+  std::string directory = std::string((temporary != nullptr) ? temporary : "/tmp") + "/ara_log_benchmark.XXXXXX";
+  if (::mkdtemp(&directory[0]) == nullptr) {
+    std::perror("mkdtemp");
+    return false;
+  }
+  LogDirectory() = directory;
+  const std::string config = directory + "/Log_configure.json";
+  std::ofstream(config) << "{\"log_app_id\": \"BNCH\", \"log_default_level\": \"kInfo\", \"log_mode\": [" << log_mode
+                        << "], \"log_file_path\": \"" << directory << "/benchmark.txt\", \"log_file_native_mode\": "
+                        << (native ? "true" : "false") << ", \"log_async_mode\": " << (async ? "true" : "false")
+                        << "}";
+  (void)::setenv("AP_LOG_CONFIG_FILE", config.c_str(), 1);
+  (void)ara::log::Initialize();
+  benchmark::AddCustomContext("log_mode", mode);
+  benchmark::AddCustomContext("log_async", async ? "true" : "false");
+  benchmark::AddCustomContext("log_directory", directory);
+  return true;
+}
+
+}  // namespace benchmark_support
+}  // namespace log
+}  // namespace ara
+
+#define ARA_LOG_BENCHMARK_MAIN()                                                 \
+  int main(int argc, char** argv) {                                              \
+    if (!ara::log::benchmark_support::InitializeLogging(argc, argv)) {           \
+      return 1;                                                                  \
+    }                                                                            \
+    benchmark::Initialize(&argc, argv);                                          \
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {                    \
+      ara::log::benchmark_support::RemoveLogDirectory();                         \
+      return 1;                                                                  \
+    }                                                                            \
+    benchmark::RunSpecifiedBenchmarks();                                         \
+    ara::log::FlushLogs();                                                       \
+    ara::log::benchmark_support::RemoveLogDirectory();                           \
+    benchmark::Shutdown();                                                       \
+    return 0;                                                                    \
+  }
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_ARA_LOG_BENCHMARK_MAIN_H_
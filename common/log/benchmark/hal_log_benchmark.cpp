@@ -0,0 +1,78 @@
+/*
+ * @Description: HAL_LOG_*_FMT against stream HAL_LOG_*(), same record content
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "ara/log/logger.h"
+#include "benchmark_main.h"
+#include "hal_log.h"
+
+ara::log::Logger* hal_logger = NULL;
+
+void hal_log_init(void) { hal_logger = &ara::log::CreateLogger("HAL", "hal log benchmark"); }
+
+namespace {
+
+using ara::log::benchmark_support::LatencySamples;
+
+void BM_HalLogStream(benchmark::State& state) {
+  int32_t value = 0;
+  for (auto _ : state) {
+    HAL_LOG_INFO() << "value:" << value << "ratio:" << 0.5;
+    ++value;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_HalLogFmt(benchmark::State& state) {
+  int32_t value = 0;
+  for (auto _ : state) {
+    HAL_LOG_INFO_FMT("value:{} ratio:{}", value, 0.5);
+    ++value;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_HalLogFmtDisabled(benchmark::State& state) {
+  int32_t value = 0;
+  for (auto _ : state) {
+    HAL_LOG_DEBUG_FMT("value:{} ratio:{}", value, 0.5);
+    ++value;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_HalLogStreamLatency(benchmark::State& state) {
+  LatencySamples latency(state);
+  int32_t value = 0;
+  for (auto _ : state) {
+    latency.Measure([value]() { HAL_LOG_INFO() << "value:" << value << "ratio:" << 0.5; });
+    ++value;
+  }
+  latency.Report(state);
+}
+
+void BM_HalLogFmtLatency(benchmark::State& state) {
+  LatencySamples latency(state);
+  int32_t value = 0;
+  for (auto _ : state) {
+    latency.Measure([value]() { HAL_LOG_INFO_FMT("value:{} ratio:{}", value, 0.5); });
+    ++value;
+  }
+  latency.Report(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_HalLogStream)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_HalLogFmt)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_HalLogFmtDisabled);
+BENCHMARK(BM_HalLogStreamLatency);
+BENCHMARK(BM_HalLogFmtLatency);
+
+ARA_LOG_BENCHMARK_MAIN();
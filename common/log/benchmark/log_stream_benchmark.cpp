@@ -0,0 +1,78 @@
+/*
+ * @Description: cost of a log statement, disabled and enabled
+ *
+ * A disabled statement must not touch the heap: the LogStream and its DLT
+ * record live on the stack and the level check fails before any buffer is
+ * requested from DLT.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "ara/log/logger.h"
+
+namespace {
+
+ara::log::Logger& BenchLogger() {
+  static ara::log::Logger& logger =
+      ara::log::CreateLogger("BNCH", "log stream benchmark", ara::log::LogLevel::kInfo);
+  return logger;
+}
+
+void BM_DisabledLevel(benchmark::State& state) {
+  ara::log::Logger& logger = BenchLogger();
+  int32_t value = 0;
+  for (auto _ : state) {
+    logger.LogDebug() << "value:" << value;
+    ++value;
+  }
+}
+
+void BM_DisabledWithLevel(benchmark::State& state) {
+  ara::log::Logger& logger = BenchLogger();
+  int32_t value = 0;
+  for (auto _ : state) {
+    logger.WithLevel(ara::log::LogLevel::kVerbose) << "value:" << value;
+    ++value;
+  }
+}
+
+// The arguments aren't evaluated at all.
+void BM_DisabledMacro(benchmark::State& state) {
+  ara::log::Logger& logger = BenchLogger();
+  int32_t value = 0;
+  for (auto _ : state) {
+    ARA_LOG_DEBUG(logger) << "value:" << value;
+    ++value;
+  }
+}
+
+void BM_IsEnabled(benchmark::State& state) {
+  ara::log::Logger& logger = BenchLogger();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(logger.IsEnabled(ara::log::LogLevel::kDebug));
+  }
+}
+
+// Includes the DLT back-end, whatever the process is configured for.
+void BM_EnabledLevel(benchmark::State& state) {
+  ara::log::Logger& logger = BenchLogger();
+  int32_t value = 0;
+  for (auto _ : state) {
+    logger.LogInfo() << "value:" << value;
+    ++value;
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_DisabledLevel);
+BENCHMARK(BM_DisabledWithLevel);
+BENCHMARK(BM_DisabledMacro);
+BENCHMARK(BM_IsEnabled);
+BENCHMARK(BM_EnabledLevel);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,77 @@
+/*
+ * @Description: throughput and latency of stream logging, one and more threads
+ *
+ * Run once per back-end, e.g.
+ *   log_throughput_benchmark --log_mode=native_file --benchmark_out=native_file.json
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "ara/log/logger.h"
+#include "benchmark_main.h"
+
+namespace {
+
+using ara::log::benchmark_support::LatencySamples;
+
+ara::log::Logger& BenchLogger() {
+  static ara::log::Logger& logger = ara::log::CreateLogger("THRU", "log throughput benchmark");
+  return logger;
+}
+
+void BM_StreamInfo(benchmark::State& state) {
+  ara::log::Logger& logger = BenchLogger();
+  int32_t value = 0;
+  for (auto _ : state) {
+    logger.LogInfo() << "value:" << value << "ratio:" << 0.5;
+    ++value;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Below the configured kInfo: the cost every thread pays for debug statements in release code.
+void BM_StreamDisabled(benchmark::State& state) {
+  ara::log::Logger& logger = BenchLogger();
+  int32_t value = 0;
+  for (auto _ : state) {
+    logger.LogDebug() << "value:" << value << "ratio:" << 0.5;
+    ++value;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_StreamInfoString(benchmark::State& state) {
+  ara::log::Logger& logger = BenchLogger();
+  const std::string text(static_cast<std::size_t>(state.range(0)), 'x');
+  for (auto _ : state) {
+    logger.LogInfo() << text;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_StreamInfoLatency(benchmark::State& state) {
+  ara::log::Logger& logger = BenchLogger();
+  LatencySamples latency(state);
+  int32_t value = 0;
+  for (auto _ : state) {
+    latency.Measure([&logger, value]() { logger.LogInfo() << "value:" << value << "ratio:" << 0.5; });
+    ++value;
+  }
+  latency.Report(state);
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_StreamInfo)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_StreamDisabled)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_StreamInfoString)->Arg(16)->Arg(256)->Arg(1024);
+BENCHMARK(BM_StreamInfoLatency)->Threads(1)->Threads(4)->UseRealTime();
+
+ARA_LOG_BENCHMARK_MAIN();
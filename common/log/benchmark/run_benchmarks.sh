@@ -0,0 +1,33 @@
+#!/bin/sh
+# Run the ara::log benchmarks against every log mode and keep the results as JSON,
+# <out dir>/<benchmark>-<mode>.json. Two runs compare with Google Benchmark's
+#   tools/compare.py benchmarks <old>/log_throughput_benchmark-file.json <new>/log_throughput_benchmark-file.json
+#
+# Usage: run_benchmarks.sh <directory of the benchmark binaries> [out dir] [benchmark options...]
+set -e
+
+bin=${1:?usage: run_benchmarks.sh <directory of the benchmark binaries> [out dir] [benchmark options...]}
+out=${2:-benchmark_results}
+[ $# -ge 2 ] && shift 2 || shift $#
+
+mkdir -p "$out"
+# Log files of the file modes, removed afterwards.
+TMPDIR=$(mktemp -d)
+export TMPDIR
+trap 'rm -rf "$TMPDIR"' EXIT
+
+run() {
+    name=$1
+    shift
+    echo "$name"
+    # Console mode prints every record, keep stdout away from the terminal.
+    "$@" --benchmark_out="$out/$name.json" --benchmark_out_format=json >"$out/$name.log" 2>&1
+    rm -rf "$TMPDIR"/ara_log_benchmark.*
+}
+
+run log_stream_benchmark "$bin/log_stream_benchmark" "$@"
+for mode in remote console file native_file; do
+    run "log_throughput_benchmark-$mode" "$bin/log_throughput_benchmark" --log_mode=$mode "$@"
+    run "log_throughput_benchmark-$mode-async" "$bin/log_throughput_benchmark" --log_mode=$mode --log_async "$@"
+    run "hal_log_benchmark-$mode" "$bin/hal_log_benchmark" --log_mode=$mode "$@"
+done
@@ -0,0 +1,227 @@
+/*
+ * @Description: Asynchronous back-end of the logging API. Finished records are
+ * queued per thread and written to DLT by a background flusher thread, so the
+ * logging thread never waits for the console, file or daemon output.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_ASYNC_BACKEND_H_
+#define AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_ASYNC_BACKEND_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara/log/logger.h"
+#include "dlt/dlt_user.h"
+
+namespace ara {
+namespace log {
+namespace internal {
+
+/**
+ * @brief What a thread does when its queue is full.
+ */
+enum class OverflowPolicy : int8_t {
+  kBlock = 1,    // wait for the flusher, nothing is lost
+  kDrop,         // discard the record, only the drop counter notices
+  kCountAndDrop  // discard the record, the flusher logs how many were lost
+};
+
+const char* ToString(OverflowPolicy policy) noexcept;
+
+/**
+ * @brief Configuration of the asynchronous back-end, see "log_async_*" in
+ * Log_configure.json.
+ */
+struct AsyncConfig {
+  uint32_t queue_size = 1024U;  // records per thread, rounded up to a power of two
+  OverflowPolicy overflow_policy = OverflowPolicy::kCountAndDrop;
+  uint32_t flush_interval_ms = 10U;
+};
+
+/**
+ * @brief Bounded single-producer/single-consumer queue of finished records.
+ *
+ * A queued record owns its DLT buffer until it is either written with
+ * dlt_user_log_write_finish() or freed.
+ */
+class RecordQueue final {
+ public:
+  explicit RecordQueue(std::size_t capacity);
+
+  RecordQueue(const RecordQueue&) = delete;
+  RecordQueue& operator=(const RecordQueue&) = delete;
+
+  /* Producer side. */
+  bool TryPush(const DltContextData& record) noexcept {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == capacity_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == capacity_) {
+        return false;
+      }
+    }
+    slots_[tail & mask_] = record;
+    tail_.store(tail + 1U, std::memory_order_release);
+    return true;
+  }
+
+  /* Consumer side. */
+  bool TryPop(DltContextData& record) noexcept {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return false;
+      }
+    }
+    record = slots_[head & mask_];
+    head_.store(head + 1U, std::memory_order_release);
+    return true;
+  }
+
+  /* Either side, exact only while the other side is idle. */
+  std::size_t Size() const noexcept {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+  std::size_t Capacity() const noexcept { return capacity_; }
+
+ private:
+  static constexpr std::size_t kCacheLine = 64U;
+
+  const std::size_t capacity_;
+  const std::size_t mask_;
+  std::unique_ptr<DltContextData[]> slots_;
+  // The indices are only ever incremented. Each side keeps its own copy of
+  // the other side's index and refreshes it when the queue looks full/empty,
+  // padded so producer and consumer don't share cache lines.
+  char pad0_[kCacheLine];
+  std::atomic<std::size_t> tail_{0U};
+  std::size_t head_cache_{0U};
+  char pad1_[kCacheLine - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+  std::atomic<std::size_t> head_{0U};
+  std::size_t tail_cache_{0U};
+  char pad2_[kCacheLine - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+};
+
+/**
+ * @brief Per-thread queues drained by one flusher thread.
+ *
+ * Records of one thread stay in order, records of different threads are
+ * interleaved by the flusher. DLT stamps a record when it is written, so in
+ * asynchronous mode the timestamp lags the log statement by up to the flush
+ * interval.
+ */
+class AsyncBackend final {
+ public:
+  /**
+   * @brief The back-end used by LogStream. Never destroyed, LogManager stops
+   * it before the DLT contexts go away.
+   */
+  static AsyncBackend& instance() noexcept;
+
+  AsyncBackend() = default;
+  ~AsyncBackend();
+
+  AsyncBackend(const AsyncBackend&) = delete;
+  AsyncBackend& operator=(const AsyncBackend&) = delete;
+
+  /**
+   * @brief Start the flusher thread.
+   *
+   * @param[in] config    queue and overflow settings
+   * @param[in] reporter  logger for kCountAndDrop reports, may be null
+   * @return false if the thread could not be started or already runs
+   */
+  bool Start(const AsyncConfig& config, const Logger* reporter) noexcept;
+
+  /**
+   * @brief Write all queued records and join the flusher thread. Records
+   * logged afterwards are written synchronously again.
+   */
+  void Stop() noexcept;
+
+  bool IsRunning() const noexcept { return running_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Queue a finished record on the calling thread's queue.
+   *
+   * On success the queue owns the record's buffer and @a record.buffer is
+   * reset, also if the record was dropped by the overflow policy.
+   *
+   * @return false if the back-end is not running, the caller has to write the
+   *         record itself
+   */
+  bool Submit(DltContextData& record) noexcept;
+
+  /**
+   * @brief Wait until every record queued before the call has been written.
+   */
+  void Flush() noexcept;
+
+  /**
+   * @brief Drop counters of all threads that queued records since Start().
+   */
+  std::vector<DroppedLogCount> DroppedCounts() const;
+
+ private:
+  struct Producer {
+    explicit Producer(std::size_t capacity) : queue(capacity) {}
+
+    RecordQueue queue;
+    uint64_t thread_id{0U};
+    std::string thread_name;
+    std::atomic<uint64_t> dropped{0U};
+    std::atomic<bool> exited{false};
+    uint64_t reported{0U};  // flusher only
+  };
+
+  class ThreadSlot;
+
+  Producer* LocalProducer() noexcept;
+  bool Overflow(Producer& producer, DltContextData& record) noexcept;
+  void Wake() noexcept;
+  void Run() noexcept;
+  void Drain(const std::vector<std::shared_ptr<Producer>>& producers) noexcept;
+  void ReportDrops(Producer& producer) noexcept;
+  void Retire(const Producer& producer);
+
+  AsyncConfig config_;
+  const Logger* reporter_{nullptr};
+
+  std::atomic<bool> running_{false};
+  std::atomic<bool> stopping_{false};
+  std::atomic<uint32_t> in_flight_{0U};  // producers inside Submit()
+  std::mutex control_mutex_;             // Start()/Stop()
+  std::thread flusher_;
+
+  mutable std::mutex producers_mutex_;
+  std::vector<std::shared_ptr<Producer>> producers_;
+  std::vector<DroppedLogCount> retired_;  // exited threads that dropped records
+  std::atomic<uint64_t> version_{0U};     // bumped whenever producers_ changes
+  std::atomic<uint64_t> epoch_{0U};       // bumped by Start(), older thread queues re-register
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable flushed_;
+  std::condition_variable drained_;  // the flusher passed, for producers blocked on a full queue
+  bool wake_requested_{false};
+  uint32_t blocked_{0U};
+  uint64_t flush_requested_{0U};
+  uint64_t flush_done_{0U};
+};
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_ASYNC_BACKEND_H_
@@ -0,0 +1,74 @@
+/*
+ * @Description: Watches the log configuration file and reports changes, so
+ * that levels can be reloaded without a restart.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_CONFIG_WATCHER_H_
+#define AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_CONFIG_WATCHER_H_
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace ara {
+namespace log {
+namespace internal {
+
+/**
+ * @brief Calls back on a background thread when a file has been written or replaced.
+ *
+ * On Linux the directory of the file is watched with inotify, which also catches editors and
+ * deployment tools that write a new file and rename it over the old one. Elsewhere the file is
+ * checked once a second. Bursts of changes are reported once, after they settled, and only if
+ * the modification time, size or inode of the file differ from the last report.
+ */
+class ConfigWatcher final {
+ public:
+  ConfigWatcher() = default;
+  ~ConfigWatcher();
+
+  ConfigWatcher(const ConfigWatcher&) = delete;
+  ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+  bool Start(const std::string& path, std::function<void()> changed) noexcept;
+
+  /**
+   * @brief Stop the thread, waiting for a running callback.
+   */
+  void Stop() noexcept;
+
+  bool IsRunning() const noexcept { return worker_.joinable(); }
+
+ private:
+  struct Signature {
+    int64_t mtime_ns = -1;
+    off_t size = -1;
+    ino_t inode = 0;
+
+    bool operator==(const Signature& other) const noexcept {
+      return (mtime_ns == other.mtime_ns) && (size == other.size) && (inode == other.inode);
+    }
+  };
+
+  Signature Stat() const noexcept;
+  bool Wait(int timeout_ms, bool& notified) noexcept;
+  void Run() noexcept;
+
+  std::string path_;
+  std::function<void()> changed_;
+  Signature last_;
+  int inotify_ = -1;
+  int wake_[2] = {-1, -1};  // pipe, written by Stop()
+  std::thread worker_;
+};
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_CONFIG_WATCHER_H_
@@ -0,0 +1,106 @@
+/*
+ * @Description: Lock free lookup of registered loggers by context ID, the read
+ * path of LogManager::createLogContext().
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_CONTEXT_TABLE_H_
+#define AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_CONTEXT_TABLE_H_
+
+#include <ara/core/string_view.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ara {
+namespace log {
+
+class Logger;
+
+namespace internal {
+
+/**
+ * @brief Fixed size, open addressed table from a context ID packed into 32 bits to its logger.
+ *
+ * Entries are only added, never changed or removed, as loggers live as long as the LogManager.
+ * Find() is wait free and may run concurrently with Insert(); Insert() calls must be serialized
+ * by the caller. A slot's logger is stored before its key is published, so a reader that sees
+ * the key also sees the logger.
+ */
+class ContextTable final {
+ public:
+  static constexpr std::size_t kCapacity = 512U;
+  // Inserts fail beyond this, the caller keeps such contexts elsewhere; keeps probe chains short.
+  static constexpr std::size_t kMaxEntries = kCapacity * 3U / 4U;
+
+  ContextTable() noexcept = default;
+
+  ContextTable(const ContextTable&) = delete;
+  ContextTable& operator=(const ContextTable&) = delete;
+
+  /**
+   * @brief Pack @a id into @a key. False for IDs the table can not hold: empty, longer than four
+   * characters or containing '\0'.
+   */
+  static bool Pack(const ara::core::StringView& id, uint32_t& key) noexcept {
+    if (id.empty() || (id.size() > sizeof(key)) || (std::memchr(id.data(), '\0', id.size()) != nullptr)) {
+      return false;
+    }
+    key = 0U;
+    std::memcpy(&key, id.data(), id.size());
+    return true;
+  }
+
+  Logger* Find(uint32_t key) const noexcept {
+    for (std::size_t i = Home(key), probes = 0U; probes < kCapacity; i = (i + 1U) % kCapacity, ++probes) {
+      const uint32_t slot_key = slots_[i].key.load(std::memory_order_acquire);
+      if (slot_key == key) {
+        return slots_[i].logger.load(std::memory_order_relaxed);
+      }
+      if (slot_key == 0U) {
+        return nullptr;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Add @a logger under @a key, which must not be in the table yet. False if full.
+   */
+  bool Insert(uint32_t key, Logger* logger) noexcept {
+    if (entries_ >= kMaxEntries) {
+      return false;
+    }
+    std::size_t i = Home(key);
+    while (slots_[i].key.load(std::memory_order_relaxed) != 0U) {
+      i = (i + 1U) % kCapacity;
+    }
+    slots_[i].logger.store(logger, std::memory_order_relaxed);
+    slots_[i].key.store(key, std::memory_order_release);
+    ++entries_;
+    return true;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint32_t> key{0U};  // 0: empty
+    std::atomic<Logger*> logger{nullptr};
+  };
+
+  static std::size_t Home(uint32_t key) noexcept {
+    // Fibonacci hashing, IDs differ in few bits.
+    return static_cast<std::size_t>((key * 2654435769U) >> 23U) % kCapacity;
+  }
+
+  Slot slots_[kCapacity];
+  std::size_t entries_ = 0U;  // written by Insert() only
+};
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_CONTEXT_TABLE_H_
@@ -0,0 +1,124 @@
+/*
+ * @Description: Crash surviving copy of the latest records. Every record is also copied into a
+ * ring in POSIX shared memory, "/dev/shm/ara-log-<app ID>", which outlives the process. A clean
+ * exit removes it; after a crash the next start writes what the ring holds to a DLT storage
+ * file, and ara-log-decoder reads the ring as it is.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_CRASH_RING_H_
+#define AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_CRASH_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "dlt/dlt_user.h"
+
+namespace ara {
+namespace log {
+namespace internal {
+
+/**
+ * @brief Configuration of the crash ring, taken from the "log_crash_ring_*" settings.
+ */
+struct CrashRingConfig {
+  std::string app_id;        // names the shared memory object
+  uint32_t size = 1048576U;  // bytes of records, rounded up to a power of two
+  std::string directory;     // where records of an unclean exit are written
+};
+
+/**
+ * @brief Layout of the shared memory, also read by tools/log_decoder.cpp.
+ *
+ * A header, then slots of kCrashRingSlotSize bytes. A record takes consecutive slots, wrapping at
+ * the end: a slot header, then the record as in a DLT storage file. The slot header's index is
+ * stored last, a slot whose index isn't its own position in the ring holds no complete record.
+ */
+constexpr char kCrashRingMagic[8] = {'A', 'R', 'A', 'R', 'I', 'N', 'G', '1'};
+constexpr std::size_t kCrashRingSlotSize = 64U;
+constexpr uint32_t kCrashRingCheck = 0x41524C52U;
+
+struct CrashRingHeader {
+  char magic[8];
+  uint32_t slot_size;
+  int32_t pid;                 // of the writing process, which holds a flock() on the object
+  uint64_t slot_count;         // power of two
+  std::atomic<uint64_t> head;  // slots ever reserved
+  char app_id[DLT_ID_SIZE];
+  char reserved[28];
+};
+
+struct CrashRingSlot {
+  std::atomic<uint64_t> index;  // slots reserved before this record
+  uint32_t size;                // of the storage record
+  uint32_t check;               // CrashRingCheck(index, size)
+};
+
+static_assert(sizeof(CrashRingHeader) == kCrashRingSlotSize, "header is one slot");
+static_assert(sizeof(CrashRingSlot) == 16U, "slot header is 16 bytes");
+
+constexpr uint32_t CrashRingCheck(uint64_t index, uint32_t size) noexcept {
+  return static_cast<uint32_t>(index) ^ static_cast<uint32_t>(index >> 32U) ^ size ^ kCrashRingCheck;
+}
+
+/**
+ * @brief Append the complete records of the ring image @a data, oldest first, to @a records as a
+ * DLT storage file. Returns how many there were.
+ */
+std::size_t ReadCrashRing(const void* data, std::size_t size, std::string& records);
+
+/**
+ * @brief The ring of this process.
+ *
+ * Write() is lock free: it reserves slots with one atomic add and copies the record. Records
+ * that would take more than a quarter of the ring are not copied.
+ */
+class CrashRing final {
+ public:
+  static CrashRing& instance() noexcept;
+
+  /**
+   * @brief Write the records a crashed run left to "<directory>/<app ID>_crash_<YYYYmmdd-HHMMSS>.dlt",
+   * returned in @a recovered, then create a new ring. Fails if a running process with the same
+   * application ID holds the ring.
+   */
+  bool Start(const CrashRingConfig& config, std::string& recovered) noexcept;
+
+  /**
+   * @brief Remove the ring, nothing is recovered from a clean exit. The mapping stays for
+   * threads still writing.
+   */
+  void Stop() noexcept;
+
+  bool IsRunning() const noexcept { return ring_.load(std::memory_order_acquire) != nullptr; }
+
+  /**
+   * @brief Copy @a record; called when the record is finished, before it is queued or written.
+   */
+  void Write(const DltContextData& record) noexcept;
+
+  /**
+   * @brief Name of the shared memory object, "/ara-log-<app ID>".
+   */
+  const std::string& Name() const noexcept { return name_; }
+
+ private:
+  CrashRing() = default;
+
+  bool Recover(const std::string& directory, std::string& recovered) noexcept;
+
+  std::atomic<CrashRingHeader*> ring_{nullptr};
+  std::mutex control_mutex_;
+  std::string name_;
+  int fd_ = -1;  // locked while the ring is ours
+};
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_CRASH_RING_H_
@@ -0,0 +1,103 @@
+/*
+ * @Description: Compression of rotated log files on a low priority background
+ * thread with a bounded CPU share.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_FILE_COMPRESSOR_H_
+#define AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_FILE_COMPRESSOR_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ara {
+namespace log {
+namespace internal {
+
+/**
+ * @brief How rotated log files are compressed.
+ */
+enum class FileCompression : int8_t {
+  kNone = 0,  // keep them as they are
+  kGzip,      // "<file>.gz", zlib
+  kZstd       // "<file>.zst", needs a build with ARA_LOG_WITH_ZSTD, kGzip otherwise
+};
+
+const char* ToString(FileCompression compression) noexcept;
+
+/**
+ * @brief Suffix of files compressed with @a compression, "" for kNone.
+ */
+const char* CompressedExtension(FileCompression compression) noexcept;
+
+/**
+ * @brief @a compression if this build supports it, else the one used instead.
+ */
+FileCompression SupportedCompression(FileCompression compression) noexcept;
+
+/**
+ * @brief Compresses queued files one after another into "<file>.gz"/"<file>.zst" and removes
+ * the original.
+ *
+ * The thread runs at the lowest priority and sleeps between chunks so that its CPU time stays
+ * below the configured share of the elapsed time. The output is written under a hidden name
+ * and renamed when complete, an interrupted file stays uncompressed.
+ */
+class FileCompressor final {
+ public:
+  FileCompressor() = default;
+  ~FileCompressor();
+
+  FileCompressor(const FileCompressor&) = delete;
+  FileCompressor& operator=(const FileCompressor&) = delete;
+
+  /**
+   * @brief Start the thread. @a done runs on it after each file, e.g. to apply the retention.
+   */
+  bool Start(FileCompression compression, uint32_t cpu_percent, std::function<void()> done) noexcept;
+
+  /**
+   * @brief Stop the thread, abandoning the file being compressed and the queued ones.
+   */
+  void Stop() noexcept;
+
+  void Enqueue(const std::string& path) noexcept;
+
+  /**
+   * @brief Wait until the queue is empty.
+   */
+  void Sync() noexcept;
+
+  /**
+   * @brief Compress @a path on the calling thread, without throttling.
+   */
+  bool Compress(const std::string& path) noexcept;
+
+ private:
+  bool Throttle(int64_t cpu_ns, int64_t wall_ns) noexcept;
+  void Run() noexcept;
+
+  FileCompression compression_ = FileCompression::kNone;
+  uint32_t cpu_percent_ = 100U;
+  std::function<void()> done_;
+
+  std::mutex mutex_;
+  std::deque<std::string> queue_;
+  bool busy_ = false;
+  bool stopping_ = false;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  std::thread worker_;
+};
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_FILE_COMPRESSOR_H_
@@ -0,0 +1,240 @@
+/*
+ * @Description: Native file sink of the logging API. Records are copied into a
+ * preallocated, memory mapped log file; the next file is created in the
+ * background, so a rotation on the logging path only swaps two mappings.
+ * Replaces the DLT file mode when "log_file_native_mode" is enabled.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_FILE_SINK_H_
+#define AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_FILE_SINK_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara/log/common.h"
+#include "ara/log/file_compressor.h"
+#include "dlt/dlt_user.h"
+
+namespace ara {
+namespace log {
+namespace internal {
+
+/**
+ * @brief Configuration of the file sink, taken from the "log_file_*" settings.
+ */
+struct FileSinkConfig {
+  std::string directory;                                 // existing, writable directory
+  std::string file_name;                                 // "<name>.txt" or "<name>.dlt"
+  FileEncode file_encode = FileEncode::kAscii;           // text lines or DLT storage records
+  FileSaveMode file_save_mode = FileSaveMode::kSize;     // when to start a new file
+  uint32_t max_files = 5U;                               // files kept, 0 keeps all
+  uint32_t file_size = 67108864U;                        // bytes per file, also caps the time based modes
+  std::string app_id;                                    // application ID written with every record
+  FileCompression compression = FileCompression::kNone;  // of the rotated files
+  uint32_t compress_cpu_percent = 10U;                   // CPU share of the compression thread
+  bool forward_to_dlt = true;                            // console or remote output wants the records too
+};
+
+/**
+ * @brief Storage, standard and extended header of a record in a DLT storage file.
+ */
+constexpr std::size_t kStorageRecordHeaderSize = 16U + 12U + 10U;
+
+/**
+ * @brief DLT timestamp, 0.1 ms since boot.
+ */
+uint32_t Uptime() noexcept;
+
+/**
+ * @brief Payload bytes of @a record that fit one DLT message.
+ */
+std::size_t StoragePayloadSize(const DltContextData& record) noexcept;
+
+/**
+ * @brief Write the headers of @a record as a DLT storage file has them, kStorageRecordHeaderSize
+ * bytes, followed in the file by StoragePayloadSize() bytes of payload. See tools/log_decoder.cpp.
+ */
+void EncodeStorageHeader(const DltContextData& record, const char (&app_id)[DLT_ID_SIZE], const struct timespec& wall,
+                         uint32_t uptime, char* out) noexcept;
+
+/**
+ * @brief Set of rotating log files "<name>_<YYYYmmdd-HHMMSS><ext>" in one directory.
+ *
+ * Each file is preallocated to @c FileSinkConfig::file_size and mapped; Write() is a copy into the
+ * mapping. A background thread creates and maps the next file ahead of time under a hidden name,
+ * renames it once it is in use, truncates rotated files to their content, hands them to the
+ * @c FileCompressor and deletes the oldest ones beyond @c FileSinkConfig::max_files, compressed
+ * or not.
+ *
+ * After a crash the last file keeps its preallocated size, the unwritten tail reads as zeros.
+ */
+class RotatingFile final {
+ public:
+  RotatingFile() = default;
+  ~RotatingFile();
+
+  RotatingFile(const RotatingFile&) = delete;
+  RotatingFile& operator=(const RotatingFile&) = delete;
+
+  /**
+   * @brief Create the first file and start the background thread.
+   */
+  bool Open(const FileSinkConfig& config) noexcept;
+
+  /**
+   * @brief Finish every file and stop the background thread.
+   */
+  void Close() noexcept;
+
+  /**
+   * @brief Append @a size bytes, rotating first if the current file is full or @a now is in a
+   * later period of a time based save mode. Records larger than a file are cut.
+   */
+  void Write(const char* data, std::size_t size, time_t now) noexcept;
+
+  /**
+   * @brief Wait until the background threads have renamed, finished and compressed the rotated
+   * files and the next file is ready.
+   */
+  void Sync() noexcept;
+
+  /**
+   * @brief Path of the file written to, the hidden temporary name until the background thread
+   * has given it its final name.
+   */
+  std::string CurrentPath() const;
+
+ private:
+  struct Segment {
+    int fd = -1;
+    char* map = nullptr;
+    std::size_t used = 0U;
+    uint64_t id = 0U;
+    std::string path;
+  };
+
+  struct Rename {
+    uint64_t id;
+    std::string from;
+    time_t opened;
+  };
+
+  struct LogFile {
+    std::string stamp;
+    unsigned long sequence;
+    std::string path;
+    bool compressed;
+  };
+
+  bool Prepare(Segment& segment) const noexcept;
+  void Finish(Segment& segment) const noexcept;
+  void Discard(Segment& segment) const noexcept;
+  bool Rotate(time_t now) noexcept;
+  time_t NextRotation(time_t now) const noexcept;
+  std::string TemporaryPath(uint64_t id) const;
+  std::string RenameFile(const Rename& job) noexcept;
+  void Renamed(uint64_t id, const std::string& path) noexcept;
+  std::vector<LogFile> ListFiles() const;
+  void RemoveOldFiles(const std::string& keep = std::string()) const noexcept;
+  void CleanUp() const noexcept;
+  void CompressLeftovers() noexcept;
+  void Run() noexcept;
+
+  FileSinkConfig config_;
+  std::string stem_;       // directory and file name without extension
+  std::string extension_;  // ".txt", ".dlt" or what the configured name ends with
+  std::size_t capacity_ = 0U;
+  std::string last_stamp_;  // of the last renamed file, which got suffix "_<last_sequence_>"
+  uint32_t last_sequence_ = 0U;
+
+  mutable std::mutex remove_mutex_;  // taken before mutex_, a file isn't renamed while files are removed
+  mutable std::mutex mutex_;
+  Segment current_;
+  Segment standby_;              // next file, created and mapped ahead of time
+  std::deque<Segment> retired_;  // rotated out, truncated and closed by the background thread
+  std::deque<Rename> renames_;   // activated files still carrying their temporary name
+  uint64_t next_id_ = 0U;
+  time_t rotate_at_ = 0;
+  bool prepare_failed_ = false;
+  bool busy_ = false;
+  bool stopping_ = false;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  std::thread worker_;
+  FileCompressor compressor_;
+};
+
+/**
+ * @brief Writes finished records to a @c RotatingFile, as text lines (kAscii) or DLT storage
+ * records (kBinary).
+ */
+class FileSink final {
+ public:
+  static FileSink& instance() noexcept;
+
+  bool Start(const FileSinkConfig& config) noexcept;
+  void Stop() noexcept;
+
+  bool IsRunning() const noexcept { return running_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Whether the records also go to DLT, for its console or remote output.
+   */
+  bool ForwardsToDlt() const noexcept { return forward_to_dlt_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Append @a record; called right before it is handed to dlt_user_log_write_finish().
+   */
+  void Write(const DltContextData& record) noexcept;
+
+  RotatingFile& file() noexcept { return file_; }
+
+ private:
+  FileSink() = default;
+
+  std::atomic<bool> running_{false};
+  std::atomic<bool> forward_to_dlt_{true};
+  std::mutex control_mutex_;
+  FileEncode encode_ = FileEncode::kAscii;
+  char app_id_[DLT_ID_SIZE] = {};
+  RotatingFile file_;
+};
+
+/**
+ * @brief Last step of every record: the native file sink if running, then DLT unless the sink is
+ * the only output. Returns whether DLT got the record.
+ */
+inline bool WriteRecord(DltContextData& record) noexcept {
+  FileSink& sink = FileSink::instance();
+  if (sink.IsRunning()) {
+    sink.Write(record);
+    if (!sink.ForwardsToDlt()) {
+      // Counted like DLT does when it sends the record.
+      if (record.handle != nullptr) {
+        ++record.handle->mcnt;
+      }
+      free(record.buffer);
+      record.buffer = nullptr;
+      return false;
+    }
+  }
+  (void)dlt_user_log_write_finish(&record);
+  return true;
+}
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_PRIVATE_ARA_LOG_FILE_SINK_H_
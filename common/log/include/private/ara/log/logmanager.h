@@ -22,6 +22,9 @@
 #include <utility>
 
 #include "ara/log/common.h"
+#include "ara/log/config_watcher.h"
+#include "ara/log/context_table.h"
+#include "ara/log/file_compressor.h"
 #include "ara/log/logger.h"
 #include <nlohmann/json.hpp>
 
@@ -36,6 +39,31 @@ namespace log {
 
 class LogStream;
 
+namespace internal {
+/**
+ * @brief Reload the cached reporting level of every logger from DLT, after the
+ * application wide level was changed.
+ */
+void RefreshLogLevels() noexcept;
+
+/**
+ * @brief Set the reporting level of @a logger's DLT context and its cached copy.
+ * A later change from the DLT viewer still applies.
+ */
+void SetLogLevel(Logger& logger, LogLevel level) noexcept;
+
+/**
+ * @brief Record whether DLT runs in non-verbose mode, i.e. whether modeled
+ * messages are sent with their message ID.
+ */
+void SetModeledMessageMode(bool modeled) noexcept;
+
+/**
+ * @brief Whether DLT runs in non-verbose mode, see SetModeledMessageMode().
+ */
+bool ModeledMessageMode() noexcept;
+}  // namespace internal
+
 /**
  * Class holding the main logic of the logging API.
  * It handles the de-/registration of the application against the DLT back-end
@@ -68,7 +96,8 @@ class LogManager final {
    * deregistration. It also checks weather requested ID isn't created yet, and
    * if so it returns the already available logger as reference.
    *
-   * Implementation is multi-thread safe via serialization.
+   * Implementation is multi-thread safe. Looking up an already registered
+   * ID of up to four characters takes no lock, registrations are serialized.
    *
    * @param[in] ctxId             The _up to four-character_ ID
    * @param[in] ctxDescription    Some description
@@ -113,6 +142,21 @@ class LogManager final {
                             const ara::log::internal::FileModeDescription&
                                 fileModeDescription) noexcept;
 
+  /**
+   * Reads the configuration file again and applies "log_default_level" and
+   * "log_context_levels" to all contexts; other settings need a restart.
+   * Called by the configuration watcher when "log_config_watch" is enabled.
+   *
+   * @return false if not initialized or the file can not be parsed, the
+   * current levels are then kept
+   */
+  bool ReloadConfiguration() noexcept;
+
+  /**
+   * The logger of the logging API itself, context "INTM".
+   */
+  Logger& internalLogger() noexcept { return *g_logINT; }
+
  private:
   /**
    * Fetches the connection state from the DLT back-end of a possibly available
@@ -128,11 +172,28 @@ class LogManager final {
   std::mutex g_mutex_initialize;
   std::atomic<bool> is_initialized{false};
   std::unordered_map<std::string, std::unique_ptr<Logger>> g_logContexts;
+  // Lock free index of g_logContexts for IDs of up to four characters, filled under g_mutex_logContexts.
+  ara::log::internal::ContextTable context_table;
   const ara::core::StringView internCtxId = "INTM";
   const ara::core::StringView internCtxDesc = "logging API internal context";
-  ara::log::LogLevel default_app_level = ara::log::LogLevel::kWarn;
+  std::atomic<ara::log::LogLevel> default_app_level{ara::log::LogLevel::kWarn};
+  // "log_context_levels", override the level of the contexts with these IDs.
+  std::unordered_map<std::string, LogLevel> context_levels;
+  // Levels given to createLogContext() instead of the application default, restored by a reload.
+  std::unordered_map<std::string, LogLevel> code_levels;
+  std::string config_path;  // file read by LoadConfigurations()
+  ara::log::internal::ConfigWatcher config_watcher;
+  // Write kFile through the mmap backed FileSink instead of DLT, "log_file_native_mode".
+  bool native_file_mode = false;
+  ara::log::internal::FileCompression file_compression = ara::log::internal::FileCompression::kNone;
+  uint32_t file_compress_cpu_percent = 10U;
   std::unique_ptr<Logger> g_logINT;
   nlohmann::json LoadConfigurations() noexcept;
+  bool ParseLogLevel(const nlohmann::json& value, LogLevel& level);
+  void ParseContextLevels(const nlohmann::json& js, std::unordered_map<std::string, LogLevel>& levels);
+  // Gives the contexts in context_levels their level, with @a all also every other context its
+  // level from code_levels or the default.
+  void ApplyLogLevels(bool all) noexcept;
 
   LogManager();
 
@@ -0,0 +1,129 @@
+/*
+ * @Description: Encoding of structured fields, LogStream::With(). A field is one DLT raw argument:
+ * tag, type code, 32-bit key ID and the value in its native binary form, so neither the key text
+ * nor a formatted value is stored per record. tools/log_decoder exports them as JSON lines.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOG_LOG_FIELD_H_
+#define AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOG_LOG_FIELD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ara {
+namespace log {
+namespace internal {
+
+/**
+ * @brief Layout of a field: kFieldTag, type code, key ID and value, in host byte order.
+ *
+ * Type codes are those of modeled message arguments. A string value ('s') is the characters
+ * without NUL, cut to kMaxFieldStringSize.
+ */
+constexpr uint8_t kFieldTag = 0xA5U;
+constexpr std::size_t kFieldHeaderSize = 6U;
+constexpr std::size_t kMaxFieldStringSize = 256U;
+
+/**
+ * @brief Key ID of a field, the 32-bit FNV-1a hash of the key. The decoder finds the keys by
+ * hashing the strings of the binary, so keys should be literals.
+ */
+constexpr uint32_t FieldKeyId(const char* key, std::size_t size) noexcept {
+  uint32_t hash = 2166136261U;
+  for (std::size_t i = 0U; i < size; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(key[i])) * 16777619U;
+  }
+  return hash;
+}
+
+/**
+ * @brief Type codes of integer arguments and fields, by size and signedness.
+ */
+template <std::size_t Size, bool Signed>
+struct IntegerArgCode;
+template <>
+struct IntegerArgCode<1U, true> {
+  static constexpr char value = 'c';
+  using Wire = int8_t;
+};
+template <>
+struct IntegerArgCode<2U, true> {
+  static constexpr char value = 'h';
+  using Wire = int16_t;
+};
+template <>
+struct IntegerArgCode<4U, true> {
+  static constexpr char value = 'i';
+  using Wire = int32_t;
+};
+template <>
+struct IntegerArgCode<8U, true> {
+  static constexpr char value = 'l';
+  using Wire = int64_t;
+};
+template <>
+struct IntegerArgCode<1U, false> {
+  static constexpr char value = 'C';
+  using Wire = uint8_t;
+};
+template <>
+struct IntegerArgCode<2U, false> {
+  static constexpr char value = 'H';
+  using Wire = uint16_t;
+};
+template <>
+struct IntegerArgCode<4U, false> {
+  static constexpr char value = 'I';
+  using Wire = uint32_t;
+};
+template <>
+struct IntegerArgCode<8U, false> {
+  static constexpr char value = 'L';
+  using Wire = uint64_t;
+};
+
+/**
+ * @brief Maps a numeric field value to its type code and wire type. Strings have their own
+ * LogStream::With() overloads.
+ */
+template <typename T, typename Enable = void>
+struct FieldValue {
+  static_assert(sizeof(T) == 0U, "LogStream::With() supports bool, integers, enums, float, double and strings only");
+};
+
+template <>
+struct FieldValue<bool> {
+  static constexpr char kCode = 'b';
+  using Wire = uint8_t;
+};
+
+template <typename T>
+struct FieldValue<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+  static constexpr char kCode = IntegerArgCode<sizeof(T), std::is_signed<T>::value>::value;
+  using Wire = typename IntegerArgCode<sizeof(T), std::is_signed<T>::value>::Wire;
+};
+
+template <typename T>
+struct FieldValue<T, typename std::enable_if<std::is_enum<T>::value>::type>
+    : FieldValue<typename std::underlying_type<T>::type> {};
+
+template <>
+struct FieldValue<float> {
+  static constexpr char kCode = 'f';
+  using Wire = float;
+};
+
+template <>
+struct FieldValue<double> {
+  static constexpr char kCode = 'd';
+  using Wire = double;
+};
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOG_LOG_FIELD_H_
@@ -17,6 +17,7 @@
 #include <ara/core/string.h>
 #include <ara/core/string_view.h>
 #include "ara/log/common.h"
+#include "ara/log/log_field.h"
 #include "dlt/dlt_user.h"
 
 #include <chrono>
@@ -113,6 +114,16 @@ class LogStream final {
    */
   LogStream(const LogLevel logLevel, Logger& logger) noexcept;
 
+  /**
+   * @brief Creates a modeled (DLT non-verbose) message stream object.
+   *
+   * The message starts with @a msgId, the arguments are written without type info. Only
+   * instantiated for uint32_t, see ARA_LOG_MODELED() in "ara/log/modeled_message.h".
+   *
+   * @param[in] msgId     The message ID
+   * @param[in] logLevel  The severity level of this message
+   * @param[in] logger    The associated logger context
+   */
   template <typename T = uint32_t>
   LogStream(const T& msgId, const LogLevel logLevel, Logger& logger) noexcept;
 
@@ -127,14 +138,12 @@ class LogStream final {
    * The big five.
    *
    * We actually don't want this class movable or copyable, but enforce RVO instead.
-   * Since "Guaranteed copy elision" will be supported up from C++17, declaring the move ctor
-   * without definition is a workaround and is necessary because we have a custom dtor.
-   * With the missing move ctor implementation, explicit calls of std::move() on objects
-   * of this class, will be prevented by a compile error.
+   * Since "Guaranteed copy elision" will be supported up from C++17, the move ctor is still
+   * needed in C++14. It takes over the pending record and leaves @a log_stream disabled.
    */
   LogStream(const LogStream& log_stream) = delete;
   LogStream& operator=(const LogStream& log_stream) = delete;
-  LogStream(LogStream&& log_stream) noexcept = default;
+  LogStream(LogStream&& log_stream) noexcept;
   LogStream& operator=(LogStream&& log_stream) = delete;
 
   /**
@@ -338,11 +347,51 @@ class LogStream final {
    * @uptrace{SWS_LOG_00129}
    */
   LogStream& WithLocation(ara::core::StringView file, int line) noexcept;
+
+  /**
+   * @brief Add the structured field @a key = @a value, e.g. `.With("lat_us", latency)`.
+   *
+   * Written as one raw argument with the hash of the key and the value in its binary form, see
+   * "ara/log/log_field.h", so a field costs a copy of the value. `ara-log-decoder -j` exports
+   * the fields as JSON. Values are bool, integers, enums, float, double and strings, strings are
+   * cut to 256 bytes. For verbose messages only.
+   */
+  template <std::size_t N, typename T,
+            typename = typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type>
+  LogStream& With(const char (&key)[N], const T& value) noexcept {
+    using Field = internal::FieldValue<T>;
+    const typename Field::Wire wire = static_cast<typename Field::Wire>(value);
+    return LogField(internal::FieldKeyId(key, N - 1U), Field::kCode, &wire, sizeof(wire));
+  }
+
+  template <std::size_t N>
+  LogStream& With(const char (&key)[N], const char* const value) noexcept {
+    return With(key, ara::core::StringView(value == nullptr ? "" : value));
+  }
+
+  template <std::size_t N>
+  LogStream& With(const char (&key)[N], const std::string& value) noexcept {
+    return LogField(internal::FieldKeyId(key, N - 1U), 's', value.data(), value.size());
+  }
+
+  template <std::size_t N, typename Allocator>
+  LogStream& With(const char (&key)[N], const ara::core::BasicString<Allocator>& value) noexcept {
+    return LogField(internal::FieldKeyId(key, N - 1U), 's', value.data(), value.size());
+  }
+
+  template <std::size_t N>
+  LogStream& With(const char (&key)[N], const ara::core::StringView value) noexcept {
+    return LogField(internal::FieldKeyId(key, N - 1U), 's', value.data(), value.size());
+  }
   /// @}
 
  private:
   DltReturnValue logRet_;
-  std::unique_ptr<DltContextData> logLocalData_;
+  // Kept inline, a LogStream lives on the caller's stack and a statement
+  // allocates nothing but the DLT buffer of an enabled record.
+  DltContextData logLocalData_;
+
+  LogStream& LogField(uint32_t keyId, char code, const void* value, std::size_t size) noexcept;
 
   LogStream& LogArgument(const ara::log::Argument<ara::core::String>& arg) noexcept;
 
@@ -13,9 +13,13 @@
 #ifndef AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOGGER_H
 #define AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOGGER_H
 
+#include <atomic>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include "ara/log/log_stream.h"
+#include "ara/log/rate_limiter.h"
 
 #include <ara/core/result.h>
 #include <ara/core/string_view.h>
@@ -26,6 +30,8 @@ class Logger final {
  private:
   class Impl;
   std::unique_ptr<Impl> _pImpl;
+  // Copy of the DLT context's reporting level, kept current by refreshLogLevel().
+  std::atomic<int8_t> logLevel_{static_cast<int8_t>(LogLevel::kOff)};
 
  public:
   /**
@@ -130,7 +136,17 @@ class Logger final {
    * @uptrace{SWS_LOG_00007}
    * @uptrace{SWS_LOG_00070}
    */
-  bool IsEnabled(LogLevel logLevel) const noexcept;
+  bool IsEnabled(LogLevel logLevel) const noexcept {
+    return (logLevel != LogLevel::kOff) &&
+           (static_cast<int8_t>(logLevel) <= logLevel_.load(std::memory_order_relaxed));
+  }
+  /**
+   * @brief Re-read the reporting level from the DLT context into the cache used by @c IsEnabled().
+   *
+   * Called on registration, after @c InitLogging() and whenever DLT reports a level change
+   * for the context, so there is no need to call it from application code.
+   */
+  void refreshLogLevel() noexcept;
   /**
    * @brief Hide direct call and unregister any relevant backend;
    *
@@ -238,6 +254,47 @@ Argument<T> Arg(T&& arg, const char* name = nullptr, const char* unit = nullptr)
 
 void RegisterConnectionStateHandler(std::function<void(ClientState)> callback) noexcept;
 
+/**
+ * @brief Records a thread lost because its asynchronous log queue was full.
+ */
+struct DroppedLogCount {
+  uint64_t thread_id;       ///< kernel thread id of the logging thread
+  std::string thread_name;  ///< name of the thread when it logged first
+  uint64_t dropped;         ///< records discarded by the overflow policy
+};
+
+/**
+ * @brief Drop counters of the asynchronous back-end, one per thread that logged.
+ *
+ * Threads that already exited are still reported if they dropped records.
+ * Empty unless "log_async_mode" is enabled in the configuration.
+ */
+std::vector<DroppedLogCount> GetDroppedLogCounts() noexcept;
+
+/**
+ * @brief Wait until the asynchronous back-end has written every record logged
+ * so far. Returns immediately in synchronous mode.
+ */
+void FlushLogs() noexcept;
+
+/**
+ * @brief Read the configuration file again and apply "log_default_level" and
+ * "log_context_levels" to every logger, e.g. from an ara::signal::SignalManager
+ * handler for SIGHUP. Other settings need a restart.
+ *
+ * @return false if logging is not initialized or the file can not be parsed,
+ * the levels are then kept.
+ */
+bool ReloadConfiguration() noexcept;
+
+/**
+ * @brief Kernel thread id of the calling thread.
+ *
+ * Read from the kernel once per thread and kept in thread local storage, so it can be added to
+ * every record without a system call.
+ */
+int32_t CurrentThreadId() noexcept;
+
 /**
  * @brief  Logs decimal numbers in hexadecimal format.
  *
@@ -448,4 +505,70 @@ constexpr LogBin64 BinFormat(int64_t value) noexcept { return LogBin64{static_ca
 } /* namespace log */
 } /* namespace ara */
 
+/**
+ * @brief Least severe level compiled into the binary, as a @c LogLevel value (0 kOff .. 6 kVerbose).
+ *
+ * Statements written with the ARA_LOG_* macros below that are less severe than this level are
+ * removed by the compiler, their stream arguments are not evaluated. Release builds may define
+ * e.g. -DARA_LOG_MIN_LEVEL=4 to keep kInfo and above. Defaults to kVerbose, nothing is removed.
+ */
+#ifndef ARA_LOG_MIN_LEVEL
+#define ARA_LOG_MIN_LEVEL 6
+#endif
+
+/**
+ * @brief True if a statement of @a level on @a logger is compiled in and enabled at runtime.
+ */
+#define ARA_LOG_ENABLED(logger, level) \
+  ((static_cast<int>(level) <= ARA_LOG_MIN_LEVEL) && (logger).IsEnabled(level))
+
+/**
+ * @brief @c Logger::WithLevel() that is skipped, arguments included, unless @c ARA_LOG_ENABLED().
+ *
+ * Usage: ARA_LOG_WITH_LEVEL(logger, ara::log::LogLevel::kDebug) << "value:" << Expensive();
+ */
+#define ARA_LOG_WITH_LEVEL(logger, level) \
+  if (!ARA_LOG_ENABLED(logger, level)) {  \
+  } else                                  \
+    (logger).WithLevel(level)
+
+#define ARA_LOG_FATAL(logger) ARA_LOG_WITH_LEVEL(logger, ::ara::log::LogLevel::kFatal)
+#define ARA_LOG_ERROR(logger) ARA_LOG_WITH_LEVEL(logger, ::ara::log::LogLevel::kError)
+#define ARA_LOG_WARN(logger) ARA_LOG_WITH_LEVEL(logger, ::ara::log::LogLevel::kWarn)
+#define ARA_LOG_INFO(logger) ARA_LOG_WITH_LEVEL(logger, ::ara::log::LogLevel::kInfo)
+#define ARA_LOG_DEBUG(logger) ARA_LOG_WITH_LEVEL(logger, ::ara::log::LogLevel::kDebug)
+#define ARA_LOG_VERBOSE(logger) ARA_LOG_WITH_LEVEL(logger, ::ara::log::LogLevel::kVerbose)
+
+/**
+ * @brief Rate limited @c ARA_LOG_WITH_LEVEL(), every call site keeps its own lock free counters.
+ *
+ * - ARA_LOG_EVERY_N: the 1st, (n+1)th, (2n+1)th... statement
+ * - ARA_LOG_FIRST_N: the first n statements, then one every ARA_LOG_SUMMARY_INTERVAL_MS
+ * - ARA_LOG_EVERY_MS: at most one statement every ms milliseconds
+ *
+ * A logged statement starts with "[suppressed K messages]" if K statements of the call site were
+ * dropped since the previous one. Drops no statement reports, e.g. of a final burst, are logged
+ * by the internal logger once the next statement would have been logged, or at exit. Dropped
+ * statements don't evaluate their arguments.
+ *
+ * Usage: ARA_LOG_EVERY_MS(logger, ara::log::LogLevel::kWarn, 1000) << "read error:" << ec.message();
+ */
+#define ARA_LOG_EVERY_N(logger, level, n) ARA_LOG_RATE_LIMITED_(logger, level, EveryN(n, level))
+#define ARA_LOG_FIRST_N(logger, level, n) ARA_LOG_RATE_LIMITED_(logger, level, FirstN(n, level))
+#define ARA_LOG_EVERY_MS(logger, level, ms) ARA_LOG_RATE_LIMITED_(logger, level, EveryMs(ms, level))
+
+// The lambda gives every expansion its own limiter, the for statement scopes the decision
+// without breaking a trailing else.
+#define ARA_LOG_RATE_LIMITED_(logger, level, decision)                                                  \
+  if (!ARA_LOG_ENABLED(logger, level)) {                                                                \
+  } else                                                                                                \
+    for (::ara::log::internal::LogOccurrence ara_log_occurrence =                                       \
+             []() noexcept -> ::ara::log::internal::LogRateLimiter& {                                   \
+               static ::ara::log::internal::LogRateLimiter ara_log_limiter{__FILE__, __LINE__};         \
+               return ara_log_limiter;                                                                  \
+             }()                                                                                        \
+                 .decision;                                                                             \
+         ara_log_occurrence.pending; ara_log_occurrence.pending = false)                                \
+      ::ara::log::internal::WithSuppressedCount((logger).WithLevel(level), ara_log_occurrence.suppressed)
+
 #endif  // AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOGGER_H
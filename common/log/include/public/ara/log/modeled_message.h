@@ -0,0 +1,205 @@
+/*
+ * @Description: Modeled (DLT non-verbose) messages. The format string and argument types of every
+ * ARA_LOG_MODELED() call site are stored in the binary as a catalog entry, at runtime only a 32-bit
+ * message ID and the raw argument values are logged. tools/log_decoder rebuilds the text offline.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOG_MODELED_MESSAGE_H_
+#define AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOG_MODELED_MESSAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <ara/core/string.h>
+#include <ara/core/string_view.h>
+
+#include "ara/log/log_field.h"
+#include "ara/log/logger.h"
+
+namespace ara {
+namespace log {
+namespace internal {
+
+/*
+ * Argument type codes of the catalog, one character per argument, see IntegerArgCode in
+ * "ara/log/log_field.h".
+ *
+ * The payload of a modeled message is the message ID followed by the arguments without DLT type
+ * info: integers, floats and bool in their size, strings as uint16 length (including the
+ * terminating NUL) and the characters.
+ */
+
+/**
+ * @brief Maps an argument type to its catalog code and to the value handed to @c LogStream.
+ */
+template <typename T, typename Enable = void>
+struct ModeledArg {
+  static_assert(sizeof(T) == 0U,
+                "ARA_LOG_MODELED supports bool, integers, enums, float, double and strings only");
+};
+
+template <>
+struct ModeledArg<bool> {
+  static constexpr char kCode = 'b';
+  static bool Wire(bool value) noexcept { return value; }
+};
+
+template <typename T>
+struct ModeledArg<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+  using Code = IntegerArgCode<sizeof(T), std::is_signed<T>::value>;
+  static constexpr char kCode = Code::value;
+  static typename Code::Wire Wire(T value) noexcept { return static_cast<typename Code::Wire>(value); }
+};
+
+template <typename T>
+struct ModeledArg<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+  using Underlying = ModeledArg<typename std::underlying_type<T>::type>;
+  static constexpr char kCode = Underlying::kCode;
+  static auto Wire(T value) noexcept -> decltype(Underlying::Wire(typename std::underlying_type<T>::type())) {
+    return Underlying::Wire(static_cast<typename std::underlying_type<T>::type>(value));
+  }
+};
+
+template <>
+struct ModeledArg<float> {
+  static constexpr char kCode = 'f';
+  static float Wire(float value) noexcept { return value; }
+};
+
+template <>
+struct ModeledArg<double> {
+  static constexpr char kCode = 'd';
+  static double Wire(double value) noexcept { return value; }
+};
+
+template <>
+struct ModeledArg<const char*> {
+  static constexpr char kCode = 's';
+  static const char* Wire(const char* value) noexcept { return value == nullptr ? "" : value; }
+};
+
+template <>
+struct ModeledArg<char*> : ModeledArg<const char*> {};
+
+template <typename Traits, typename Allocator>
+struct ModeledArg<std::basic_string<char, Traits, Allocator>> {
+  static constexpr char kCode = 's';
+  static const char* Wire(const std::basic_string<char, Traits, Allocator>& value) noexcept { return value.c_str(); }
+};
+
+template <typename Allocator>
+struct ModeledArg<ara::core::BasicString<Allocator>> {
+  static constexpr char kCode = 's';
+  static const char* Wire(const ara::core::BasicString<Allocator>& value) noexcept { return value.c_str(); }
+};
+
+template <>
+struct ModeledArg<ara::core::StringView> {
+  static constexpr char kCode = 's';
+  static ara::core::StringView Wire(ara::core::StringView value) noexcept { return value; }
+};
+
+template <typename... Args>
+struct ModeledTypes {};
+
+/* Only used in decltype() by ARA_LOG_MODELED, to get the argument types of a call site. */
+template <typename... Args>
+ModeledTypes<typename std::decay<Args>::type...> ModeledSignature(const Args&...) noexcept;
+
+/**
+ * @brief Catalog entry of one call site, a NUL separated record:
+ * "ARALOG1", source file, line, format string, argument type codes.
+ *
+ * The message ID is the 32-bit FNV-1a hash of the whole entry, so the decoder derives it from the
+ * entry and nothing has to be numbered at build time.
+ */
+template <std::size_t TextSize, std::size_t TypesSize>
+struct CatalogEntry {
+  char text[TextSize];
+  char types[TypesSize];
+
+  constexpr uint32_t Id() const noexcept {
+    uint32_t hash = 2166136261U;
+    for (std::size_t i = 0U; i < TextSize; ++i) {
+      hash = (hash ^ static_cast<uint8_t>(text[i])) * 16777619U;
+    }
+    for (std::size_t i = 0U; i < TypesSize; ++i) {
+      hash = (hash ^ static_cast<uint8_t>(types[i])) * 16777619U;
+    }
+    return hash;
+  }
+};
+
+template <std::size_t TextSize, typename... Args, std::size_t... I>
+constexpr CatalogEntry<TextSize, sizeof...(Args) + 1U> MakeCatalogEntry(const char (&text)[TextSize],
+                                                                      ModeledTypes<Args...>,
+                                                                      std::index_sequence<I...>) noexcept {
+  return CatalogEntry<TextSize, sizeof...(Args) + 1U>{{text[I]...}, {ModeledArg<Args>::kCode..., '\0'}};
+}
+
+template <typename Signature, std::size_t TextSize>
+constexpr auto MakeCatalogEntry(const char (&text)[TextSize]) noexcept
+    -> decltype(MakeCatalogEntry(text, Signature(), std::make_index_sequence<TextSize>())) {
+  return MakeCatalogEntry(text, Signature(), std::make_index_sequence<TextSize>());
+}
+
+/**
+ * @brief Start a modeled record with @a messageId.
+ *
+ * In kNonModeled message mode DLT can't send message IDs, the record is a verbose one starting with
+ * @a format instead.
+ */
+LogStream StartModeled(Logger& logger, LogLevel logLevel, uint32_t messageId, const char* format) noexcept;
+
+template <typename... Args>
+void LogModeled(Logger& logger, LogLevel logLevel, uint32_t messageId, const char* format,
+                const Args&... args) noexcept {
+  LogStream stream = StartModeled(logger, logLevel, messageId, format);
+  using Expand = int[];
+  (void)Expand{0, ((void)(stream << ModeledArg<typename std::decay<Args>::type>::Wire(args)), 0)...};
+}
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
+
+#define ARA_LOG_STRINGIFY_(x) #x
+#define ARA_LOG_STRINGIFY(x) ARA_LOG_STRINGIFY_(x)
+
+// Keeps unreferenced catalog entries in the binary, also with -Wl,--gc-sections where supported.
+#if defined(__has_attribute)
+#if __has_attribute(retain)
+#define ARA_LOG_CATALOG_ATTRIBUTES __attribute__((used, retain))
+#endif
+#endif
+#ifndef ARA_LOG_CATALOG_ATTRIBUTES
+#define ARA_LOG_CATALOG_ATTRIBUTES __attribute__((used))
+#endif
+
+/**
+ * @brief Log a modeled message: @a format with "{}" placeholders, formatted offline.
+ *
+ * @a format has to be a string literal. Only the message ID and the argument values are written,
+ * nothing is formatted or copied besides the argument bytes. Requires "log_message_mode": "kModeled",
+ * use tools/log_decoder with the binary to read the log. Arguments are only evaluated if the level
+ * is enabled, see @c ARA_LOG_ENABLED().
+ *
+ * Usage: ARA_LOG_MODELED(logger, ara::log::LogLevel::kInfo, "speed {} km/h, gear {}", speed, gear);
+ */
+#define ARA_LOG_MODELED(logger, level, format, ...)                                                            \
+  do {                                                                                                         \
+    if (ARA_LOG_ENABLED(logger, level)) {                                                                      \
+      ARA_LOG_CATALOG_ATTRIBUTES static constexpr auto ara_log_catalog_entry =                                \
+          ::ara::log::internal::MakeCatalogEntry<decltype(::ara::log::internal::ModeledSignature(__VA_ARGS__))>( \
+              "ARALOG1\0" __FILE__ "\0" ARA_LOG_STRINGIFY(__LINE__) "\0" format);                              \
+      static constexpr uint32_t ara_log_message_id = ara_log_catalog_entry.Id();                              \
+      ::ara::log::internal::LogModeled((logger), (level), ara_log_message_id, (format), ##__VA_ARGS__);        \
+    }                                                                                                          \
+  } while (false)
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOG_MODELED_MESSAGE_H_
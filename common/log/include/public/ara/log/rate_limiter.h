@@ -0,0 +1,180 @@
+/*
+ * @Description: Per call site rate limiting of log statements, used by the ARA_LOG_EVERY_N,
+ * ARA_LOG_FIRST_N and ARA_LOG_EVERY_MS macros in "ara/log/logger.h".
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#ifndef AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOG_RATE_LIMITER_H_
+#define AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOG_RATE_LIMITER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "ara/log/log_stream.h"
+
+/**
+ * @brief How often ARA_LOG_FIRST_N still lets a statement through once its first n are used up,
+ * to report how many were suppressed.
+ */
+#ifndef ARA_LOG_SUMMARY_INTERVAL_MS
+#define ARA_LOG_SUMMARY_INTERVAL_MS 10000
+#endif
+
+namespace ara {
+namespace log {
+namespace internal {
+
+/**
+ * @brief Decision for one execution of a rate limited statement.
+ */
+struct LogOccurrence {
+  bool pending;         ///< the statement is logged
+  uint64_t suppressed;  ///< statements dropped at this call site since the last logged one
+};
+
+/**
+ * @brief State of one rate limited call site. Lock free, the call site may run on any thread.
+ *
+ * Only statements whose level is enabled are counted. At the call sites of the macros, statements
+ * dropped after the last logged one are reported by ReportSuppressed() once the next one would
+ * have been logged, and at exit.
+ */
+class LogRateLimiter final {
+ public:
+  constexpr LogRateLimiter() noexcept = default;
+  /**
+   * @brief Limiter of the call site @a file:@a line, a static: it is listed for ReportSuppressed().
+   */
+  constexpr LogRateLimiter(const char* file, int line) noexcept : file_(file), line_(line) {}
+
+  LogRateLimiter(const LogRateLimiter&) = delete;
+  LogRateLimiter& operator=(const LogRateLimiter&) = delete;
+
+  /**
+   * @brief Log the 1st, (n+1)th, (2n+1)th... statement.
+   */
+  LogOccurrence EveryN(uint64_t n, LogLevel level = LogLevel::kWarn) noexcept {
+    const uint64_t count = count_.fetch_add(1U, std::memory_order_relaxed);
+    if ((n <= 1U) || (count % n == 0U)) {
+      return Pass();
+    }
+    return Suppress(level, 0);
+  }
+
+  /**
+   * @brief Log the first @a n statements, then one every ARA_LOG_SUMMARY_INTERVAL_MS.
+   */
+  LogOccurrence FirstN(uint64_t n, LogLevel level = LogLevel::kWarn) noexcept {
+    const uint64_t count = count_.fetch_add(1U, std::memory_order_relaxed);
+    if (count < n) {
+      return Pass();
+    }
+    // The interval starts with the first suppressed statement, whichever thread gets there first.
+    int64_t next = 0;
+    const int64_t first = Now() + Interval(ARA_LOG_SUMMARY_INTERVAL_MS);
+    if (next_.compare_exchange_strong(next, first, std::memory_order_relaxed)) {
+      return Suppress(level, first);
+    }
+    return EveryMs(ARA_LOG_SUMMARY_INTERVAL_MS, level);
+  }
+
+  /**
+   * @brief Log at most one statement every @a ms milliseconds.
+   */
+  LogOccurrence EveryMs(uint64_t ms, LogLevel level = LogLevel::kWarn) noexcept {
+    const int64_t now = Now();
+    int64_t next = next_.load(std::memory_order_relaxed);
+    if ((now >= next) && next_.compare_exchange_strong(next, now + Interval(ms), std::memory_order_relaxed)) {
+      return Pass();
+    }
+    return Suppress(level, next);
+  }
+
+  /**
+   * @brief For ReportSuppressed(): take the count of dropped statements if it is due at @a now,
+   * or any with @a all.
+   */
+  uint64_t TakeSuppressed(int64_t now, bool all) noexcept {
+    if ((suppressed_.load(std::memory_order_relaxed) == 0U) ||
+        (!all && (now < report_at_.load(std::memory_order_relaxed)))) {
+      return 0U;
+    }
+    return suppressed_.exchange(0U, std::memory_order_relaxed);
+  }
+
+  const char* File() const noexcept { return file_; }
+  int Line() const noexcept { return line_; }
+  LogLevel Level() const noexcept { return level_.load(std::memory_order_relaxed); }
+  LogRateLimiter* Next() const noexcept { return link_; }
+
+  static int64_t Now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+ private:
+  friend void ListSuppressing(LogRateLimiter& limiter) noexcept;
+
+  static constexpr int64_t Interval(uint64_t ms) noexcept { return static_cast<int64_t>(ms) * 1000000; }
+
+  LogOccurrence Pass() noexcept { return LogOccurrence{true, suppressed_.exchange(0U, std::memory_order_relaxed)}; }
+
+  // @a report_at: when the count is reported if no statement is logged before, 0 for
+  // ARA_LOG_SUMMARY_INTERVAL_MS from now.
+  LogOccurrence Suppress(LogLevel level, int64_t report_at) noexcept {
+    level_.store(level, std::memory_order_relaxed);
+    if (suppressed_.load(std::memory_order_relaxed) == 0U) {
+      report_at_.store(report_at != 0 ? report_at : Now() + Interval(ARA_LOG_SUMMARY_INTERVAL_MS),
+                       std::memory_order_relaxed);
+    }
+    (void)suppressed_.fetch_add(1U, std::memory_order_relaxed);
+    // Only the never destroyed call site limiters of the macros have a file.
+    if ((file_ != nullptr) && !listed_.load(std::memory_order_relaxed) &&
+        !listed_.exchange(true, std::memory_order_relaxed)) {
+      ListSuppressing(*this);
+    }
+    return LogOccurrence{false, 0U};
+  }
+
+  std::atomic<uint64_t> count_{0U};
+  std::atomic<uint64_t> suppressed_{0U};
+  std::atomic<int64_t> next_{0};       // steady clock, ns
+  std::atomic<int64_t> report_at_{0};  // steady clock, ns
+  std::atomic<LogLevel> level_{LogLevel::kWarn};
+  std::atomic<bool> listed_{false};
+  LogRateLimiter* link_ = nullptr;  // next limiter that has dropped statements
+  const char* file_ = nullptr;
+  int line_ = 0;
+};
+
+/**
+ * @brief Add @a limiter to the limiters ReportSuppressed() looks at, once it drops a statement.
+ */
+void ListSuppressing(LogRateLimiter& limiter) noexcept;
+
+/**
+ * @brief Log "[suppressed K messages] <file>:<line>" with the internal logger for every call site
+ * whose dropped statements no later one has reported, once the next one would have been logged,
+ * or all with @a all. Called as records are finished and at exit. Returns the statements reported.
+ */
+uint64_t ReportSuppressed(bool all) noexcept;
+
+/**
+ * @brief Starts the record of a rate limited statement with the number of statements dropped
+ * before it.
+ */
+inline LogStream& WithSuppressedCount(LogStream&& stream, uint64_t suppressed) noexcept {
+  if (suppressed != 0U) {
+    stream << "[suppressed" << suppressed << "messages]";
+  }
+  return stream;
+}
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
+
+#endif  // AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_LOG_RATE_LIMITER_H_
@@ -0,0 +1,341 @@
+/*
+ * @Description: asynchronous back-end, per-thread record queues and flusher
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include "ara/log/async_backend.h"
+#include "ara/log/file_sink.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <system_error>
+
+namespace ara {
+namespace log {
+namespace internal {
+
+namespace {
+
+constexpr uint32_t kMinQueueSize = 16U;
+constexpr uint32_t kMaxQueueSize = 1U << 20U;
+
+// Set on the flusher thread, whose own records (drop reports) must not queue
+// behind the records it is writing, and on threads that are exiting.
+thread_local bool t_synchronous = false;
+
+std::size_t RoundUpToPowerOfTwo(std::size_t value) noexcept {
+  std::size_t result = 1U;
+  while (result < value) {
+    result <<= 1U;
+  }
+  return result;
+}
+
+std::string CurrentThreadName() {
+  char name[32] = {};
+  if (::pthread_getname_np(::pthread_self(), name, sizeof(name)) != 0) {
+    return std::string();
+  }
+  return std::string(name);
+}
+
+void Discard(DltContextData& record) noexcept {
+  free(record.buffer);
+  record.buffer = NULL;
+}
+
+}  // namespace
+
+const char* ToString(OverflowPolicy policy) noexcept {
+  switch (policy) {
+    case OverflowPolicy::kBlock:
+      return "kBlock";
+    case OverflowPolicy::kDrop:
+      return "kDrop";
+    case OverflowPolicy::kCountAndDrop:
+      return "kCountAndDrop";
+    default:
+      return "";
+  }
+}
+
+RecordQueue::RecordQueue(std::size_t capacity)
+    : capacity_(RoundUpToPowerOfTwo(capacity)), mask_(capacity_ - 1U), slots_(new DltContextData[capacity_]) {}
+
+/*
+ * The producer registered for the calling thread. Kept in a thread_local
+ * slot, the thread only takes producers_mutex_ the first time it logs after
+ * a Start().
+ */
+class AsyncBackend::ThreadSlot final {
+ public:
+  ~ThreadSlot() {
+    t_synchronous = true;
+    Release();
+  }
+
+  void Release() noexcept {
+    if (producer != nullptr) {
+      producer->exited.store(true, std::memory_order_release);
+      producer.reset();
+    }
+  }
+
+  std::shared_ptr<Producer> producer;
+  const AsyncBackend* owner{nullptr};
+  uint64_t epoch{0U};
+};
+
+AsyncBackend& AsyncBackend::instance() noexcept {
+  // Leaked on purpose, LogStreams may still be destroyed during static
+  // destruction.
+  static AsyncBackend* const inst = new AsyncBackend();
+  return *inst;
+}
+
+AsyncBackend::~AsyncBackend() { Stop(); }
+
+bool AsyncBackend::Start(const AsyncConfig& config, const Logger* reporter) noexcept {
+  const std::lock_guard<std::mutex> guard(control_mutex_);
+  if (flusher_.joinable()) {
+    return false;
+  }
+  config_ = config;
+  config_.queue_size = std::min(std::max(config_.queue_size, kMinQueueSize), kMaxQueueSize);
+  config_.queue_size = static_cast<uint32_t>(RoundUpToPowerOfTwo(config_.queue_size));
+  config_.flush_interval_ms = std::max(config_.flush_interval_ms, 1U);
+  reporter_ = reporter;
+  {
+    const std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_requested_ = false;
+    flush_requested_ = 0U;
+    flush_done_ = 0U;
+  }
+  (void)epoch_.fetch_add(1U, std::memory_order_relaxed);
+  stopping_.store(false, std::memory_order_relaxed);
+  try {
+    flusher_ = std::thread(&AsyncBackend::Run, this);
+  } catch (const std::system_error&) {
+    return false;
+  }
+  running_.store(true, std::memory_order_seq_cst);
+  return true;
+}
+
+void AsyncBackend::Stop() noexcept {
+  const std::lock_guard<std::mutex> guard(control_mutex_);
+  if (!flusher_.joinable()) {
+    return;
+  }
+  // New records go the synchronous way from here on, the flusher keeps
+  // draining until the threads already inside Submit() are done.
+  running_.store(false, std::memory_order_seq_cst);
+  stopping_.store(true, std::memory_order_seq_cst);
+  Wake();
+  flusher_.join();
+
+  try {
+    const std::lock_guard<std::mutex> lock(producers_mutex_);
+    for (const std::shared_ptr<Producer>& producer : producers_) {
+      Retire(*producer);
+    }
+    producers_.clear();
+  } catch (const std::bad_alloc&) {
+  }
+  (void)version_.fetch_add(1U, std::memory_order_release);
+}
+
+bool AsyncBackend::Submit(DltContextData& record) noexcept {
+  if (t_synchronous || !running_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  // Stop() flips running_ before it waits for in_flight_ to drain, so a record
+  // is either seen by the final drain or written by the caller.
+  (void)in_flight_.fetch_add(1U, std::memory_order_seq_cst);
+  bool queued = false;
+  if (running_.load(std::memory_order_seq_cst)) {
+    Producer* const producer = LocalProducer();
+    if (producer != nullptr) {
+      if (producer->queue.TryPush(record)) {
+        record.buffer = NULL;
+        // Don't wait for the interval once the queue is half full.
+        if (producer->queue.Size() == producer->queue.Capacity() / 2U) {
+          Wake();
+        }
+        queued = true;
+      } else {
+        queued = Overflow(*producer, record);
+      }
+    }
+  }
+  (void)in_flight_.fetch_sub(1U, std::memory_order_release);
+  return queued;
+}
+
+bool AsyncBackend::Overflow(Producer& producer, DltContextData& record) noexcept {
+  if (config_.overflow_policy == OverflowPolicy::kBlock) {
+    // Sleep until the flusher has drained, it notifies under wake_mutex_
+    // after every pass, so a pass can't end between TryPush() and wait().
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    ++blocked_;
+    while (!producer.queue.TryPush(record)) {
+      wake_requested_ = true;
+      wake_.notify_one();
+      drained_.wait(lock);
+    }
+    --blocked_;
+    record.buffer = NULL;
+  } else {
+    Discard(record);
+    (void)producer.dropped.fetch_add(1U, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+AsyncBackend::Producer* AsyncBackend::LocalProducer() noexcept {
+  static thread_local ThreadSlot slot;
+  const uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+  if (slot.owner == this && slot.epoch == epoch && slot.producer != nullptr) {
+    return slot.producer.get();
+  }
+  slot.Release();
+  try {
+    std::shared_ptr<Producer> producer = std::make_shared<Producer>(config_.queue_size);
+    producer->thread_id = static_cast<uint64_t>(CurrentThreadId());
+    producer->thread_name = CurrentThreadName();
+    {
+      const std::lock_guard<std::mutex> lock(producers_mutex_);
+      producers_.push_back(producer);
+    }
+    (void)version_.fetch_add(1U, std::memory_order_release);
+    slot.producer = std::move(producer);
+    slot.owner = this;
+    slot.epoch = epoch;
+  } catch (const std::exception&) {
+    return nullptr;
+  }
+  return slot.producer.get();
+}
+
+void AsyncBackend::Wake() noexcept {
+  {
+    const std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_requested_ = true;
+  }
+  wake_.notify_one();
+}
+
+void AsyncBackend::Flush() noexcept {
+  if (t_synchronous || !running_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  const uint64_t ticket = ++flush_requested_;
+  wake_requested_ = true;
+  wake_.notify_one();
+  flushed_.wait(lock, [this, ticket]() { return flush_done_ >= ticket; });
+}
+
+std::vector<DroppedLogCount> AsyncBackend::DroppedCounts() const {
+  const std::lock_guard<std::mutex> lock(producers_mutex_);
+  std::vector<DroppedLogCount> counts = retired_;
+  for (const std::shared_ptr<Producer>& producer : producers_) {
+    counts.push_back(DroppedLogCount{producer->thread_id, producer->thread_name,
+                                     producer->dropped.load(std::memory_order_relaxed)});
+  }
+  return counts;
+}
+
+void AsyncBackend::Run() noexcept {
+  t_synchronous = true;
+  (void)::pthread_setname_np(::pthread_self(), "ara-log-flush");
+  const std::chrono::milliseconds interval(config_.flush_interval_ms);
+  std::vector<std::shared_ptr<Producer>> producers;
+  uint64_t version = std::numeric_limits<uint64_t>::max();
+  bool done = false;
+  while (!done) {
+    uint64_t ticket = 0U;
+    {
+      const std::lock_guard<std::mutex> lock(wake_mutex_);
+      ticket = flush_requested_;
+    }
+    // Decided before the snapshot: once no producer is inside Submit(),
+    // this drain is the last one.
+    done = stopping_.load(std::memory_order_seq_cst) && in_flight_.load(std::memory_order_seq_cst) == 0U;
+    if (version_.load(std::memory_order_acquire) != version) {
+      const std::lock_guard<std::mutex> lock(producers_mutex_);
+      version = version_.load(std::memory_order_acquire);
+      producers = producers_;
+    }
+    Drain(producers);
+    {
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      flush_done_ = done ? std::numeric_limits<uint64_t>::max() : ticket;
+      flushed_.notify_all();
+      if (blocked_ != 0U) {
+        drained_.notify_all();
+      }
+      if (!done && !stopping_.load(std::memory_order_relaxed)) {
+        (void)wake_.wait_for(lock, interval, [this]() { return wake_requested_; });
+      }
+      wake_requested_ = false;
+    }
+  }
+}
+
+void AsyncBackend::Drain(const std::vector<std::shared_ptr<Producer>>& producers) noexcept {
+  bool retired = false;
+  for (const std::shared_ptr<Producer>& producer : producers) {
+    // Read before draining: a thread flags exited after its last record.
+    const bool exited = producer->exited.load(std::memory_order_acquire);
+    DltContextData record;
+    while (producer->queue.TryPop(record)) {
+      WriteRecord(record);
+    }
+    ReportDrops(*producer);
+    if (exited) {
+      try {
+        const std::lock_guard<std::mutex> lock(producers_mutex_);
+        const auto it = std::find(producers_.begin(), producers_.end(), producer);
+        if (it != producers_.end()) {
+          Retire(**it);
+          (void)producers_.erase(it);
+          retired = true;
+        }
+      } catch (const std::bad_alloc&) {
+      }
+    }
+  }
+  if (retired) {
+    (void)version_.fetch_add(1U, std::memory_order_release);
+  }
+}
+
+void AsyncBackend::ReportDrops(Producer& producer) noexcept {
+  if (config_.overflow_policy != OverflowPolicy::kCountAndDrop || reporter_ == nullptr) {
+    return;
+  }
+  const uint64_t dropped = producer.dropped.load(std::memory_order_relaxed);
+  if (dropped != producer.reported) {
+    reporter_->LogWarn() << "Asynchronous log queue of thread" << producer.thread_name << "(" << producer.thread_id
+                         << ") overflowed, dropped" << (dropped - producer.reported) << "records";
+    producer.reported = dropped;
+  }
+}
+
+// Keeps the drop counter of a producer that leaves producers_.
+void AsyncBackend::Retire(const Producer& producer) {
+  const uint64_t dropped = producer.dropped.load(std::memory_order_relaxed);
+  if (dropped > 0U) {
+    retired_.push_back(DroppedLogCount{producer.thread_id, producer.thread_name, dropped});
+  }
+}
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
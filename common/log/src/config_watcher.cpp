@@ -0,0 +1,147 @@
+/*
+ * @Description: log configuration file watcher
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include "ara/log/config_watcher.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#include <cerrno>
+
+namespace ara {
+namespace log {
+namespace internal {
+
+namespace {
+
+constexpr int kPollIntervalMs = 1000;  // without inotify
+constexpr int kSettleMs = 100;         // quiet time after the last event of a burst
+
+void CloseFd(int& fd) noexcept {
+  if (fd >= 0) {
+    (void)::close(fd);
+    fd = -1;
+  }
+}
+
+}  // namespace
+
+ConfigWatcher::~ConfigWatcher() { Stop(); }
+
+bool ConfigWatcher::Start(const std::string& path, std::function<void()> changed) noexcept {
+  Stop();
+  try {
+    path_ = path;
+    changed_ = std::move(changed);
+  } catch (const std::exception&) {
+    return false;
+  }
+  if (::pipe(wake_) != 0) {
+    return false;
+  }
+  (void)::fcntl(wake_[0], F_SETFD, FD_CLOEXEC);
+  (void)::fcntl(wake_[1], F_SETFD, FD_CLOEXEC);
+#ifdef __linux__
+  // The directory, not the file: a file replaced by a rename is a new inode.
+  const std::string::size_type slash = path_.rfind('/');
+  const std::string directory = (slash == std::string::npos) ? "." : (slash == 0U ? "/" : path_.substr(0U, slash));
+  inotify_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if ((inotify_ >= 0) &&
+      (::inotify_add_watch(inotify_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ATTRIB) < 0)) {
+    CloseFd(inotify_);
+  }
+#endif
+  last_ = Stat();
+  try {
+    worker_ = std::thread(&ConfigWatcher::Run, this);
+  } catch (const std::exception&) {
+    CloseFd(inotify_);
+    CloseFd(wake_[0]);
+    CloseFd(wake_[1]);
+    return false;
+  }
+  return true;
+}
+
+void ConfigWatcher::Stop() noexcept {
+  if (worker_.joinable()) {
+    const char stop = 0;
+    while ((::write(wake_[1], &stop, 1U) < 0) && (errno == EINTR)) {
+    }
+    worker_.join();
+  }
+  CloseFd(inotify_);
+  CloseFd(wake_[0]);
+  CloseFd(wake_[1]);
+}
+
+ConfigWatcher::Signature ConfigWatcher::Stat() const noexcept {
+  Signature signature;
+  struct stat st {};
+  if (::stat(path_.c_str(), &st) == 0) {
+    signature.mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    signature.size = st.st_size;
+    signature.inode = st.st_ino;
+  }
+  return signature;
+}
+
+bool ConfigWatcher::Wait(int timeout_ms, bool& notified) noexcept {
+  struct pollfd fds[2] = {{wake_[0], POLLIN, 0}, {inotify_, POLLIN, 0}};
+  const nfds_t count = (inotify_ >= 0) ? 2U : 1U;
+  int ready = 0;
+  do {
+    ready = ::poll(fds, count, timeout_ms);
+  } while ((ready < 0) && (errno == EINTR));
+  if ((ready < 0) || (fds[0].revents != 0)) {
+    return false;
+  }
+  if ((count == 2U) && (fds[1].revents != 0)) {
+    // Which file changed does not matter, Stat() decides.
+    char events[4096];
+    while (::read(inotify_, events, sizeof(events)) > 0) {
+    }
+    notified = true;
+  }
+  return true;
+}
+
+void ConfigWatcher::Run() noexcept {
+  (void)::pthread_setname_np(::pthread_self(), "ara-log-conf");
+  bool notified = false;
+  while (Wait((inotify_ >= 0) ? -1 : kPollIntervalMs, notified)) {
+    if (inotify_ >= 0) {
+      if (!notified) {
+        continue;
+      }
+      do {
+        notified = false;
+        if (!Wait(kSettleMs, notified)) {
+          return;
+        }
+      } while (notified);
+    }
+    const Signature current = Stat();
+    if (current == last_) {
+      continue;
+    }
+    last_ = current;
+    // Removed: keep the levels, the file coming back is a change again.
+    if (current.size >= 0) {
+      changed_();
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
@@ -0,0 +1,282 @@
+/*
+ * @Description: crash surviving ring of the latest records in shared memory
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include "ara/log/crash_ring.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+#include "ara/log/file_sink.h"
+
+namespace ara {
+namespace log {
+namespace internal {
+
+namespace {
+
+constexpr uint32_t kMinSize = 65536U;
+constexpr uint32_t kMaxSize = 1073741824U;
+
+uint64_t SlotsOf(std::size_t record) noexcept {
+  return (sizeof(CrashRingSlot) + record + kCrashRingSlotSize - 1U) / kCrashRingSlotSize;
+}
+
+// Copies @a size bytes to byte @a pos of the slots, wrapping at their end.
+void CopyIn(char* slots, std::size_t capacity, std::size_t pos, const void* data, std::size_t size) noexcept {
+  pos &= capacity - 1U;
+  const std::size_t first = std::min(size, capacity - pos);
+  std::memcpy(slots + pos, data, first);
+  std::memcpy(slots, static_cast<const char*>(data) + first, size - first);
+}
+
+void CopyOut(const char* slots, std::size_t capacity, std::size_t pos, std::size_t size, std::string& out) {
+  pos &= capacity - 1U;
+  const std::size_t first = std::min(size, capacity - pos);
+  out.append(slots + pos, first).append(slots, size - first);
+}
+
+bool WriteAll(int fd, const char* data, std::size_t size) noexcept {
+  while (size > 0U) {
+    const ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+  return true;
+}
+
+bool WriteFile(const std::string& path, const std::string& content) noexcept {
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  const bool ok = WriteAll(fd, content.data(), content.size());
+  return (::close(fd) == 0) && ok;
+}
+
+std::string Stamp() {
+  const time_t now = time(nullptr);
+  struct tm local {};
+  (void)localtime_r(&now, &local);
+  char stamp[32] = {};
+  (void)strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+  return stamp;
+}
+
+}  // namespace
+
+std::size_t ReadCrashRing(const void* data, std::size_t size, std::string& records) {
+  if (size < sizeof(CrashRingHeader)) {
+    return 0U;
+  }
+  const CrashRingHeader* const ring = static_cast<const CrashRingHeader*>(data);
+  const uint64_t count = ring->slot_count;
+  if ((std::memcmp(ring->magic, kCrashRingMagic, sizeof(kCrashRingMagic)) != 0) ||
+      (ring->slot_size != kCrashRingSlotSize) || (count == 0U) || ((count & (count - 1U)) != 0U) ||
+      (count > (size - sizeof(CrashRingHeader)) / kCrashRingSlotSize)) {
+    return 0U;
+  }
+  const char* const slots = reinterpret_cast<const char*>(ring + 1);
+  const std::size_t capacity = static_cast<std::size_t>(count) * kCrashRingSlotSize;
+  const uint64_t head = ring->head.load(std::memory_order_acquire);
+  std::size_t found = 0U;
+  // Older slots are overwritten. Reserved ones are skipped slot by slot until their record is complete.
+  uint64_t index = head > count ? head - count : 0U;
+  while (index < head) {
+    const std::size_t pos = static_cast<std::size_t>(index & (count - 1U)) * kCrashRingSlotSize;
+    const CrashRingSlot* const slot = reinterpret_cast<const CrashRingSlot*>(slots + pos);
+    // The index first, what follows it is then at least as new. A writer of a live ring may be
+    // overwriting it meanwhile, it took the slots again and moved head past index + count.
+    if (slot->index.load(std::memory_order_acquire) != index) {
+      ++index;
+      continue;
+    }
+    const uint32_t recordSize = slot->size;
+    const uint64_t used = SlotsOf(recordSize);
+    if ((slot->check != CrashRingCheck(index, recordSize)) || (recordSize < kStorageRecordHeaderSize) ||
+        (used > count / 4U) || (index + used > head)) {
+      ++index;
+      continue;
+    }
+    const std::size_t start = records.size();
+    CopyOut(slots, capacity, pos + sizeof(CrashRingSlot), recordSize, records);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ((slot->index.load(std::memory_order_relaxed) != index) ||
+        (ring->head.load(std::memory_order_relaxed) > index + count)) {
+      records.resize(start);
+      ++index;
+      continue;
+    }
+    // Storage header, then the DLT message with its big endian length.
+    const std::size_t length = (static_cast<std::size_t>(static_cast<uint8_t>(records[start + 18U])) << 8U) |
+                               static_cast<uint8_t>(records[start + 19U]);
+    if ((records.compare(start, 4U, "DLT\x01") != 0) || (16U + length != recordSize)) {
+      records.resize(start);
+      ++index;
+      continue;
+    }
+    ++found;
+    index += used;
+  }
+  return found;
+}
+
+CrashRing& CrashRing::instance() noexcept {
+  // Leaked on purpose, like the file sink.
+  static CrashRing* const inst = new CrashRing();
+  return *inst;
+}
+
+bool CrashRing::Recover(const std::string& directory, std::string& recovered) noexcept {
+  const int fd = ::shm_open(name_.c_str(), O_RDWR | O_CLOEXEC, 0);
+  if (fd < 0) {
+    return errno == ENOENT;  // first run or a clean exit
+  }
+  // The lock goes with the process that holds it, a crashed run has none.
+  if (::flock(fd, LOCK_EX | LOCK_NB) != 0) {
+    (void)::close(fd);
+    return false;
+  }
+  struct stat st {};
+  void* map = MAP_FAILED;
+  if ((::fstat(fd, &st) == 0) && (static_cast<std::size_t>(st.st_size) >= sizeof(CrashRingHeader))) {
+    map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  }
+  if (map != MAP_FAILED) {
+    try {
+      std::string records;
+      if (ReadCrashRing(map, static_cast<std::size_t>(st.st_size), records) != 0U) {
+        const CrashRingHeader* const ring = static_cast<const CrashRingHeader*>(map);
+        const std::string path = (directory.empty() ? std::string(".") : directory) + "/" +
+                                 std::string(ring->app_id, strnlen(ring->app_id, DLT_ID_SIZE)) + "_crash_" + Stamp() +
+                                 ".dlt";
+        if (WriteFile(path, records)) {
+          recovered = path;
+        }
+      }
+    } catch (const std::bad_alloc&) {
+    }
+    (void)::munmap(map, static_cast<std::size_t>(st.st_size));
+  }
+  // Recovered or not, the next crash gets a fresh ring.
+  (void)::shm_unlink(name_.c_str());
+  (void)::close(fd);
+  return true;
+}
+
+bool CrashRing::Start(const CrashRingConfig& config, std::string& recovered) noexcept {
+  const std::lock_guard<std::mutex> lock(control_mutex_);
+  recovered.clear();
+  if (ring_.exchange(nullptr, std::memory_order_acq_rel) != nullptr) {
+    (void)::shm_unlink(name_.c_str());
+    (void)::close(fd_);
+    fd_ = -1;
+  }
+  try {
+    name_ = "/ara-log-" + config.app_id;
+  } catch (const std::bad_alloc&) {
+    return false;
+  }
+  if (!Recover(config.directory, recovered)) {
+    return false;
+  }
+
+  uint64_t count = kMinSize / kCrashRingSlotSize;
+  while ((count * kCrashRingSlotSize < config.size) && (count * kCrashRingSlotSize < kMaxSize)) {
+    count <<= 1U;
+  }
+  const std::size_t size = sizeof(CrashRingHeader) + static_cast<std::size_t>(count) * kCrashRingSlotSize;
+  const int fd = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0640);
+  if (fd < 0) {
+    return false;
+  }
+  int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+  // No page faults on the logging path.
+  flags |= MAP_POPULATE;
+#endif
+  void* map = MAP_FAILED;
+  if ((::flock(fd, LOCK_EX | LOCK_NB) == 0) && (::ftruncate(fd, static_cast<off_t>(size)) == 0)) {
+    map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+  }
+  if (map == MAP_FAILED) {
+    (void)::shm_unlink(name_.c_str());
+    (void)::close(fd);
+    return false;
+  }
+  // ftruncate() zeroed the slots, none holds a record.
+  CrashRingHeader* const ring = new (map) CrashRingHeader;
+  std::memcpy(ring->magic, kCrashRingMagic, sizeof(kCrashRingMagic));
+  ring->slot_size = kCrashRingSlotSize;
+  ring->pid = static_cast<int32_t>(::getpid());
+  ring->slot_count = count;
+  ring->head.store(0U, std::memory_order_relaxed);
+  std::memset(ring->app_id, 0, sizeof(ring->app_id));
+  std::memcpy(ring->app_id, config.app_id.data(), std::min(config.app_id.size(), sizeof(ring->app_id)));
+  fd_ = fd;
+  ring_.store(ring, std::memory_order_release);
+  return true;
+}
+
+void CrashRing::Stop() noexcept {
+  const std::lock_guard<std::mutex> lock(control_mutex_);
+  if (ring_.exchange(nullptr, std::memory_order_acq_rel) == nullptr) {
+    return;
+  }
+  (void)::shm_unlink(name_.c_str());
+  (void)::close(fd_);
+  fd_ = -1;
+}
+
+void CrashRing::Write(const DltContextData& record) noexcept {
+  CrashRingHeader* const ring = ring_.load(std::memory_order_acquire);
+  if ((ring == nullptr) || (record.handle == nullptr) || (record.buffer == nullptr) || (record.size <= 0)) {
+    return;
+  }
+  const std::size_t payloadSize = StoragePayloadSize(record);
+  const std::size_t size = kStorageRecordHeaderSize + payloadSize;
+  const uint64_t count = ring->slot_count;
+  const uint64_t used = SlotsOf(size);
+  if (used > count / 4U) {
+    return;
+  }
+  struct timespec wall {};
+  (void)clock_gettime(CLOCK_REALTIME, &wall);
+  char header[kStorageRecordHeaderSize];
+  EncodeStorageHeader(record, ring->app_id, wall, Uptime(), header);
+
+  const uint64_t index = ring->head.fetch_add(used, std::memory_order_relaxed);
+  // A reader that sees any of the writes below also sees the slots taken.
+  std::atomic_thread_fence(std::memory_order_release);
+  char* const slots = reinterpret_cast<char*>(ring + 1);
+  const std::size_t capacity = static_cast<std::size_t>(count) * kCrashRingSlotSize;
+  const std::size_t pos = static_cast<std::size_t>(index & (count - 1U)) * kCrashRingSlotSize;
+  CrashRingSlot* const slot = reinterpret_cast<CrashRingSlot*>(slots + pos);
+  slot->size = static_cast<uint32_t>(size);
+  slot->check = CrashRingCheck(index, static_cast<uint32_t>(size));
+  CopyIn(slots, capacity, pos + sizeof(CrashRingSlot), header, sizeof(header));
+  CopyIn(slots, capacity, pos + sizeof(CrashRingSlot) + sizeof(header), record.buffer, payloadSize);
+  // The record is complete once its slot carries its index.
+  slot->index.store(index, std::memory_order_release);
+}
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
@@ -0,0 +1,323 @@
+/*
+ * @Description: compression of rotated log files
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include "ara/log/file_compressor.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+#ifdef ARA_LOG_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+#include <memory>
+
+#include "ara/log/logger.h"
+
+namespace ara {
+namespace log {
+namespace internal {
+
+namespace {
+
+constexpr std::size_t kChunkSize = 256U * 1024U;
+constexpr int kGzipLevel = 6;
+constexpr int kZstdLevel = 3;
+constexpr int kLowestPriority = 19;
+
+int64_t Nanoseconds(clockid_t clock) noexcept {
+  struct timespec ts {};
+  (void)clock_gettime(clock, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+bool WriteAll(int fd, const unsigned char* data, std::size_t size) noexcept {
+  while (size > 0U) {
+    const ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+  return true;
+}
+
+ssize_t ReadChunk(int fd, unsigned char* data, std::size_t size) noexcept {
+  ssize_t result = 0;
+  do {
+    result = ::read(fd, data, size);
+  } while ((result < 0) && (errno == EINTR));
+  return result;
+}
+
+// pace() is called after every chunk, false abandons the file.
+template <typename Pace>
+bool Deflate(int in, int out, const Pace& pace) noexcept {
+  std::unique_ptr<unsigned char[]> input(new (std::nothrow) unsigned char[kChunkSize]);
+  std::unique_ptr<unsigned char[]> output(new (std::nothrow) unsigned char[kChunkSize]);
+  if (!input || !output) {
+    return false;
+  }
+  z_stream stream{};
+  // 15 window bits plus 16: gzip wrapper, readable by gunzip and zcat.
+  if (deflateInit2(&stream, kGzipLevel, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+  bool ok = true;
+  int flush = Z_NO_FLUSH;
+  while (ok && (flush != Z_FINISH)) {
+    const ssize_t size = ReadChunk(in, input.get(), kChunkSize);
+    if (size < 0) {
+      ok = false;
+      break;
+    }
+    flush = (size == 0) ? Z_FINISH : Z_NO_FLUSH;
+    stream.next_in = input.get();
+    stream.avail_in = static_cast<uInt>(size);
+    do {
+      stream.next_out = output.get();
+      stream.avail_out = static_cast<uInt>(kChunkSize);
+      if (deflate(&stream, flush) == Z_STREAM_ERROR) {
+        ok = false;
+        break;
+      }
+      ok = WriteAll(out, output.get(), kChunkSize - stream.avail_out);
+    } while (ok && (stream.avail_out == 0U));
+    ok = ok && pace();
+  }
+  (void)deflateEnd(&stream);
+  return ok;
+}
+
+#ifdef ARA_LOG_WITH_ZSTD
+template <typename Pace>
+bool ZstdCompress(int in, int out, const Pace& pace) noexcept {
+  const std::size_t outputSize = ZSTD_CStreamOutSize();
+  std::unique_ptr<unsigned char[]> input(new (std::nothrow) unsigned char[kChunkSize]);
+  std::unique_ptr<unsigned char[]> output(new (std::nothrow) unsigned char[outputSize]);
+  ZSTD_CCtx* const context = ZSTD_createCCtx();
+  if (!input || !output || (context == nullptr)) {
+    ZSTD_freeCCtx(context);
+    return false;
+  }
+  (void)ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, kZstdLevel);
+  bool ok = true;
+  bool last = false;
+  while (ok && !last) {
+    const ssize_t size = ReadChunk(in, input.get(), kChunkSize);
+    if (size < 0) {
+      ok = false;
+      break;
+    }
+    last = (size == 0);
+    ZSTD_inBuffer source{input.get(), static_cast<std::size_t>(size), 0U};
+    bool drained = false;
+    while (ok && !drained) {
+      ZSTD_outBuffer target{output.get(), outputSize, 0U};
+      const std::size_t remaining = ZSTD_compressStream2(context, &target, &source, last ? ZSTD_e_end : ZSTD_e_continue);
+      ok = !ZSTD_isError(remaining) && WriteAll(out, output.get(), target.pos);
+      drained = last ? (remaining == 0U) : (source.pos == source.size);
+    }
+    ok = ok && pace();
+  }
+  ZSTD_freeCCtx(context);
+  return ok;
+}
+#endif
+
+template <typename Pace>
+bool CompressFile(FileCompression compression, const std::string& path, const Pace& pace) noexcept {
+  std::string target;
+  std::string part;
+  try {
+    target = path + CompressedExtension(compression);
+    const std::string::size_type slash = path.rfind('/');
+    part = path.substr(0U, slash + 1U) + "." + target.substr(slash + 1U) + ".part";
+  } catch (const std::exception&) {
+    return false;
+  }
+  const int in = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (in < 0) {
+    return false;
+  }
+  const int out = ::open(part.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (out < 0) {
+    (void)::close(in);
+    return false;
+  }
+  (void)::posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+  bool ok = false;
+#ifdef ARA_LOG_WITH_ZSTD
+  if (compression == FileCompression::kZstd) {
+    ok = ZstdCompress(in, out, pace);
+  } else {
+    ok = Deflate(in, out, pace);
+  }
+#else
+  ok = Deflate(in, out, pace);
+#endif
+  // Keep the time of the last record.
+  struct stat st {};
+  if (ok && (::fstat(in, &st) == 0)) {
+    const struct timespec times[2] = {st.st_atim, st.st_mtim};
+    (void)::futimens(out, times);
+  }
+  // Neither is read again soon, leave the page cache to the applications.
+  (void)::posix_fadvise(in, 0, 0, POSIX_FADV_DONTNEED);
+  (void)::close(in);
+  ok = (::close(out) == 0) && ok;
+  if (ok && (::rename(part.c_str(), target.c_str()) == 0)) {
+    (void)::unlink(path.c_str());
+    return true;
+  }
+  (void)::unlink(part.c_str());
+  return false;
+}
+
+}  // namespace
+
+const char* ToString(FileCompression compression) noexcept {
+  switch (compression) {
+    case FileCompression::kNone:
+      return "kNone";
+    case FileCompression::kGzip:
+      return "kGzip";
+    case FileCompression::kZstd:
+      return "kZstd";
+    default:
+      return "";
+  }
+}
+
+const char* CompressedExtension(FileCompression compression) noexcept {
+  switch (SupportedCompression(compression)) {
+    case FileCompression::kGzip:
+      return ".gz";
+    case FileCompression::kZstd:
+      return ".zst";
+    default:
+      return "";
+  }
+}
+
+FileCompression SupportedCompression(FileCompression compression) noexcept {
+#ifndef ARA_LOG_WITH_ZSTD
+  if (compression == FileCompression::kZstd) {
+    return FileCompression::kGzip;
+  }
+#endif
+  return compression;
+}
+
+FileCompressor::~FileCompressor() { Stop(); }
+
+bool FileCompressor::Start(FileCompression compression, uint32_t cpu_percent, std::function<void()> done) noexcept {
+  Stop();
+  compression_ = SupportedCompression(compression);
+  cpu_percent_ = (cpu_percent == 0U || cpu_percent > 100U) ? 100U : cpu_percent;
+  if (compression_ == FileCompression::kNone) {
+    return true;
+  }
+  try {
+    done_ = std::move(done);
+    const std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+    worker_ = std::thread(&FileCompressor::Run, this);
+  } catch (const std::exception&) {
+    return false;
+  }
+  return true;
+}
+
+void FileCompressor::Stop() noexcept {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    queue_.clear();
+  }
+  wake_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  compression_ = FileCompression::kNone;
+}
+
+void FileCompressor::Enqueue(const std::string& path) noexcept {
+  if (compression_ == FileCompression::kNone) {
+    return;
+  }
+  try {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(path);
+  } catch (const std::bad_alloc&) {
+    return;
+  }
+  wake_.notify_one();
+}
+
+void FileCompressor::Sync() noexcept {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this]() { return stopping_ || !worker_.joinable() || (queue_.empty() && !busy_); });
+}
+
+bool FileCompressor::Compress(const std::string& path) noexcept {
+  return (compression_ != FileCompression::kNone) && CompressFile(compression_, path, []() { return true; });
+}
+
+bool FileCompressor::Throttle(int64_t cpu_ns, int64_t wall_ns) noexcept {
+  // Sleep until the CPU time is the configured share of the elapsed time.
+  const int64_t pause = cpu_ns * 100 / static_cast<int64_t>(cpu_percent_) - wall_ns;
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (pause > 0) {
+    (void)wake_.wait_for(lock, std::chrono::nanoseconds(pause), [this]() { return stopping_; });
+  }
+  return !stopping_;
+}
+
+void FileCompressor::Run() noexcept {
+  (void)::pthread_setname_np(::pthread_self(), "ara-log-zip");
+#ifdef __linux__
+  // The nice value of a Linux thread is its own.
+  (void)::setpriority(PRIO_PROCESS, static_cast<id_t>(CurrentThreadId()), kLowestPriority);
+#endif
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    if (queue_.empty()) {
+      idle_.notify_all();
+      wake_.wait(lock);
+      continue;
+    }
+    const std::string path = std::move(queue_.front());
+    queue_.pop_front();
+    busy_ = true;
+    lock.unlock();
+    const int64_t cpu = Nanoseconds(CLOCK_THREAD_CPUTIME_ID);
+    const int64_t wall = Nanoseconds(CLOCK_MONOTONIC);
+    const bool compressed = CompressFile(compression_, path, [this, cpu, wall]() {
+      return Throttle(Nanoseconds(CLOCK_THREAD_CPUTIME_ID) - cpu, Nanoseconds(CLOCK_MONOTONIC) - wall);
+    });
+    if (compressed && done_) {
+      done_();
+    }
+    lock.lock();
+    busy_ = false;
+  }
+  idle_.notify_all();
+}
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
@@ -0,0 +1,948 @@
+/*
+ * @Description: native file sink, mmap backed rotating log files
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include "ara/log/file_sink.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ara/log/log_field.h"
+#include "ara/log/logmanager.h"
+
+namespace ara {
+namespace log {
+namespace internal {
+
+namespace {
+
+// Smallest file, a record of the DLT user buffer must always fit.
+constexpr std::size_t kMinFileSize = 4096U;
+
+constexpr char kEcuId[DLT_ID_SIZE] = {'E', 'C', 'U', '1'};
+
+// DLT storage and protocol headers, see tools/log_decoder.cpp.
+constexpr std::size_t kStorageHeaderSize = 16U;
+constexpr std::size_t kStandardHeaderSize = 4U + 4U + 4U;  // with ECU ID and timestamp
+constexpr std::size_t kExtendedHeaderSize = 10U;
+constexpr uint8_t kUseExtendedHeader = 0x01U;
+constexpr uint8_t kMostSignificantByteFirst = 0x02U;
+constexpr uint8_t kWithEcuId = 0x04U;
+constexpr uint8_t kWithTimestamp = 0x10U;
+constexpr uint8_t kProtocolVersion1 = 0x20U;
+constexpr uint8_t kVerbose = 0x01U;
+
+// Verbose argument type info.
+constexpr uint32_t kTypeLength = 0x0000000FU;
+constexpr uint32_t kTypeBool = 0x00000010U;
+constexpr uint32_t kTypeSigned = 0x00000020U;
+constexpr uint32_t kTypeUnsigned = 0x00000040U;
+constexpr uint32_t kTypeFloat = 0x00000080U;
+constexpr uint32_t kTypeString = 0x00000200U;
+constexpr uint32_t kTypeRaw = 0x00000400U;
+constexpr uint32_t kTypeVariableInfo = 0x00000800U;
+constexpr uint32_t kTypeCoding = 0x00038000U;
+constexpr uint32_t kCodingHex = 0x00010000U;
+constexpr uint32_t kCodingBin = 0x00018000U;
+
+bool IsBigEndianHost() noexcept {
+  const uint16_t probe = 1U;
+  uint8_t first = 0U;
+  std::memcpy(&first, &probe, 1U);
+  return first == 0U;
+}
+
+void PutBigEndian16(char* out, uint16_t value) noexcept {
+  out[0] = static_cast<char>(value >> 8U);
+  out[1] = static_cast<char>(value);
+}
+
+void PutBigEndian32(char* out, uint32_t value) noexcept {
+  for (std::size_t i = 0U; i < 4U; ++i) {
+    out[i] = static_cast<char>(value >> (24U - 8U * i));
+  }
+}
+
+void PutLittleEndian32(char* out, uint32_t value) noexcept {
+  for (std::size_t i = 0U; i < 4U; ++i) {
+    out[i] = static_cast<char>(value >> (8U * i));
+  }
+}
+
+const char* LevelName(int32_t level) noexcept {
+  switch (level) {
+    case DltLogLevelType::DLT_LOG_FATAL:
+      return "fatal";
+    case DltLogLevelType::DLT_LOG_ERROR:
+      return "error";
+    case DltLogLevelType::DLT_LOG_WARN:
+      return "warn";
+    case DltLogLevelType::DLT_LOG_INFO:
+      return "info";
+    case DltLogLevelType::DLT_LOG_DEBUG:
+      return "debug";
+    case DltLogLevelType::DLT_LOG_VERBOSE:
+      return "verbose";
+    default:
+      return "";
+  }
+}
+
+void Appendf(std::string& out, const char* format, ...) noexcept __attribute__((format(printf, 2, 3)));
+
+void Appendf(std::string& out, const char* format, ...) noexcept {
+  char text[64];
+  va_list args;
+  va_start(args, format);
+  const int length = std::vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  if (length > 0) {
+    out.append(text, std::min(static_cast<std::size_t>(length), sizeof(text) - 1U));
+  }
+}
+
+// Reads the verbose payload DLT has written in host byte order.
+class PayloadReader final {
+ public:
+  PayloadReader(const unsigned char* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  bool Read(void* value, std::size_t bytes) noexcept {
+    if (size_ - pos_ < bytes) {
+      return false;
+    }
+    std::memcpy(value, data_ + pos_, bytes);
+    pos_ += bytes;
+    return true;
+  }
+
+  bool Skip(std::size_t bytes, const char*& text) noexcept {
+    if (size_ - pos_ < bytes) {
+      return false;
+    }
+    text = reinterpret_cast<const char*>(data_ + pos_);
+    pos_ += bytes;
+    return true;
+  }
+
+  bool AtEnd() const noexcept { return pos_ == size_; }
+
+ private:
+  const unsigned char* data_;
+  std::size_t size_;
+  std::size_t pos_ = 0U;
+};
+
+template <typename T>
+T LoadValue(const char* data) noexcept {
+  T value{};
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+// Structured field of LogStream::With() as "#<key ID>=value", the key text is only in the binary.
+bool AppendField(const char* data, std::size_t length, std::string& out) noexcept {
+  if ((length < kFieldHeaderSize) || (static_cast<uint8_t>(data[0]) != kFieldTag)) {
+    return false;
+  }
+  const char code = data[1];
+  const char* const value = data + kFieldHeaderSize;
+  const std::size_t size = length - kFieldHeaderSize;
+  std::size_t expected = size;
+  switch (code) {
+    case 'b':
+    case 'c':
+    case 'C':
+      expected = 1U;
+      break;
+    case 'h':
+    case 'H':
+      expected = 2U;
+      break;
+    case 'i':
+    case 'I':
+    case 'f':
+      expected = 4U;
+      break;
+    case 'l':
+    case 'L':
+    case 'd':
+      expected = 8U;
+      break;
+    case 's':
+      break;
+    default:
+      return false;
+  }
+  if (size != expected) {
+    return false;
+  }
+  Appendf(out, "#%08" PRIx32 "=", LoadValue<uint32_t>(data + 2U));
+  switch (code) {
+    case 'b':
+      out.append(value[0] != 0 ? "true" : "false");
+      break;
+    case 'c':
+      Appendf(out, "%d", static_cast<int>(LoadValue<int8_t>(value)));
+      break;
+    case 'C':
+      Appendf(out, "%u", static_cast<unsigned>(LoadValue<uint8_t>(value)));
+      break;
+    case 'h':
+      Appendf(out, "%d", static_cast<int>(LoadValue<int16_t>(value)));
+      break;
+    case 'H':
+      Appendf(out, "%u", static_cast<unsigned>(LoadValue<uint16_t>(value)));
+      break;
+    case 'i':
+      Appendf(out, "%" PRId32, LoadValue<int32_t>(value));
+      break;
+    case 'I':
+      Appendf(out, "%" PRIu32, LoadValue<uint32_t>(value));
+      break;
+    case 'l':
+      Appendf(out, "%" PRId64, LoadValue<int64_t>(value));
+      break;
+    case 'L':
+      Appendf(out, "%" PRIu64, LoadValue<uint64_t>(value));
+      break;
+    case 'f':
+      Appendf(out, "%g", static_cast<double>(LoadValue<float>(value)));
+      break;
+    case 'd':
+      Appendf(out, "%g", LoadValue<double>(value));
+      break;
+    default:
+      out.append(value, size);
+      break;
+  }
+  return true;
+}
+
+bool AppendArgument(PayloadReader& payload, std::string& out) noexcept {
+  uint32_t type = 0U;
+  if (!payload.Read(&type, sizeof(type))) {
+    return false;
+  }
+  const std::size_t bytes = (type & kTypeLength) == 0U ? 0U : (std::size_t{1} << ((type & kTypeLength) - 1U));
+  const bool numeric = (type & (kTypeSigned | kTypeUnsigned | kTypeFloat)) != 0U;
+  const bool sized = (type & (kTypeString | kTypeRaw)) != 0U;
+  // Strings and raw data start with their length, then comes the variable info.
+  uint16_t length = 0U;
+  if (sized && !payload.Read(&length, sizeof(length))) {
+    return false;
+  }
+  uint16_t nameLength = 0U;
+  uint16_t unitLength = 0U;
+  const char* name = nullptr;
+  const char* unit = nullptr;
+  if ((type & kTypeVariableInfo) != 0U) {
+    if (!payload.Read(&nameLength, sizeof(nameLength)) ||
+        (numeric && !payload.Read(&unitLength, sizeof(unitLength))) || !payload.Skip(nameLength, name) ||
+        !payload.Skip(unitLength, unit)) {
+      return false;
+    }
+    // Both are written with their terminating zero.
+    nameLength = static_cast<uint16_t>(strnlen(name, nameLength));
+    unitLength = static_cast<uint16_t>(strnlen(unit, unitLength));
+    if (nameLength != 0U) {
+      out.append(name, nameLength).append(1U, ':');
+    }
+  }
+
+  if ((type & kTypeBool) != 0U) {
+    uint8_t value = 0U;
+    if (!payload.Read(&value, sizeof(value))) {
+      return false;
+    }
+    out.append(value != 0U ? "true" : "false");
+  } else if (((type & (kTypeSigned | kTypeUnsigned)) != 0U) && (bytes >= 1U) && (bytes <= 8U)) {
+    uint64_t raw = 0U;
+    unsigned char value[8] = {};
+    if (!payload.Read(value, bytes)) {
+      return false;
+    }
+    for (std::size_t i = 0U; i < bytes; ++i) {
+      // Payload is in host byte order.
+      const std::size_t shift = IsBigEndianHost() ? 8U * (bytes - 1U - i) : 8U * i;
+      raw |= static_cast<uint64_t>(value[i]) << shift;
+    }
+    if ((type & kTypeSigned) != 0U) {
+      const std::size_t unused = 64U - 8U * bytes;
+      Appendf(out, "%" PRId64, static_cast<int64_t>(raw << unused) >> unused);
+    } else if ((type & kTypeCoding) == kCodingHex) {
+      Appendf(out, "0x%0*" PRIx64, static_cast<int>(2U * bytes), raw);
+    } else if ((type & kTypeCoding) == kCodingBin) {
+      out.append("0b");
+      for (std::size_t bit = 8U * bytes; bit > 0U; --bit) {
+        out.append(1U, ((raw >> (bit - 1U)) & 1U) != 0U ? '1' : '0');
+      }
+    } else {
+      Appendf(out, "%" PRIu64, raw);
+    }
+  } else if ((type & kTypeFloat) != 0U) {
+    if (bytes == sizeof(float)) {
+      float value = 0.0F;
+      if (!payload.Read(&value, sizeof(value))) {
+        return false;
+      }
+      Appendf(out, "%g", static_cast<double>(value));
+    } else if (bytes == sizeof(double)) {
+      double value = 0.0;
+      if (!payload.Read(&value, sizeof(value))) {
+        return false;
+      }
+      Appendf(out, "%g", value);
+    } else {
+      return false;
+    }
+  } else if (sized) {
+    const char* text = nullptr;
+    if (!payload.Skip(length, text)) {
+      return false;
+    }
+    if ((type & kTypeString) != 0U) {
+      out.append(text, strnlen(text, length));
+    } else if (!AppendField(text, length, out)) {
+      for (uint16_t i = 0U; i < length; ++i) {
+        Appendf(out, i == 0U ? "%02x" : "'%02x", static_cast<unsigned>(static_cast<unsigned char>(text[i])));
+      }
+    }
+  } else {
+    // Arrays, structs, fixed point and trace info aren't written by ara::log.
+    return false;
+  }
+  if (unitLength != 0U) {
+    out.append(1U, ' ').append(unit, unitLength);
+  }
+  return true;
+}
+
+// Text of the payload as "[arg1 arg2 ...]", non-verbose records as
+// "[message ID] argument bytes", ara-log-decoder restores those from a .dlt file.
+void AppendPayload(const DltContextData& record, bool verbose, std::string& out) noexcept {
+  const unsigned char* data = record.buffer;
+  const std::size_t size = static_cast<std::size_t>(record.size);
+  out.append(1U, '[');
+  if (verbose) {
+    PayloadReader payload(data, size);
+    for (int32_t i = 0; (i < record.args_num) && !payload.AtEnd(); ++i) {
+      if (i != 0) {
+        out.append(1U, ' ');
+      }
+      if (!AppendArgument(payload, out)) {
+        out.append("<undecodable>");
+        break;
+      }
+    }
+    out.append(1U, ']');
+    return;
+  }
+  uint32_t messageId = 0U;
+  std::size_t pos = std::min(size, sizeof(messageId));
+  std::memcpy(&messageId, data, pos);
+  Appendf(out, "%" PRIu32 "]", messageId);
+  for (; pos < size; ++pos) {
+    Appendf(out, " %02x", static_cast<unsigned>(data[pos]));
+  }
+}
+
+// "YYYY/MM/DD HH:MM:SS" of the current second, localtime_r() takes a lock
+// and reads the zone, do it once per second and thread.
+const char* FormatSecond(time_t second) noexcept {
+  thread_local time_t t_second = -1;
+  thread_local char t_text[32] = {};
+  if (second != t_second) {
+    struct tm local {};
+    if ((localtime_r(&second, &local) == nullptr) ||
+        (std::strftime(t_text, sizeof(t_text), "%Y/%m/%d %H:%M:%S", &local) == 0U)) {
+      (void)std::snprintf(t_text, sizeof(t_text), "%lld", static_cast<long long>(second));
+    }
+    t_second = second;
+  }
+  return t_text;
+}
+
+void AppendId(std::string& out, const char* id) noexcept { out.append(id, strnlen(id, DLT_ID_SIZE)); }
+
+}  // namespace
+
+RotatingFile::~RotatingFile() { Close(); }
+
+bool RotatingFile::Open(const FileSinkConfig& config) noexcept {
+  Close();
+  try {
+    config_ = config;
+    const std::string::size_type dot = config.file_name.rfind('.');
+    if ((dot == std::string::npos) || (dot == 0U)) {
+      stem_ = config.directory + "/" + config.file_name;
+      extension_ = config.file_encode == FileEncode::kBinary ? ".dlt" : ".txt";
+    } else {
+      stem_ = config.directory + "/" + config.file_name.substr(0U, dot);
+      extension_ = config.file_name.substr(dot);
+    }
+    capacity_ = std::max(static_cast<std::size_t>(config.file_size), kMinFileSize);
+    // Before this run creates hidden files of its own.
+    CleanUp();
+
+    if (!compressor_.Start(config.compression, config.compress_cpu_percent, [this]() { RemoveOldFiles(); })) {
+      return false;
+    }
+    bool prepared = false;
+    {
+      const std::lock_guard<std::mutex> removing(remove_mutex_);
+      const std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = false;
+      prepare_failed_ = false;
+      current_.id = next_id_++;
+      prepared = Prepare(current_);
+      if (prepared) {
+        const time_t now = time(nullptr);
+        Renamed(current_.id, RenameFile(Rename{current_.id, current_.path, now}));
+        rotate_at_ = NextRotation(now);
+        worker_ = std::thread(&RotatingFile::Run, this);
+      }
+    }
+    if (!prepared) {
+      // Outside the locks, its callback takes them.
+      compressor_.Stop();
+      return false;
+    }
+  } catch (const std::exception&) {
+    compressor_.Stop();
+    Discard(current_);
+    return false;
+  }
+  CompressLeftovers();
+  RemoveOldFiles();
+  return true;
+}
+
+void RotatingFile::Close() noexcept {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  // Finish what the background thread has not, the compressor may still be removing files.
+  bool opened = false;
+  std::string last;
+  {
+    const std::lock_guard<std::mutex> removing(remove_mutex_);
+    const std::lock_guard<std::mutex> lock(mutex_);
+    opened = current_.map != nullptr;
+    while (!renames_.empty()) {
+      Renamed(renames_.front().id, RenameFile(renames_.front()));
+      renames_.pop_front();
+    }
+    for (Segment& segment : retired_) {
+      Finish(segment);
+    }
+    retired_.clear();
+    try {
+      last = current_.path;
+    } catch (const std::bad_alloc&) {
+    }
+    Finish(current_);
+    Discard(standby_);
+  }
+  // The last file is compressed by the next run.
+  compressor_.Stop();
+  if (opened) {
+    RemoveOldFiles(last);
+  }
+}
+
+void RotatingFile::Write(const char* data, std::size_t size, time_t now) noexcept {
+  size = std::min(size, capacity_);
+  const std::lock_guard<std::mutex> lock(mutex_);
+  if (current_.map == nullptr) {
+    return;
+  }
+  if ((now >= rotate_at_) || (size > capacity_ - current_.used)) {
+    if (!Rotate(now) && (size > capacity_ - current_.used)) {
+      return;
+    }
+  }
+  std::memcpy(current_.map + current_.used, data, size);
+  current_.used += size;
+}
+
+void RotatingFile::Sync() noexcept {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this]() {
+    return stopping_ || (!busy_ && renames_.empty() && retired_.empty() &&
+                         ((standby_.map != nullptr) || prepare_failed_));
+  });
+  lock.unlock();
+  compressor_.Sync();
+}
+
+std::string RotatingFile::CurrentPath() const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return current_.path;
+}
+
+bool RotatingFile::Prepare(Segment& segment) const noexcept {
+  try {
+    segment.path = TemporaryPath(segment.id);
+  } catch (const std::exception&) {
+    return false;
+  }
+  segment.used = 0U;
+  segment.fd = ::open(segment.path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (segment.fd < 0) {
+    return false;
+  }
+  // Reserve the blocks now, a write to a hole of the mapping would allocate
+  // them on the logging thread and raise SIGBUS once the disk is full.
+#ifdef __linux__
+  int reserved = ::fallocate(segment.fd, 0, 0, static_cast<off_t>(capacity_));
+#else
+  int reserved = ::posix_fallocate(segment.fd, 0, static_cast<off_t>(capacity_));
+#endif
+  if (reserved != 0) {
+    // Not supported by the file system, map a sparse file.
+    reserved = ::ftruncate(segment.fd, static_cast<off_t>(capacity_));
+  }
+  void* map = MAP_FAILED;
+  if (reserved == 0) {
+    map = ::mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+  }
+  if (map == MAP_FAILED) {
+    (void)::close(segment.fd);
+    (void)::unlink(segment.path.c_str());
+    segment.fd = -1;
+    return false;
+  }
+  (void)::madvise(map, capacity_, MADV_SEQUENTIAL);
+  segment.map = static_cast<char*>(map);
+  return true;
+}
+
+void RotatingFile::Finish(Segment& segment) const noexcept {
+  if (segment.map != nullptr) {
+    (void)::munmap(segment.map, capacity_);
+  }
+  if (segment.fd >= 0) {
+    // Give back the preallocated tail.
+    (void)::ftruncate(segment.fd, static_cast<off_t>(segment.used));
+    (void)::close(segment.fd);
+  }
+  segment = Segment();
+}
+
+void RotatingFile::Discard(Segment& segment) const noexcept {
+  if (segment.fd >= 0) {
+    (void)::unlink(segment.path.c_str());
+  }
+  segment.used = 0U;
+  Finish(segment);
+}
+
+bool RotatingFile::Rotate(time_t now) noexcept {
+  Segment next;
+  if (standby_.map != nullptr) {
+    next = standby_;
+    standby_ = Segment();
+  } else {
+    // The background thread has fallen behind or could not create the file.
+    next.id = next_id_++;
+    if (!Prepare(next)) {
+      rotate_at_ = NextRotation(now);
+      return false;
+    }
+  }
+  try {
+    renames_.push_back(Rename{next.id, next.path, now});
+    retired_.push_back(current_);
+  } catch (const std::bad_alloc&) {
+    Discard(next);
+    return false;
+  }
+  current_ = next;
+  rotate_at_ = NextRotation(now);
+  prepare_failed_ = false;
+  wake_.notify_one();
+  return true;
+}
+
+time_t RotatingFile::NextRotation(time_t now) const noexcept {
+  time_t period = 0;
+  switch (config_.file_save_mode) {
+    case FileSaveMode::kMinutely:
+      period = 60;
+      break;
+    case FileSaveMode::kHourly:
+      period = 3600;
+      break;
+    case FileSaveMode::kDaily:
+      period = 86400;
+      break;
+    default:
+      return std::numeric_limits<time_t>::max();
+  }
+  // Periods start at full minutes, hours and days of the local time.
+  struct tm local {};
+  const time_t offset = (localtime_r(&now, &local) != nullptr) ? static_cast<time_t>(local.tm_gmtoff) : 0;
+  return ((now + offset) / period + 1) * period - offset;
+}
+
+std::string RotatingFile::TemporaryPath(uint64_t id) const {
+  const std::string::size_type slash = stem_.rfind('/');
+  return stem_.substr(0U, slash + 1U) + "." + stem_.substr(slash + 1U) + extension_ + "." + std::to_string(id);
+}
+
+std::string RotatingFile::RenameFile(const Rename& job) noexcept {
+  try {
+    struct tm local {};
+    char stamp[32] = "00000000-000000";
+    if (localtime_r(&job.opened, &local) != nullptr) {
+      (void)std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+    }
+    // Files of the same second are numbered on, names freed by the retention
+    // must not be taken again. Never replace a file, e.g. of a previous run,
+    // compressed or not.
+    const auto name = [this, &stamp](uint32_t sequence) {
+      char number[16] = {};
+      if (sequence != 0U) {
+        (void)std::snprintf(number, sizeof(number), "_%03u", static_cast<unsigned>(sequence));
+      }
+      return stem_ + "_" + stamp + number + extension_;
+    };
+    const auto taken = [](const std::string& path) {
+      return (::access(path.c_str(), F_OK) == 0) ||
+             (::access((path + CompressedExtension(FileCompression::kGzip)).c_str(), F_OK) == 0) ||
+             (::access((path + CompressedExtension(FileCompression::kZstd)).c_str(), F_OK) == 0);
+    };
+    uint32_t sequence = (last_stamp_ == stamp) ? last_sequence_ + 1U : 0U;
+    std::string path = name(sequence);
+    while (taken(path)) {
+      path = name(++sequence);
+    }
+    if (::rename(job.from.c_str(), path.c_str()) == 0) {
+      last_stamp_ = stamp;
+      last_sequence_ = sequence;
+      return path;
+    }
+  } catch (const std::exception&) {
+  }
+  return job.from;
+}
+
+void RotatingFile::Renamed(uint64_t id, const std::string& path) noexcept {
+  try {
+    if (current_.id == id) {
+      current_.path = path;
+    }
+    for (Segment& segment : retired_) {
+      if (segment.id == id) {
+        segment.path = path;
+      }
+    }
+  } catch (const std::bad_alloc&) {
+  }
+}
+
+std::vector<RotatingFile::LogFile> RotatingFile::ListFiles() const {
+  constexpr std::size_t kStampSize = 15U;  // YYYYmmdd-HHMMSS
+  const std::string::size_type slash = stem_.rfind('/');
+  const std::string directory = stem_.substr(0U, slash);
+  const std::string prefix = stem_.substr(slash + 1U) + "_";
+  std::vector<LogFile> files;
+  DIR* const dir = ::opendir(directory.c_str());
+  if (dir == nullptr) {
+    return files;
+  }
+  try {
+    while (const struct dirent* const entry = ::readdir(dir)) {
+      // "<stem>_YYYYmmdd-HHMMSS[_n]<ext>[.gz|.zst]", compressed with any setting
+      const std::string name = entry->d_name;
+      std::string::size_type end = name.rfind(extension_);
+      if ((end == std::string::npos) || (end < prefix.size() + kStampSize) ||
+          (name.compare(0U, prefix.size(), prefix) != 0) || (name[prefix.size() + 8U] != '-')) {
+        continue;
+      }
+      const std::string suffix = name.substr(end + extension_.size());
+      if (!suffix.empty() && (suffix != CompressedExtension(FileCompression::kGzip)) &&
+          (suffix != CompressedExtension(FileCompression::kZstd))) {
+        continue;
+      }
+      const std::string::size_type sequence = prefix.size() + kStampSize;
+      LogFile file;
+      file.stamp = name.substr(prefix.size(), kStampSize);
+      file.sequence = (name[sequence] == '_') ? std::strtoul(name.c_str() + sequence + 1U, nullptr, 10) : 0U;
+      file.path = directory + "/" + name;
+      file.compressed = !suffix.empty();
+      files.push_back(std::move(file));
+    }
+  } catch (const std::exception&) {
+    (void)::closedir(dir);
+    throw;
+  }
+  (void)::closedir(dir);
+  // Oldest first, the current file is the newest.
+  std::sort(files.begin(), files.end(), [](const LogFile& lhs, const LogFile& rhs) {
+    return (lhs.stamp != rhs.stamp) ? (lhs.stamp < rhs.stamp) : (lhs.sequence < rhs.sequence);
+  });
+  return files;
+}
+
+void RotatingFile::RemoveOldFiles(const std::string& keep) const noexcept {
+  if (config_.max_files == 0U) {
+    return;
+  }
+  try {
+    const std::lock_guard<std::mutex> removing(remove_mutex_);
+    // The files in use are never removed, whatever their stamps say: the clock
+    // may have been set back since. They count first.
+    std::vector<std::string> in_use{keep};
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      in_use.push_back(current_.path);
+      in_use.push_back(standby_.path);
+      for (const Segment& segment : retired_) {
+        in_use.push_back(segment.path);
+      }
+      for (const Rename& job : renames_) {
+        in_use.push_back(job.from);
+      }
+    }
+    const auto used = [&in_use](const LogFile& file) {
+      return std::find(in_use.begin(), in_use.end(), file.path) != in_use.end();
+    };
+    const std::vector<LogFile> files = ListFiles();
+    std::size_t kept = static_cast<std::size_t>(std::count_if(files.begin(), files.end(), used));
+    // A file counts once while it is both compressed and not yet removed.
+    for (std::size_t i = files.size(); i > 0U; --i) {
+      const LogFile& file = files[i - 1U];
+      if (used(file)) {
+        continue;
+      }
+      const bool same = (i < files.size()) && (files[i].stamp == file.stamp) && (files[i].sequence == file.sequence);
+      if (!same) {
+        ++kept;
+      }
+      if (kept > config_.max_files) {
+        (void)::unlink(file.path.c_str());
+      }
+    }
+  } catch (const std::exception&) {
+  }
+}
+
+void RotatingFile::CleanUp() const noexcept {
+  try {
+    const std::string::size_type slash = stem_.rfind('/');
+    const std::string directory = stem_.substr(0U, slash);
+    // Hidden files of an earlier run: the next file "." + name + ext + ".<n>" and
+    // compressor output "." + name + "_..." + ".part".
+    const std::string hidden = "." + stem_.substr(slash + 1U);
+    DIR* const dir = ::opendir(directory.c_str());
+    if (dir != nullptr) {
+      std::vector<std::string> stale;
+      while (const struct dirent* const entry = ::readdir(dir)) {
+        const std::string name = entry->d_name;
+        if ((name.compare(0U, hidden.size() + extension_.size() + 1U, hidden + extension_ + ".") == 0) ||
+            ((name.compare(0U, hidden.size() + 1U, hidden + "_") == 0) && (name.size() > 5U) &&
+             (name.compare(name.size() - 5U, 5U, ".part") == 0))) {
+          stale.push_back(directory + "/" + name);
+        }
+      }
+      (void)::closedir(dir);
+      for (const std::string& path : stale) {
+        (void)::unlink(path.c_str());
+      }
+    }
+  } catch (const std::exception&) {
+  }
+}
+
+void RotatingFile::CompressLeftovers() noexcept {
+  try {
+    // Files an earlier run has not got to compress.
+    const std::string current = CurrentPath();
+    for (const LogFile& file : ListFiles()) {
+      if (!file.compressed && (file.path != current)) {
+        compressor_.Enqueue(file.path);
+      }
+    }
+  } catch (const std::exception&) {
+  }
+}
+
+void RotatingFile::Run() noexcept {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    if (!renames_.empty()) {
+      const Rename job = renames_.front();
+      renames_.pop_front();
+      busy_ = true;
+      lock.unlock();
+      {
+        // The compressor's RemoveOldFiles() sees the file under one of its names.
+        const std::lock_guard<std::mutex> removing(remove_mutex_);
+        const std::string path = RenameFile(job);
+        lock.lock();
+        Renamed(job.id, path);
+        lock.unlock();
+      }
+      RemoveOldFiles();
+      lock.lock();
+      busy_ = false;
+    } else if (!retired_.empty()) {
+      Segment segment = retired_.front();
+      retired_.pop_front();
+      busy_ = true;
+      lock.unlock();
+      const std::string path = std::move(segment.path);
+      Finish(segment);
+      compressor_.Enqueue(path);
+      lock.lock();
+      busy_ = false;
+    } else if ((standby_.map == nullptr) && !prepare_failed_) {
+      Segment segment;
+      segment.id = next_id_++;
+      busy_ = true;
+      lock.unlock();
+      const bool prepared = Prepare(segment);
+      lock.lock();
+      busy_ = false;
+      if (prepared && (standby_.map == nullptr) && !stopping_) {
+        standby_ = segment;
+      } else {
+        prepare_failed_ = !prepared;
+        Discard(segment);
+      }
+    } else {
+      idle_.notify_all();
+      wake_.wait(lock);
+    }
+  }
+  idle_.notify_all();
+}
+
+uint32_t Uptime() noexcept {
+  struct timespec ts {};
+  (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint32_t>(static_cast<uint64_t>(ts.tv_sec) * 10000U +
+                               static_cast<uint64_t>(ts.tv_nsec) / 100000U);
+}
+
+std::size_t StoragePayloadSize(const DltContextData& record) noexcept {
+  return std::min(static_cast<std::size_t>(record.size),
+                  std::size_t{std::numeric_limits<uint16_t>::max()} - kStandardHeaderSize - kExtendedHeaderSize);
+}
+
+void EncodeStorageHeader(const DltContextData& record, const char (&app_id)[DLT_ID_SIZE], const struct timespec& wall,
+                         uint32_t uptime, char* out) noexcept {
+  static_assert(kStorageRecordHeaderSize == kStorageHeaderSize + kStandardHeaderSize + kExtendedHeaderSize,
+                "header size");
+  // DLT applies the message mode to the whole application.
+  const bool verbose = !ModeledMessageMode();
+  std::memcpy(out, "DLT\x01", 4U);
+  PutLittleEndian32(out + 4U, static_cast<uint32_t>(wall.tv_sec));
+  PutLittleEndian32(out + 8U, static_cast<uint32_t>(wall.tv_nsec / 1000));
+  std::memcpy(out + 12U, kEcuId, DLT_ID_SIZE);
+  out += kStorageHeaderSize;
+  out[0] = static_cast<char>(kUseExtendedHeader | kWithEcuId | kWithTimestamp | kProtocolVersion1 |
+                             (IsBigEndianHost() ? kMostSignificantByteFirst : 0U));
+  out[1] = static_cast<char>(record.handle->mcnt);  // DLT takes it with the record
+  PutBigEndian16(out + 2U,
+                 static_cast<uint16_t>(kStandardHeaderSize + kExtendedHeaderSize + StoragePayloadSize(record)));
+  std::memcpy(out + 4U, kEcuId, DLT_ID_SIZE);
+  PutBigEndian32(out + 8U, uptime);
+  out += kStandardHeaderSize;
+  // Message type log (0), the level as subtype.
+  out[0] = static_cast<char>((static_cast<uint32_t>(record.log_level) << 4U) | (verbose ? kVerbose : 0U));
+  out[1] = static_cast<char>(std::min(record.args_num, int32_t{std::numeric_limits<uint8_t>::max()}));
+  std::memcpy(out + 2U, app_id, DLT_ID_SIZE);
+  std::memcpy(out + 6U, record.handle->contextID, DLT_ID_SIZE);
+}
+
+FileSink& FileSink::instance() noexcept {
+  // Leaked on purpose, like the asynchronous back-end.
+  static FileSink* const inst = new FileSink();
+  return *inst;
+}
+
+bool FileSink::Start(const FileSinkConfig& config) noexcept {
+  const std::lock_guard<std::mutex> lock(control_mutex_);
+  running_.store(false, std::memory_order_release);
+  encode_ = config.file_encode;
+  forward_to_dlt_.store(config.forward_to_dlt, std::memory_order_release);
+  std::memset(app_id_, 0, sizeof(app_id_));
+  std::memcpy(app_id_, config.app_id.data(), std::min(config.app_id.size(), sizeof(app_id_)));
+  if (!file_.Open(config)) {
+    return false;
+  }
+  running_.store(true, std::memory_order_release);
+  return true;
+}
+
+void FileSink::Stop() noexcept {
+  const std::lock_guard<std::mutex> lock(control_mutex_);
+  running_.store(false, std::memory_order_release);
+  forward_to_dlt_.store(true, std::memory_order_release);
+  file_.Close();
+}
+
+void FileSink::Write(const DltContextData& record) noexcept {
+  if ((record.handle == nullptr) || (record.buffer == nullptr) || (record.size <= 0)) {
+    return;
+  }
+  struct timespec wall {};
+  (void)clock_gettime(CLOCK_REALTIME, &wall);
+  const uint32_t uptime = Uptime();
+
+  thread_local std::string t_out;
+  try {
+    t_out.clear();
+    if (encode_ == FileEncode::kBinary) {
+      t_out.resize(kStorageRecordHeaderSize);
+      EncodeStorageHeader(record, app_id_, wall, uptime, &t_out[0]);
+      t_out.append(reinterpret_cast<const char*>(record.buffer), StoragePayloadSize(record));
+    } else {
+      // DLT applies the message mode to the whole application.
+      const bool verbose = !ModeledMessageMode();
+      const uint8_t counter = record.handle->mcnt;  // DLT takes it with the record
+      // 2022/06/22 17:27:46.396979 1996466923 024 ECU1 TSEN LOG- log info V 1 [...]
+      t_out.append(FormatSecond(wall.tv_sec));
+      Appendf(t_out, ".%06ld %" PRIu32 " %03u ", static_cast<long>(wall.tv_nsec / 1000), uptime,
+              static_cast<unsigned>(counter));
+      AppendId(t_out, kEcuId);
+      t_out.append(1U, ' ');
+      AppendId(t_out, app_id_);
+      t_out.append(1U, ' ');
+      AppendId(t_out, record.handle->contextID);
+      Appendf(t_out, " log %s %s %d ", LevelName(record.log_level), verbose ? "V" : "N",
+              static_cast<int>(record.args_num));
+      AppendPayload(record, verbose, t_out);
+      t_out.append(1U, '\n');
+    }
+  } catch (const std::bad_alloc&) {
+    return;
+  }
+  file_.Write(t_out.data(), t_out.size(), wall.tv_sec);
+}
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
@@ -10,221 +10,246 @@
  */
 
 #include "ara/log/log_stream.h"
+#include "ara/log/async_backend.h"
+#include "ara/log/crash_ring.h"
+#include "ara/log/file_sink.h"
 #include "ara/log/logger.h"
+#include "ara/log/rate_limiter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace ara {
 namespace log {
 
+namespace {
+
+// Hands a finished record to the asynchronous back-end, or writes it right
+// away if that is not running. The crash ring gets its copy first, queued
+// records are lost with the process too.
+void FinishRecord(DltContextData& record) noexcept {
+  // Now and then the drops of rate limited call sites no later statement has reported.
+  thread_local uint32_t t_records = 0U;
+  if ((++t_records & 15U) == 0U) {
+    (void)internal::ReportSuppressed(false);
+  }
+  internal::CrashRing::instance().Write(record);
+  internal::AsyncBackend& backend = internal::AsyncBackend::instance();
+  if (record.log_level == DltLogLevelType::DLT_LOG_FATAL) {
+    // The process might not survive this record, write everything before it
+    // and then the record itself on this thread.
+    backend.Flush();
+  } else if (backend.Submit(record)) {
+    return;
+  }
+  internal::WriteRecord(record);
+}
+
+}  // namespace
+
 LogStream::LogStream(const LogLevel logLevel, Logger& logger) noexcept
-    : logRet_(DltReturnValue::DLT_RETURN_OK), logLocalData_(std::make_unique<DltContextData>(DltContextData())) {
-  DltLogLevelType log_level = DltLogLevelType::DLT_LOG_WARN;
-  switch (logLevel) {
-    case ara::log::LogLevel::kOff:
-      log_level = DltLogLevelType::DLT_LOG_OFF;
-      break;
-    case ara::log::LogLevel::kFatal:
-      log_level = DltLogLevelType::DLT_LOG_FATAL;
-      break;
-    case ara::log::LogLevel::kError:
-      log_level = DltLogLevelType::DLT_LOG_ERROR;
-      break;
-    case ara::log::LogLevel::kWarn:
-      log_level = DltLogLevelType::DLT_LOG_WARN;
-      break;
-    case ara::log::LogLevel::kInfo:
-      log_level = DltLogLevelType::DLT_LOG_INFO;
-      break;
-    case ara::log::LogLevel::kDebug:
-      log_level = DltLogLevelType::DLT_LOG_DEBUG;
-      break;
-    case ara::log::LogLevel::kVerbose:
-      log_level = DltLogLevelType::DLT_LOG_VERBOSE;
-      break;
-    default:
-      break;
+    : logRet_(DltReturnValue::DLT_RETURN_LOGGING_DISABLED), logLocalData_() {
+  if (logger.IsEnabled(logLevel)) {
+    // LogLevel matches DltLogLevelType one-to-one, see logger.cpp.
+    logRet_ = dlt_user_log_write_start(static_cast<DltContext*>(logger.getContext()), &logLocalData_,
+                                       static_cast<DltLogLevelType>(logLevel));
   }
+}
+
+template <typename T>
+LogStream::LogStream(const T& msgId, const LogLevel logLevel, Logger& logger) noexcept
+    : logRet_(DltReturnValue::DLT_RETURN_LOGGING_DISABLED), logLocalData_() {
   if (logger.IsEnabled(logLevel)) {
-    logRet_ = dlt_user_log_write_start(static_cast<DltContext*>(logger.getContext()), logLocalData_.get(), log_level);
-  } else {
-    logRet_ = DltReturnValue::DLT_RETURN_LOGGING_DISABLED;
+    logRet_ = dlt_user_log_write_start_id(static_cast<DltContext*>(logger.getContext()), &logLocalData_,
+                                          static_cast<DltLogLevelType>(logLevel), static_cast<uint32_t>(msgId));
   }
 }
 
+// DLT message IDs are 32 bit.
+template LogStream::LogStream(const uint32_t& msgId, const LogLevel logLevel, Logger& logger) noexcept;
+
+LogStream::LogStream(LogStream&& log_stream) noexcept
+    : logRet_(log_stream.logRet_), logLocalData_(log_stream.logLocalData_) {
+  // The record and its buffer belong to this stream now.
+  log_stream.logRet_ = DltReturnValue::DLT_RETURN_LOGGING_DISABLED;
+  log_stream.logLocalData_ = DltContextData();
+}
+
 LogStream::~LogStream() {
-  if (logLocalData_ != nullptr) {
-    if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-      if (logLocalData_->size == 0) {
-        if (logLocalData_->buffer) {
-          free(logLocalData_->buffer);
-          logLocalData_->buffer = NULL;
-        }
-      } else {
-        (void)dlt_user_log_write_finish(logLocalData_.get());
+  if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
+    if (logLocalData_.size == 0) {
+      if (logLocalData_.buffer) {
+        free(logLocalData_.buffer);
+        logLocalData_.buffer = NULL;
       }
+    } else {
+      FinishRecord(logLocalData_);
     }
   }
 }
 
 void LogStream::Flush() noexcept {
-  if (logLocalData_ != nullptr) {
-    if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-      if (logLocalData_->size == 0) {
-        if (logLocalData_->buffer) {
-          free(logLocalData_->buffer);
-          logLocalData_->buffer = NULL;
-        }
-      } else {
-        (void)dlt_user_log_write_finish(logLocalData_.get());
+  if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
+    if (logLocalData_.size == 0) {
+      if (logLocalData_.buffer) {
+        free(logLocalData_.buffer);
+        logLocalData_.buffer = NULL;
       }
+    } else {
+      FinishRecord(logLocalData_);
     }
-    logRet_ = dlt_user_log_write_start(
-        logLocalData_->handle, logLocalData_.get(), logLocalData_->log_level);
+  }
+  if (logLocalData_.handle != NULL) {
+    logRet_ = dlt_user_log_write_start(logLocalData_.handle, &logLocalData_, logLocalData_.log_level);
   }
 }
 
 LogStream& LogStream::operator<<(bool value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_bool(logLocalData_.get(), value);
+    (void)dlt_user_log_write_bool(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(uint8_t value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint8(logLocalData_.get(), value);
+    (void)dlt_user_log_write_uint8(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(uint16_t value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint16(logLocalData_.get(), value);
+    (void)dlt_user_log_write_uint16(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(uint32_t value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint32(logLocalData_.get(), value);
+    (void)dlt_user_log_write_uint32(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(uint64_t value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint64(logLocalData_.get(), value);
+    (void)dlt_user_log_write_uint64(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(int8_t value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_int8(logLocalData_.get(), value);
+    (void)dlt_user_log_write_int8(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(int16_t value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_int16(logLocalData_.get(), value);
+    (void)dlt_user_log_write_int16(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(int32_t value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_int32(logLocalData_.get(), value);
+    (void)dlt_user_log_write_int32(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(int64_t value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_int64(logLocalData_.get(), value);
+    (void)dlt_user_log_write_int64(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(float value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_float32(logLocalData_.get(), value);
+    (void)dlt_user_log_write_float32(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(double value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_float64(logLocalData_.get(), value);
+    (void)dlt_user_log_write_float64(&logLocalData_, value);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const LogHex8& value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint8_formatted(logLocalData_.get(), value.value, DLT_FORMAT_HEX8);
+    (void)dlt_user_log_write_uint8_formatted(&logLocalData_, value.value, DLT_FORMAT_HEX8);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const LogHex16& value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint16_formatted(logLocalData_.get(), value.value, DLT_FORMAT_HEX16);
+    (void)dlt_user_log_write_uint16_formatted(&logLocalData_, value.value, DLT_FORMAT_HEX16);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const LogHex32& value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint32_formatted(logLocalData_.get(), value.value, DLT_FORMAT_HEX32);
+    (void)dlt_user_log_write_uint32_formatted(&logLocalData_, value.value, DLT_FORMAT_HEX32);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const LogHex64& value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint64_formatted(logLocalData_.get(), value.value, DLT_FORMAT_HEX64);
+    (void)dlt_user_log_write_uint64_formatted(&logLocalData_, value.value, DLT_FORMAT_HEX64);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const LogBin8& value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint8_formatted(logLocalData_.get(), value.value, DLT_FORMAT_BIN8);
+    (void)dlt_user_log_write_uint8_formatted(&logLocalData_, value.value, DLT_FORMAT_BIN8);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const LogBin16& value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint16_formatted(logLocalData_.get(), value.value, DLT_FORMAT_BIN16);
+    (void)dlt_user_log_write_uint16_formatted(&logLocalData_, value.value, DLT_FORMAT_BIN16);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const LogBin32& value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint32_formatted(logLocalData_.get(), value.value, DLT_FORMAT_BIN32);
+    (void)dlt_user_log_write_uint32_formatted(&logLocalData_, value.value, DLT_FORMAT_BIN32);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const LogBin64& value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint64_formatted(logLocalData_.get(), value.value, DLT_FORMAT_BIN64);
+    (void)dlt_user_log_write_uint64_formatted(&logLocalData_, value.value, DLT_FORMAT_BIN64);
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const ara::core::StringView value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_utf8_string(logLocalData_.get(), ara::core::String(value).c_str());
+    // Written by length, no terminated copy of the view is needed. DLT cuts what doesn't fit the record.
+    const std::size_t size = std::min<std::size_t>(value.size(), std::numeric_limits<uint16_t>::max());
+    (void)dlt_user_log_write_sized_utf8_string(&logLocalData_, value.data(), static_cast<uint16_t>(size));
   }
   return *this;
 }
 
 LogStream& LogStream::operator<<(const char* const value) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_utf8_string(logLocalData_.get(), value);
+    (void)dlt_user_log_write_utf8_string(&logLocalData_, value);
   }
   return *this;
 }
@@ -233,7 +258,7 @@ LogStream& LogStream::operator<<(
     ara::core::Span<const ara::core::Byte> data) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
     (void)dlt_user_log_write_raw_formatted(
-        logLocalData_.get(),
+        &logLocalData_,
         static_cast<void*>(const_cast<ara::core::Byte*>(data.data())),
         static_cast<uint16_t>(data.size()), DLT_FORMAT_DEFAULT);
   }
@@ -242,21 +267,21 @@ LogStream& LogStream::operator<<(
 
 LogStream& LogStream::LogArgument(const ara::log::Argument<ara::core::String>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_string_attr(logLocalData_.get(), arg.arg_value.c_str(), arg.arg_name.c_str());
+    (void)dlt_user_log_write_string_attr(&logLocalData_, arg.arg_value.c_str(), arg.arg_name.c_str());
   }
   return *this;
 }
 
 LogStream& LogStream::LogArgument(const ara::log::Argument<bool>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_bool_attr(logLocalData_.get(), arg.arg_value, arg.arg_name.c_str());
+    (void)dlt_user_log_write_bool_attr(&logLocalData_, arg.arg_value, arg.arg_name.c_str());
   }
   return *this;
 }
 
 LogStream& LogStream::LogArgument(const ara::log::Argument<uint8_t>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_uint8_attr(logLocalData_.get(), arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
+    (void)dlt_user_log_write_uint8_attr(&logLocalData_, arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
   }
   return *this;
 }
@@ -264,7 +289,7 @@ LogStream& LogStream::LogArgument(const ara::log::Argument<uint8_t>& arg) noexce
 LogStream& LogStream::LogArgument(const ara::log::Argument<uint16_t>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
     (void)dlt_user_log_write_uint16_attr(
-        logLocalData_.get(), arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
+        &logLocalData_, arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
   }
   return *this;
 }
@@ -272,7 +297,7 @@ LogStream& LogStream::LogArgument(const ara::log::Argument<uint16_t>& arg) noexc
 LogStream& LogStream::LogArgument(const ara::log::Argument<uint32_t>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
     (void)dlt_user_log_write_uint32_attr(
-        logLocalData_.get(), arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
+        &logLocalData_, arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
   }
   return *this;
 }
@@ -280,35 +305,35 @@ LogStream& LogStream::LogArgument(const ara::log::Argument<uint32_t>& arg) noexc
 LogStream& LogStream::LogArgument(const ara::log::Argument<uint64_t>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
     (void)dlt_user_log_write_uint64_attr(
-        logLocalData_.get(), arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
+        &logLocalData_, arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
   }
   return *this;
 }
 
 LogStream& LogStream::LogArgument(const ara::log::Argument<int8_t>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_int8_attr(logLocalData_.get(), arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
+    (void)dlt_user_log_write_int8_attr(&logLocalData_, arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
   }
   return *this;
 }
 
 LogStream& LogStream::LogArgument(const ara::log::Argument<int16_t>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_int16_attr(logLocalData_.get(), arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
+    (void)dlt_user_log_write_int16_attr(&logLocalData_, arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
   }
   return *this;
 }
 
 LogStream& LogStream::LogArgument(const ara::log::Argument<int32_t>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_int32_attr(logLocalData_.get(), arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
+    (void)dlt_user_log_write_int32_attr(&logLocalData_, arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
   }
   return *this;
 }
 
 LogStream& LogStream::LogArgument(const ara::log::Argument<int64_t>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
-    (void)dlt_user_log_write_int64_attr(logLocalData_.get(), arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
+    (void)dlt_user_log_write_int64_attr(&logLocalData_, arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
   }
   return *this;
 }
@@ -316,7 +341,7 @@ LogStream& LogStream::LogArgument(const ara::log::Argument<int64_t>& arg) noexce
 LogStream& LogStream::LogArgument(const ara::log::Argument<float32_t>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
     (void)dlt_user_log_write_float32_attr(
-        logLocalData_.get(), arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
+        &logLocalData_, arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
   }
   return *this;
 }
@@ -324,18 +349,31 @@ LogStream& LogStream::LogArgument(const ara::log::Argument<float32_t>& arg) noex
 LogStream& LogStream::LogArgument(const ara::log::Argument<float64_t>& arg) noexcept {
   if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
     (void)dlt_user_log_write_float64_attr(
-        logLocalData_.get(), arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
+        &logLocalData_, arg.arg_value, arg.arg_name.c_str(), arg.arg_unit.c_str());
   }
   return *this;
 }
 
 LogStream& LogStream::WithLocation(ara::core::StringView file, int line) noexcept {
-  if (logRet_ < DltReturnValue::DLT_RETURN_OK || logLocalData_->size > 0) {
+  if (logRet_ < DltReturnValue::DLT_RETURN_OK || logLocalData_.size > 0) {
     return *this;
   }
   return *this << ara::log::Argument<int32_t>{line, file.data()};
 }
 
+LogStream& LogStream::LogField(uint32_t keyId, char code, const void* value, std::size_t size) noexcept {
+  if (logRet_ > DltReturnValue::DLT_RETURN_OK) {
+    unsigned char field[internal::kFieldHeaderSize + internal::kMaxFieldStringSize];
+    size = std::min(size, internal::kMaxFieldStringSize);
+    field[0] = internal::kFieldTag;
+    field[1] = static_cast<unsigned char>(code);
+    std::memcpy(&field[2], &keyId, sizeof(keyId));
+    std::memcpy(&field[internal::kFieldHeaderSize], value, size);
+    (void)dlt_user_log_write_raw(&logLocalData_, field, static_cast<uint16_t>(internal::kFieldHeaderSize + size));
+  }
+  return *this;
+}
+
 LogStream& operator<<(LogStream& out, LogMode logMode) noexcept {
   if (logMode == ara::log::LogMode::kConsole) {
     return out << "kConsole";
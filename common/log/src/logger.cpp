@@ -1,7 +1,18 @@
 #include "ara/log/logger.h"
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__QNX__)
+#include <process.h>
+#else
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
 #include <atomic>
 
+#include "ara/core/static_string.h"
 #include "ara/core/string.h"
+#include "ara/log/async_backend.h"
 #include "ara/log/logmanager.h"
 #include <nlohmann/json.hpp>
 
@@ -13,6 +24,29 @@ namespace {
 // InitLogging() call on it), this variable must be checked in every function that calls LogManager::instance().
 std::atomic<bool> g_isInitialized{false};
 std::mutex init_mutex;
+
+// All live loggers, so a level change reported by DLT for a context ID reaches its cached
+// level. Leaked, DLT may call back while static objects are destroyed.
+struct LoggerRegistry {
+  std::mutex mutex;
+  std::vector<Logger*> loggers;
+};
+
+LoggerRegistry& Registry() noexcept {
+  static LoggerRegistry* const registry = new LoggerRegistry();
+  return *registry;
+}
+
+// DLT updates the context's level before it calls back.
+void OnLogLevelChanged(char context_id[DLT_ID_SIZE], uint8_t /*log_level*/, uint8_t /*trace_status*/) {
+  LoggerRegistry& registry = Registry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+  for (Logger* logger : registry.loggers) {
+    if (std::strncmp(logger->getContext()->contextID, context_id, DLT_ID_SIZE) == 0) {
+      logger->refreshLogLevel();
+    }
+  }
+}
 }  // namespace
 
 class Logger::Impl final {
@@ -22,7 +56,7 @@ class Logger::Impl final {
        const int8_t& use_app_default_level,
        const LogLevel ctxDefLogLevel) noexcept
       : parent(logger_parent), isRegistered_(false) {
-    const ara::core::String id(ctxId.data(), ctxId.size());
+    const ara::core::StaticString<DLT_ID_SIZE> id(ctxId);
     const ara::core::String desc(ctxDescription.data(), ctxDescription.size());
 
     DltReturnValue ret = dlt_register_context_ll_ts_use_default_level(
@@ -30,7 +64,7 @@ class Logger::Impl final {
         static_cast<int32_t>(ctxDefLogLevel), DLT_TRACE_STATUS_OFF);
 
     if (ret < DltReturnValue::DLT_RETURN_OK) {
-      const std::string err_msg = "logging: unable to register context [" + id +
+      const std::string err_msg = "logging: unable to register context [" + id.ToString() +
                                   "] to DLT back-end. Error-code: " + std::to_string(static_cast<int8_t>(ret));
       DltContextData log_local;
       DltReturnValue dlt_local = dlt_user_log_write_start(dltContext_.get(), &log_local, DLT_LOG_ERROR);
@@ -40,6 +74,7 @@ class Logger::Impl final {
       }
     } else {
       (void)(isRegistered_ = true);
+      (void)dlt_register_log_level_changed_callback(dltContext_.get(), &OnLogLevelChanged);
     }
   };
 
@@ -50,49 +85,25 @@ class Logger::Impl final {
 
   ~Impl() { unregisterBackends(); }
 
-  bool IsEnabled(LogLevel logLevel) const noexcept {
-    DltLogLevelType log_level = DltLogLevelType::DLT_LOG_WARN;
-    switch (logLevel) {
-      case ara::log::LogLevel::kOff:
-        log_level = DltLogLevelType::DLT_LOG_OFF;
-        break;
-      case ara::log::LogLevel::kFatal:
-        log_level = DltLogLevelType::DLT_LOG_FATAL;
-        break;
-      case ara::log::LogLevel::kError:
-        log_level = DltLogLevelType::DLT_LOG_ERROR;
-        break;
-      case ara::log::LogLevel::kWarn:
-        log_level = DltLogLevelType::DLT_LOG_WARN;
-        break;
-      case ara::log::LogLevel::kInfo:
-        log_level = DltLogLevelType::DLT_LOG_INFO;
-        break;
-      case ara::log::LogLevel::kDebug:
-        log_level = DltLogLevelType::DLT_LOG_DEBUG;
-        break;
-      case ara::log::LogLevel::kVerbose:
-        log_level = DltLogLevelType::DLT_LOG_VERBOSE;
-        break;
-      default:
-        break;
-    }
-    return dlt_user_is_logLevel_enabled(dltContext_.get(), log_level) == DLT_RETURN_TRUE;
+  int8_t getLogLevel() const noexcept {
+    // Same as dlt_user_is_logLevel_enabled(): an unregistered context logs nothing.
+    const int8_t* const level = dltContext_->log_level_ptr;
+    return level == nullptr ? static_cast<int8_t>(LogLevel::kOff) : *level;
   }
 
-  LogStream LogOff() noexcept { return std::move(LogStream{LogLevel::kOff, *parent}); }
+  LogStream LogOff() noexcept { return LogStream{LogLevel::kOff, *parent}; }
 
-  LogStream LogFatal() noexcept { return std::move(LogStream{LogLevel::kFatal, *parent}); }
+  LogStream LogFatal() noexcept { return LogStream{LogLevel::kFatal, *parent}; }
 
-  LogStream LogError() noexcept { return std::move(LogStream{LogLevel::kError, *parent}); }
+  LogStream LogError() noexcept { return LogStream{LogLevel::kError, *parent}; }
 
-  LogStream LogWarn() noexcept { return std::move(LogStream{LogLevel::kWarn, *parent}); }
+  LogStream LogWarn() noexcept { return LogStream{LogLevel::kWarn, *parent}; }
 
-  LogStream LogInfo() noexcept { return std::move(LogStream{LogLevel::kInfo, *parent}); }
+  LogStream LogInfo() noexcept { return LogStream{LogLevel::kInfo, *parent}; }
 
-  LogStream LogDebug() noexcept { return std::move(LogStream{LogLevel::kDebug, *parent}); }
+  LogStream LogDebug() noexcept { return LogStream{LogLevel::kDebug, *parent}; }
 
-  LogStream LogVerbose() noexcept { return std::move(LogStream{LogLevel::kVerbose, *parent}); }
+  LogStream LogVerbose() noexcept { return LogStream{LogLevel::kVerbose, *parent}; }
 
   void unregisterBackends() noexcept {
     // Single backend supported from now
@@ -110,7 +121,7 @@ class Logger::Impl final {
   std::string getId() const noexcept {
     // string ctor usage might not be no-throw guaranteed - implementation not to be used for series SW
     const char* ctx_id = dltContext_->contextID;
-    return ara::core::String(ctx_id, static_cast<size_t>(DLT_ID_SIZE)).c_str();
+    return ara::core::StaticString<DLT_ID_SIZE>(ctx_id, static_cast<size_t>(DLT_ID_SIZE)).c_str();
   }
 
   DltContext* getContext() noexcept { return dltContext_.get(); }
@@ -127,9 +138,24 @@ Logger::Logger(const ara::core::StringView& ctxId,
                const int8_t& use_app_default_level,
                LogLevel ctxDefLogLevel) noexcept
     : _pImpl(std::make_unique<Impl>(this, ctxId, ctxDescription,
-                                    use_app_default_level, ctxDefLogLevel)) {}
+                                    use_app_default_level, ctxDefLogLevel)) {
+  LoggerRegistry& registry = Registry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.loggers.push_back(this);
+  refreshLogLevel();
+}
+
+Logger::~Logger() noexcept {
+  {
+    LoggerRegistry& registry = Registry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.loggers.erase(std::remove(registry.loggers.begin(), registry.loggers.end(), this),
+                           registry.loggers.end());
+  }
+  unregisterBackends();
+}
 
-Logger::~Logger() noexcept { unregisterBackends(); }
+void Logger::refreshLogLevel() noexcept { logLevel_.store(_pImpl->getLogLevel(), std::memory_order_relaxed); }
 
 void Logger::unregisterBackends() noexcept { _pImpl->unregisterBackends(); }
 
@@ -165,8 +191,6 @@ LogStream Logger::WithLevel(LogLevel logLevel) const noexcept {
   }
 }
 
-bool Logger::IsEnabled(LogLevel logLevel) const noexcept { return _pImpl->IsEnabled(logLevel); }
-
 DltContext* Logger::getContext() { return _pImpl->getContext(); }
 
 /*************Function API***************/
@@ -258,6 +282,59 @@ void RegisterConnectionStateHandler(std::function<void(ara::log::ClientState)> c
   dlt_register_client_state_callback(cb_helper);
 }
 
+std::vector<DroppedLogCount> GetDroppedLogCounts() noexcept {
+  try {
+    return internal::AsyncBackend::instance().DroppedCounts();
+  } catch (const std::bad_alloc&) {
+    return std::vector<DroppedLogCount>();
+  }
+}
+
+void FlushLogs() noexcept { internal::AsyncBackend::instance().Flush(); }
+
+bool ReloadConfiguration() noexcept { return LogManager::instance().ReloadConfiguration(); }
+
+namespace {
+thread_local int32_t t_threadId = 0;
+
+// Runs in the child on the thread that forked, the only one left, which has a new id there.
+void ForgetThreadId() { t_threadId = 0; }
+}  // namespace
+
+int32_t CurrentThreadId() noexcept {
+  if (t_threadId == 0) {
+    static const int registered = ::pthread_atfork(nullptr, nullptr, &ForgetThreadId);
+    (void)registered;
+#if defined(__QNX__)
+    t_threadId = static_cast<int32_t>(::gettid());
+#else
+    t_threadId = static_cast<int32_t>(::syscall(SYS_gettid));
+#endif
+  }
+  return t_threadId;
+}
+
+namespace internal {
+
+void RefreshLogLevels() noexcept {
+  LoggerRegistry& registry = Registry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+  for (Logger* logger : registry.loggers) {
+    logger->refreshLogLevel();
+  }
+}
+
+void SetLogLevel(Logger& logger, LogLevel level) noexcept {
+  // Where DLT keeps the context's level, what it checks and what the viewer sets.
+  int8_t* const current = logger.getContext()->log_level_ptr;
+  if (current != nullptr) {
+    *current = static_cast<int8_t>(level);
+  }
+  logger.refreshLogLevel();
+}
+
+}  // namespace internal
+
 static_assert(
     static_cast<DltLogLevelType>(LogLevel::kOff) == DLT_LOG_OFF,
     "LogLevel::kOff does not match DltLogLevelType::DLT_LOG_OFF");
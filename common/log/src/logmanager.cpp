@@ -10,6 +10,10 @@
  */
 
 #include "ara/log/logmanager.h"
+#include "ara/log/async_backend.h"
+#include "ara/log/crash_ring.h"
+#include "ara/log/file_sink.h"
+#include "ara/log/rate_limiter.h"
 #include "ara/log/utility.h"
 
 #include <sys/stat.h>
@@ -115,16 +119,40 @@ void LogManager::LogManagerInitialize(
           file_name = fileModeDescription.getSavePath() + "/" + fileModeDescription.getFileName();
         }
       }
-      ret = dlt_init_file(
-          file_name.c_str(), static_cast<int8_t>(fileModeDescription.getFileEncode()),
-          static_cast<int8_t>(fileModeDescription.getFileSaveMode()), fileModeDescription.getMaxFile());
-      if (ret < DltReturnValue::DLT_RETURN_OK) {
-        g_logINT->LogError() << "logging: [" << id << "] unable to init file log mode in DLT back-end!";
+      if (native_file_mode) {
+        const std::string::size_type slash = file_name.rfind('/');
+        ara::log::internal::FileSinkConfig sink_config;
+        sink_config.directory = file_name.substr(0U, slash);
+        sink_config.file_name = file_name.substr(slash + 1U);
+        sink_config.file_encode = fileModeDescription.getFileEncode();
+        sink_config.file_save_mode = fileModeDescription.getFileSaveMode();
+        sink_config.max_files = fileModeDescription.getMaxFile();
+        sink_config.file_size = fileModeDescription.getFileSize();
+        sink_config.app_id = id;
+        sink_config.compression = file_compression;
+        sink_config.compress_cpu_percent = file_compress_cpu_percent;
+        sink_config.forward_to_dlt =
+            (log_mode & static_cast<uint8_t>(static_cast<uint8_t>(LogMode::kConsole) |
+                                             static_cast<uint8_t>(LogMode::kRemote))) > 0U;
+        if (!ara::log::internal::FileSink::instance().Start(sink_config)) {
+          g_logINT->LogError() << "logging: [" << id << "] unable to create log file in:" << sink_config.directory;
+          ret = DltReturnValue::DLT_RETURN_ERROR;
+        } else {
+          g_logINT->LogInfo() << "Init native file success. Path:"
+                              << ara::log::internal::FileSink::instance().file().CurrentPath();
+        }
       } else {
-        g_logINT->LogInfo() << "Init file success. Path:" << file_name;
-      }
-      if (fileModeDescription.getFileSaveMode() == ara::log::internal::FileSaveMode::kSize) {
-        ret = dlt_set_filesize_max(fileModeDescription.getFileSize());
+        ret = dlt_init_file(
+            file_name.c_str(), static_cast<int8_t>(fileModeDescription.getFileEncode()),
+            static_cast<int8_t>(fileModeDescription.getFileSaveMode()), fileModeDescription.getMaxFile());
+        if (ret < DltReturnValue::DLT_RETURN_OK) {
+          g_logINT->LogError() << "logging: [" << id << "] unable to init file log mode in DLT back-end!";
+        } else {
+          g_logINT->LogInfo() << "Init file success. Path:" << file_name;
+        }
+        if (fileModeDescription.getFileSaveMode() == ara::log::internal::FileSaveMode::kSize) {
+          ret = dlt_set_filesize_max(fileModeDescription.getFileSize());
+        }
       }
     }
   }
@@ -173,15 +201,20 @@ void LogManager::LogManagerInitialize(
   } else {
     g_logINT->LogInfo() << "Init DLT back-end done, all known contexts set to default log level: " << logLevel;
   }
+  ara::log::internal::RefreshLogLevels();
+  ApplyLogLevels(false);
 
   if (messageMode == MessageMode::kModeled) {
     if (dlt_nonverbose_mode() < DltReturnValue::DLT_RETURN_OK) {
       g_logINT->LogError() << "Unable set non verbose mode";
+    } else {
+      ara::log::internal::SetModeledMessageMode(true);
     }
   } else {
     if (dlt_verbose_mode() < DltReturnValue::DLT_RETURN_OK) {
       g_logINT->LogError() << "Unable set verbose mode";
     }
+    ara::log::internal::SetModeledMessageMode(false);
   }
   (void)(is_initialized = true);
 }
@@ -196,6 +229,11 @@ LogManager::LogManager()
                                         LogLevel::kVerbose)) {}
 
 LogManager::~LogManager() {
+  // Drops of rate limited call sites the process has not logged since.
+  (void)ara::log::internal::ReportSuppressed(true);
+  config_watcher.Stop();
+  // Queued records still refer to the contexts unregistered below.
+  ara::log::internal::AsyncBackend::instance().Stop();
   try {
     const std::lock_guard<std::mutex> guard(g_mutex_logContexts);
     for (const std::pair<const std::string, std::unique_ptr<Logger>>& context : g_logContexts) {
@@ -206,6 +244,9 @@ LogManager::~LogManager() {
   }
   g_logINT->unregisterBackends();
   (void)dlt_unregister_app_flush_buffered_logs();
+  ara::log::internal::FileSink::instance().Stop();
+  // A clean exit, nothing to recover next time.
+  ara::log::internal::CrashRing::instance().Stop();
 }
 
 Logger& LogManager::createLogContext(
@@ -224,6 +265,17 @@ Logger& LogManager::createLogContext(
     ctxId = "XXXX";
   }
 
+  // Registered before: found without the lock, only a first registration serializes.
+  uint32_t key = 0U;
+  const bool packed = ara::log::internal::ContextTable::Pack(ctxId, key);
+  if (packed) {
+    Logger* const logger = context_table.Find(key);
+    if (logger != nullptr) {
+      g_logINT->LogDebug() << "Requested an already registered context ID - returning: " << ctxId;
+      return *logger;
+    }
+  }
+
   try {
     const std::lock_guard<std::mutex> guard(g_mutex_logContexts);
 
@@ -231,13 +283,25 @@ Logger& LogManager::createLogContext(
         g_logContexts.find({ctxId.data(), ctxId.size()});
 
     if (ctxIter == g_logContexts.cend()) {
-      (void)g_logContexts.emplace(
-          ctxId.data(),
-          std::make_unique<Logger>(ctxId, ctxDescription, use_app_default_level,
-                                   ctxDefLogLevel));
-      (*g_logContexts[{ctxId.data(), ctxId.size()}]).LogDebug()
-          << "local time base used";
-      return *g_logContexts[{ctxId.data(), ctxId.size()}].get();
+      Logger& logger = *g_logContexts
+                            .emplace(std::string{ctxId.data(), ctxId.size()},
+                                     std::make_unique<Logger>(ctxId, ctxDescription, use_app_default_level,
+                                                              ctxDefLogLevel))
+                            .first->second;
+      if (use_app_default_level == 0) {
+        (void)code_levels.emplace(std::string{ctxId.data(), ctxId.size()}, ctxDefLogLevel);
+      }
+      const std::unordered_map<std::string, LogLevel>::const_iterator level =
+          context_levels.find({ctxId.data(), ctxId.size()});
+      if (level != context_levels.cend()) {
+        ara::log::internal::SetLogLevel(logger, level->second);
+      }
+      // Published once complete; a full table leaves the context to the map above.
+      if (packed) {
+        (void)context_table.Insert(key, &logger);
+      }
+      logger.LogDebug() << "local time base used";
+      return logger;
     } else {
       g_logINT->LogDebug() << "Requested an already registered context ID - returning: " << ctxId;
       return *ctxIter->second.get();
@@ -271,6 +335,7 @@ nlohmann::json LogManager::LoadConfigurations() noexcept {
     g_logINT->LogWarn() << "Path:" << env << "is not a readable configuration file.";
     return NULL;
   }
+  config_path = env;
   std::ifstream ifs(env);
   if (ifs.is_open()) {
     g_logINT->LogInfo() << env << "path in using.";
@@ -295,6 +360,11 @@ void LogManager::LoadConfigurationFileAndInitLogging() noexcept {
   ara::log::internal::FileSaveMode file_save_mode = ara::log::internal::FileSaveMode::kSize;
   uint8_t max_files = 5u;
   uint32_t file_size = 67108864U;
+  bool async_mode = false;
+  ara::log::internal::AsyncConfig async_config;
+  bool config_watch = false;
+  bool crash_ring_mode = false;
+  ara::log::internal::CrashRingConfig crash_ring_config;
   std::lock_guard<std::mutex> lock(g_mutex_initialize);
   if (!is_initialized) {
     const nlohmann::json& js = LoadConfigurations();
@@ -329,31 +399,15 @@ void LogManager::LoadConfigurationFileAndInitLogging() noexcept {
         /* Parsing logLevel */
         if (!js.contains("log_default_level")) {
           g_logINT->LogWarn() << "Can not find app default log level. Set to default:" << log_level;
-        } else {
-          tmp = js.at("log_default_level");
-          if (!tmp.is_string() || tmp.get<std::string>() == "") {
-            g_logINT->LogWarn() << "logLevel is invalid. Set to default:" << log_level;
-          } else {
-            std::string level = tmp.get<std::string>();
-            std::transform(level.begin(), level.end(), level.begin(), ::tolower);
-            if (level.find("off") != std::string::npos) {
-              log_level = ara::log::LogLevel::kOff;
-            } else if (level.find("fatal") != std::string::npos) {
-              log_level = ara::log::LogLevel::kFatal;
-            } else if (level.find("error") != std::string::npos) {
-              log_level = ara::log::LogLevel::kError;
-            } else if (level.find("warn") != std::string::npos) {
-              log_level = ara::log::LogLevel::kWarn;
-            } else if (level.find("info") != std::string::npos) {
-              log_level = ara::log::LogLevel::kInfo;
-            } else if (level.find("debug") != std::string::npos) {
-              log_level = ara::log::LogLevel::kDebug;
-            } else if (level.find("verbose") != std::string::npos) {
-              log_level = ara::log::LogLevel::kVerbose;
-            } else {
-              g_logINT->LogWarn() << "Unknown logLevel. Set to default:" << log_level;
-            }
-          }
+        } else if (!ParseLogLevel(js.at("log_default_level"), log_level)) {
+          g_logINT->LogWarn() << "logLevel is invalid. Set to default:" << log_level;
+        }
+        /* Parsing context levels */
+        std::unordered_map<std::string, LogLevel> levels;
+        ParseContextLevels(js, levels);
+        {
+          const std::lock_guard<std::mutex> guard(g_mutex_logContexts);
+          context_levels = std::move(levels);
         }
         /* Parsing logMode */
         if (!js.contains("log_mode")) {
@@ -553,6 +607,126 @@ void LogManager::LoadConfigurationFileAndInitLogging() noexcept {
             }
           }
         }
+        /* Parsing native file mode */
+        if (js.contains("log_file_native_mode")) {
+          tmp = js.at("log_file_native_mode");
+          if (!tmp.is_boolean()) {
+            g_logINT->LogWarn() << "fileNativeMode is invalid. Set to default:" << native_file_mode;
+          } else {
+            native_file_mode = tmp.get<bool>();
+          }
+        }
+        if (native_file_mode) {
+          if (js.contains("log_file_compression")) {
+            tmp = js.at("log_file_compression");
+            if (!tmp.is_string() || tmp.get<std::string>() == "") {
+              g_logINT->LogWarn() << "fileCompression is invalid. Set to default:"
+                                  << ara::log::internal::ToString(file_compression);
+            } else if (tmp.get<std::string>() == "kNone") {
+              file_compression = ara::log::internal::FileCompression::kNone;
+            } else if (tmp.get<std::string>() == "kGzip") {
+              file_compression = ara::log::internal::FileCompression::kGzip;
+            } else if (tmp.get<std::string>() == "kZstd") {
+              file_compression = ara::log::internal::FileCompression::kZstd;
+              if (ara::log::internal::SupportedCompression(file_compression) != file_compression) {
+                g_logINT->LogWarn() << "kZstd is not supported by this build. Use kGzip.";
+              }
+            } else {
+              g_logINT->LogWarn() << "Unknown log_file_compression:" << tmp.get<std::string>() << "Set to default : "
+                                  << ara::log::internal::ToString(file_compression);
+            }
+          }
+          if (js.contains("log_file_compress_cpu_percent")) {
+            tmp = js.at("log_file_compress_cpu_percent");
+            if (!tmp.is_number_unsigned() || tmp.get<uint32_t>() == 0U || tmp.get<uint32_t>() > 100U) {
+              g_logINT->LogWarn() << "fileCompressCpuPercent is invalid. Set to default:" << file_compress_cpu_percent;
+            } else {
+              file_compress_cpu_percent = tmp.get<uint32_t>();
+            }
+          }
+        }
+        /* Parsing async mode */
+        if (js.contains("log_async_mode")) {
+          tmp = js.at("log_async_mode");
+          if (!tmp.is_boolean()) {
+            g_logINT->LogWarn() << "asyncMode is invalid. Set to default:" << async_mode;
+          } else {
+            async_mode = tmp.get<bool>();
+          }
+        }
+        if (async_mode) {
+          if (js.contains("log_async_queue_size")) {
+            tmp = js.at("log_async_queue_size");
+            if (!tmp.is_number_unsigned() || tmp.get<uint32_t>() == 0U) {
+              g_logINT->LogWarn() << "asyncQueueSize is invalid. Set to default:" << async_config.queue_size;
+            } else {
+              async_config.queue_size = tmp.get<uint32_t>();
+            }
+          }
+          if (js.contains("log_async_overflow_policy")) {
+            tmp = js.at("log_async_overflow_policy");
+            if (!tmp.is_string() || tmp.get<std::string>() == "") {
+              g_logINT->LogWarn() << "asyncOverflowPolicy is invalid. Set to default:"
+                                  << ara::log::internal::ToString(async_config.overflow_policy);
+            } else {
+              if (tmp.get<std::string>() == "kBlock") {
+                async_config.overflow_policy = ara::log::internal::OverflowPolicy::kBlock;
+              } else if (tmp.get<std::string>() == "kDrop") {
+                async_config.overflow_policy = ara::log::internal::OverflowPolicy::kDrop;
+              } else if (tmp.get<std::string>() == "kCountAndDrop") {
+                async_config.overflow_policy = ara::log::internal::OverflowPolicy::kCountAndDrop;
+              } else {
+                g_logINT->LogWarn() << "Unknown async_overflow_policy:" << tmp.get<std::string>() << "Set to default : "
+                                    << ara::log::internal::ToString(async_config.overflow_policy);
+              }
+            }
+          }
+          if (js.contains("log_async_flush_interval_ms")) {
+            tmp = js.at("log_async_flush_interval_ms");
+            if (!tmp.is_number_unsigned() || tmp.get<uint32_t>() == 0U) {
+              g_logINT->LogWarn() << "asyncFlushInterval is invalid. Set to default:" << async_config.flush_interval_ms;
+            } else {
+              async_config.flush_interval_ms = tmp.get<uint32_t>();
+            }
+          }
+        }
+        /* Parsing crash ring */
+        if (js.contains("log_crash_ring_mode")) {
+          tmp = js.at("log_crash_ring_mode");
+          if (!tmp.is_boolean()) {
+            g_logINT->LogWarn() << "crashRingMode is invalid. Set to default:" << crash_ring_mode;
+          } else {
+            crash_ring_mode = tmp.get<bool>();
+          }
+        }
+        if (crash_ring_mode) {
+          if (js.contains("log_crash_ring_size")) {
+            tmp = js.at("log_crash_ring_size");
+            if (!tmp.is_number_unsigned() || tmp.get<uint32_t>() == 0U) {
+              g_logINT->LogWarn() << "crashRingSize is invalid. Set to default:" << crash_ring_config.size;
+            } else {
+              crash_ring_config.size = tmp.get<uint32_t>();
+            }
+          }
+          crash_ring_config.directory = file_path;
+          if (js.contains("log_crash_ring_path")) {
+            tmp = js.at("log_crash_ring_path");
+            if (!tmp.is_string() || tmp.get<std::string>() == "") {
+              g_logINT->LogWarn() << "crashRingPath is invalid. Set to default:" << crash_ring_config.directory;
+            } else {
+              crash_ring_config.directory = tmp.get<std::string>();
+            }
+          }
+        }
+        /* Parsing config watch */
+        if (js.contains("log_config_watch")) {
+          tmp = js.at("log_config_watch");
+          if (!tmp.is_boolean()) {
+            g_logINT->LogWarn() << "configWatch is invalid. Set to default:" << config_watch;
+          } else {
+            config_watch = tmp.get<bool>();
+          }
+        }
       }
     } catch (const std::exception& e) {
       g_logINT->LogError() << "Parse file error:" << e.what();
@@ -574,19 +748,153 @@ void LogManager::LoadConfigurationFileAndInitLogging() noexcept {
         ls << "kFile"
            << "], filePath:[" << file_path << "], fileName:[" << file_name << "], createDir:[" << create_dir
            << "], fileEncode:[" << file_encode << "], fileSaveMode:[" << file_save_mode << "], maxFiles:[" << max_files
-           << "], fileSize:[" << file_size;
+           << "], fileSize:[" << file_size << "], fileNativeMode:[" << native_file_mode;
+        if (native_file_mode) {
+          ls << "], fileCompression:[" << ara::log::internal::ToString(file_compression) << "], fileCompressCpuPercent:["
+             << file_compress_cpu_percent;
+        }
+      }
+      ls << "], asyncMode:[" << async_mode;
+      if (async_mode) {
+        ls << "], asyncQueueSize:[" << async_config.queue_size << "], asyncOverflowPolicy:["
+           << ara::log::internal::ToString(async_config.overflow_policy) << "], asyncFlushInterval:["
+           << async_config.flush_interval_ms << "ms";
+      }
+      ls << "], crashRingMode:[" << crash_ring_mode;
+      if (crash_ring_mode) {
+        ls << "], crashRingSize:[" << crash_ring_config.size << "], crashRingPath:[" << crash_ring_config.directory;
       }
-      ls << "]";
+      ls << "], contextLevels:[" << static_cast<uint32_t>(context_levels.size()) << "], configWatch:[" << config_watch
+         << "]";
     }  // auto release ls
     LogManagerInitialize(
         app_id.c_str(), app_desc.c_str(), log_level, log_mode, message_mode,
         ara::log::internal::FileModeDescription(
             file_path, file_name, create_dir, file_encode, file_save_mode, max_files, file_size));
+    if (crash_ring_mode) {
+      crash_ring_config.app_id = app_id;
+      std::string recovered;
+      ara::log::internal::CrashRing& ring = ara::log::internal::CrashRing::instance();
+      if (!ring.Start(crash_ring_config, recovered)) {
+        g_logINT->LogError() << "Unable to create the crash ring " << ring.Name()
+                             << ", it is in use or shared memory is not available.";
+      }
+      if (!recovered.empty()) {
+        g_logINT->LogWarn() << "Last run did not exit cleanly, its latest records are in " << recovered;
+      }
+    }
+    if (async_mode && !ara::log::internal::AsyncBackend::instance().Start(async_config, g_logINT.get())) {
+      g_logINT->LogError() << "Unable to start asynchronous logging, records are written synchronously.";
+    }
+    if (config_watch && !config_path.empty() &&
+        !config_watcher.Start(config_path, [this]() { (void)ReloadConfiguration(); })) {
+      g_logINT->LogError() << "Unable to watch " << config_path << ", levels are reloaded by ReloadConfiguration() only.";
+    }
   } else {
     g_logINT->LogInfo() << "Logging Framework has already been initialized.";
     return;
   }
 }
 
+bool LogManager::ReloadConfiguration() noexcept {
+  if (!is_initialized) {
+    return false;
+  }
+  const std::lock_guard<std::mutex> lock(g_mutex_initialize);
+  const nlohmann::json js = LoadConfigurations();
+  // A file caught half written does not parse, the next change brings the rest.
+  if ((js == NULL) || js.is_discarded() || !js.is_object()) {
+    g_logINT->LogWarn() << "Log configuration parses failure. Levels are kept.";
+    return false;
+  }
+  LogLevel log_level = default_app_level;
+  std::unordered_map<std::string, LogLevel> levels;
+  try {
+    if (js.contains("log_default_level") && !ParseLogLevel(js.at("log_default_level"), log_level)) {
+      g_logINT->LogWarn() << "logLevel is invalid. Keep:" << log_level;
+    }
+    ParseContextLevels(js, levels);
+    const std::lock_guard<std::mutex> guard(g_mutex_logContexts);
+    context_levels = std::move(levels);
+  } catch (const std::exception& e) {
+    g_logINT->LogError() << "Parse file error:" << e.what();
+    return false;
+  }
+  if (log_level != default_app_level) {
+    default_app_level = log_level;
+    // Also the level DLT gives contexts registered from now on.
+    if (dlt_set_application_ll_ts_limit(static_cast<DltLogLevelType>(log_level), DLT_TRACE_STATUS_OFF) <
+        DltReturnValue::DLT_RETURN_OK) {
+      g_logINT->LogError() << "Unable to set the application log level in DLT back-end.";
+    }
+    // DLT changed every context, also those ApplyLogLevels() doesn't know like INTM.
+    ara::log::internal::RefreshLogLevels();
+  }
+  ApplyLogLevels(true);
+  g_logINT->LogInfo() << "Reloaded log levels. logLevel:[" << log_level << "], contextLevels:["
+                      << static_cast<uint32_t>(context_levels.size()) << "]";
+  return true;
+}
+
+bool LogManager::ParseLogLevel(const nlohmann::json& value, LogLevel& level) {
+  if (!value.is_string() || value.get<std::string>() == "") {
+    return false;
+  }
+  std::string name = value.get<std::string>();
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+  if (name.find("off") != std::string::npos) {
+    level = ara::log::LogLevel::kOff;
+  } else if (name.find("fatal") != std::string::npos) {
+    level = ara::log::LogLevel::kFatal;
+  } else if (name.find("error") != std::string::npos) {
+    level = ara::log::LogLevel::kError;
+  } else if (name.find("warn") != std::string::npos) {
+    level = ara::log::LogLevel::kWarn;
+  } else if (name.find("info") != std::string::npos) {
+    level = ara::log::LogLevel::kInfo;
+  } else if (name.find("debug") != std::string::npos) {
+    level = ara::log::LogLevel::kDebug;
+  } else if (name.find("verbose") != std::string::npos) {
+    level = ara::log::LogLevel::kVerbose;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void LogManager::ParseContextLevels(const nlohmann::json& js,
+                                    std::unordered_map<std::string, LogLevel>& levels) {
+  if (!js.contains("log_context_levels")) {
+    return;
+  }
+  const nlohmann::json& contexts = js.at("log_context_levels");
+  if (!contexts.is_object()) {
+    g_logINT->LogWarn() << "contextLevels is invalid. Use the default level for all contexts.";
+    return;
+  }
+  for (const auto& context : contexts.items()) {
+    LogLevel level = ara::log::LogLevel::kOff;
+    if (context.key().empty() || (context.key().size() > DLT_ID_SIZE) || !ParseLogLevel(context.value(), level)) {
+      g_logINT->LogWarn() << "contextLevel of [" << context.key() << "] is invalid. Ignored.";
+    } else {
+      levels[context.key()] = level;
+    }
+  }
+}
+
+void LogManager::ApplyLogLevels(bool all) noexcept {
+  const std::lock_guard<std::mutex> guard(g_mutex_logContexts);
+  for (const std::pair<const std::string, std::unique_ptr<Logger>>& context : g_logContexts) {
+    std::unordered_map<std::string, LogLevel>::const_iterator level = context_levels.find(context.first);
+    if (level != context_levels.cend()) {
+      ara::log::internal::SetLogLevel(*context.second, level->second);
+    } else if (all) {
+      level = code_levels.find(context.first);
+      ara::log::internal::SetLogLevel(*context.second,
+                                      (level != code_levels.cend()) ? level->second : default_app_level.load());
+    }
+  }
+}
+
 }  // namespace log
 }  // namespace ara
\ No newline at end of file
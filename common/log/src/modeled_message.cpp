@@ -0,0 +1,40 @@
+/*
+ * @Description: modeled (DLT non-verbose) messages
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include "ara/log/modeled_message.h"
+
+#include <atomic>
+
+#include "ara/log/logmanager.h"
+
+namespace ara {
+namespace log {
+namespace internal {
+
+namespace {
+
+// DLT applies the message mode to the whole application, LogManager sets it
+// once during InitLogging().
+std::atomic<bool> g_modeledMode{false};
+
+}  // namespace
+
+void SetModeledMessageMode(bool modeled) noexcept { g_modeledMode.store(modeled, std::memory_order_relaxed); }
+
+bool ModeledMessageMode() noexcept { return g_modeledMode.load(std::memory_order_relaxed); }
+
+LogStream StartModeled(Logger& logger, LogLevel logLevel, uint32_t messageId, const char* format) noexcept {
+  LogStream stream{messageId, logLevel, logger};
+  if (!ModeledMessageMode()) {
+    // Verbose mode drops the ID, keep the record readable without the catalog.
+    stream << format;
+  }
+  return stream;
+}
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
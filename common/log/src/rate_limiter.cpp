@@ -0,0 +1,71 @@
+/*
+ * @Description: Reports the statements rate limited call sites dropped after their last logged one.
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include "ara/log/rate_limiter.h"
+
+#include <cstring>
+
+#include "ara/log/logmanager.h"
+
+namespace ara {
+namespace log {
+namespace internal {
+
+namespace {
+
+// Limiters that have dropped statements, newest first. Call site limiters are statics that are
+// never destroyed, they stay listed.
+std::atomic<LogRateLimiter*> g_suppressing{nullptr};
+std::atomic<int64_t> g_next_report{0};
+constexpr int64_t kReportInterval = 100000000;  // ns
+thread_local bool t_reporting = false;
+
+}  // namespace
+
+void ListSuppressing(LogRateLimiter& limiter) noexcept {
+  LogRateLimiter* head = g_suppressing.load(std::memory_order_relaxed);
+  do {
+    limiter.link_ = head;
+  } while (!g_suppressing.compare_exchange_weak(head, &limiter, std::memory_order_release,
+                                                std::memory_order_relaxed));
+}
+
+uint64_t ReportSuppressed(bool all) noexcept {
+  LogRateLimiter* const head = g_suppressing.load(std::memory_order_acquire);
+  // The records logged here come back through this function.
+  if ((head == nullptr) || t_reporting) {
+    return 0U;
+  }
+  const int64_t now = LogRateLimiter::Now();
+  if (!all) {
+    int64_t next = g_next_report.load(std::memory_order_relaxed);
+    if ((now < next) || !g_next_report.compare_exchange_strong(next, now + kReportInterval,
+                                                               std::memory_order_relaxed)) {
+      return 0U;
+    }
+  }
+  t_reporting = true;
+  Logger& logger = LogManager::instance().internalLogger();
+  uint64_t reported = 0U;
+  for (LogRateLimiter* limiter = head; limiter != nullptr; limiter = limiter->Next()) {
+    const uint64_t suppressed = limiter->TakeSuppressed(now, all);
+    if (suppressed == 0U) {
+      continue;
+    }
+    reported += suppressed;
+    const char* file = limiter->File() != nullptr ? limiter->File() : "";
+    const char* const slash = std::strrchr(file, '/');
+    file = slash != nullptr ? slash + 1 : file;
+    logger.WithLevel(limiter->Level()) << "[suppressed" << suppressed << "messages]" << file << ":"
+                                       << limiter->Line();
+  }
+  t_reporting = false;
+  return reported;
+}
+
+}  // namespace internal
+}  // namespace log
+}  // namespace ara
@@ -0,0 +1,152 @@
+/*
+ * @Description: asynchronous back-end
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+#include <gtest/gtest.h>
+
+#include <pthread.h>
+
+#include <thread>
+#include <vector>
+
+#include "ara/log/async_backend.h"
+#include "ara/log/logger.h"
+
+using ara::log::internal::AsyncBackend;
+using ara::log::internal::AsyncConfig;
+using ara::log::internal::OverflowPolicy;
+using ara::log::internal::RecordQueue;
+
+namespace {
+
+DltContextData MakeRecord(ara::log::Logger& logger, const char* text) {
+  DltContextData record{};
+  EXPECT_EQ(dlt_user_log_write_start(static_cast<DltContext*>(logger.getContext()), &record, DLT_LOG_INFO),
+            DLT_RETURN_TRUE);
+  (void)dlt_user_log_write_string(&record, text);
+  return record;
+}
+
+AsyncConfig MakeConfig(uint32_t queue_size, OverflowPolicy policy) {
+  AsyncConfig config;
+  config.queue_size = queue_size;
+  config.overflow_policy = policy;
+  config.flush_interval_ms = 1U;
+  return config;
+}
+
+}  // namespace
+
+TEST(RecordQueueTest, FifoAndCapacity) {
+  RecordQueue queue(10U);
+  EXPECT_EQ(queue.Capacity(), 16U);
+  DltContextData record{};
+  for (int32_t i = 0; i < 16; ++i) {
+    record.size = i;
+    EXPECT_TRUE(queue.TryPush(record));
+  }
+  EXPECT_FALSE(queue.TryPush(record));
+  EXPECT_EQ(queue.Size(), 16U);
+  for (int32_t i = 0; i < 16; ++i) {
+    ASSERT_TRUE(queue.TryPop(record));
+    EXPECT_EQ(record.size, i);
+  }
+  EXPECT_FALSE(queue.TryPop(record));
+  EXPECT_TRUE(queue.TryPush(record));
+}
+
+TEST(AsyncBackendTest, SubmitAndStop) {
+  auto& logger = ara::log::CreateLogger("ASYN", "async test", ara::log::LogLevel::kVerbose);
+  AsyncBackend backend;
+  DltContextData record = MakeRecord(logger, "not running");
+  EXPECT_FALSE(backend.Submit(record));
+  EXPECT_NE(record.buffer, nullptr);
+  (void)dlt_user_log_write_finish(&record);
+
+  ASSERT_TRUE(backend.Start(MakeConfig(64U, OverflowPolicy::kBlock), nullptr));
+  EXPECT_TRUE(backend.IsRunning());
+  EXPECT_FALSE(backend.Start(MakeConfig(64U, OverflowPolicy::kBlock), nullptr));
+  record = MakeRecord(logger, "queued");
+  EXPECT_TRUE(backend.Submit(record));
+  EXPECT_EQ(record.buffer, nullptr);
+  backend.Flush();
+
+  backend.Stop();
+  EXPECT_FALSE(backend.IsRunning());
+  record = MakeRecord(logger, "stopped");
+  EXPECT_FALSE(backend.Submit(record));
+  (void)dlt_user_log_write_finish(&record);
+  backend.Stop();
+}
+
+TEST(AsyncBackendTest, BlockNeverDrops) {
+  auto& logger = ara::log::CreateLogger("ASYN", "async test", ara::log::LogLevel::kVerbose);
+  AsyncBackend backend;
+  ASSERT_TRUE(backend.Start(MakeConfig(16U, OverflowPolicy::kBlock), nullptr));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 1000; ++i) {
+        DltContextData record = MakeRecord(logger, "block");
+        EXPECT_TRUE(backend.Submit(record));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  backend.Flush();
+  for (const ara::log::DroppedLogCount& count : backend.DroppedCounts()) {
+    EXPECT_EQ(count.dropped, 0U);
+  }
+  backend.Stop();
+}
+
+TEST(AsyncBackendTest, PerThreadDropCounters) {
+  auto& logger = ara::log::CreateLogger("ASYN", "async test", ara::log::LogLevel::kVerbose);
+  AsyncBackend backend;
+  ASSERT_TRUE(backend.Start(MakeConfig(16U, OverflowPolicy::kDrop), nullptr));
+  std::thread producer([&]() {
+    (void)pthread_setname_np(pthread_self(), "async-producer");
+    for (int i = 0; i < 10000; ++i) {
+      DltContextData record = MakeRecord(logger, "drop");
+      EXPECT_TRUE(backend.Submit(record));
+      EXPECT_EQ(record.buffer, nullptr);
+    }
+  });
+  producer.join();
+  backend.Flush();
+  backend.Stop();
+
+  // The thread is gone, its counter is kept as long as it dropped something.
+  uint64_t dropped = 0U;
+  for (const ara::log::DroppedLogCount& count : backend.DroppedCounts()) {
+    EXPECT_EQ(count.thread_name, "async-producer");
+    dropped += count.dropped;
+  }
+  EXPECT_LE(dropped, 10000U);
+}
+
+TEST(AsyncBackendTest, LogStreamFallsBackWhenStopped) {
+  auto& logger = ara::log::CreateLogger("ASYN", "async test", ara::log::LogLevel::kVerbose);
+  EXPECT_FALSE(AsyncBackend::instance().IsRunning());
+  logger.LogInfo() << "synchronous";
+  ara::log::FlushLogs();
+  EXPECT_TRUE(ara::log::GetDroppedLogCounts().empty());
+
+  ASSERT_TRUE(AsyncBackend::instance().Start(MakeConfig(64U, OverflowPolicy::kCountAndDrop), nullptr));
+  for (int i = 0; i < 100; ++i) {
+    logger.LogInfo() << "asynchronous" << i;
+  }
+  logger.LogFatal() << "written after everything above";
+  ara::log::FlushLogs();
+  const std::vector<ara::log::DroppedLogCount> counts = ara::log::GetDroppedLogCounts();
+  ASSERT_EQ(counts.size(), 1U);
+  AsyncBackend::instance().Stop();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,227 @@
+/*
+ * @Description: crash ring in shared memory and its recovery
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara/log/crash_ring.h"
+#include "ara/log/file_sink.h"
+
+using ara::log::internal::CrashRing;
+using ara::log::internal::CrashRingConfig;
+using ara::log::internal::CrashRingHeader;
+using ara::log::internal::kStorageRecordHeaderSize;
+using ara::log::internal::ReadCrashRing;
+
+namespace {
+
+constexpr std::size_t kPayloadSize = 100U;
+
+std::string MakeDirectory() {
+  char path[] = "/tmp/crash_ring_test.XXXXXX";
+  EXPECT_NE(mkdtemp(path), nullptr);
+  return path;
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+CrashRingConfig MakeConfig(const std::string& app_id, const std::string& directory) {
+  CrashRingConfig config;
+  config.app_id = app_id;
+  config.size = 65536U;
+  config.directory = directory;
+  return config;
+}
+
+// Record whose payload starts with @a sequence.
+void WriteRecord(CrashRing& ring, uint32_t sequence) {
+  DltContext context{};
+  std::memcpy(context.contextID, "CTX1", 4U);
+  unsigned char payload[kPayloadSize] = {};
+  std::memcpy(payload, &sequence, sizeof(sequence));
+  DltContextData record{};
+  record.handle = &context;
+  record.buffer = payload;
+  record.size = static_cast<int32_t>(sizeof(payload));
+  record.log_level = DLT_LOG_INFO;
+  record.args_num = 1;
+  ring.Write(record);
+}
+
+// Sequence numbers of the records of a storage file written by WriteRecord().
+std::vector<uint32_t> Sequences(const std::string& records) {
+  std::vector<uint32_t> sequences;
+  const std::size_t size = kStorageRecordHeaderSize + kPayloadSize;
+  EXPECT_EQ(records.size() % size, 0U);
+  for (std::size_t pos = 0U; pos + size <= records.size(); pos += size) {
+    EXPECT_EQ(records.compare(pos, 4U, "DLT\x01"), 0);
+    EXPECT_EQ(records.compare(pos + 30U, 8U, "CRT1CTX1"), 0);
+    uint32_t sequence = 0U;
+    std::memcpy(&sequence, records.data() + pos + kStorageRecordHeaderSize, sizeof(sequence));
+    sequences.push_back(sequence);
+  }
+  return sequences;
+}
+
+// The ring as another process sees it.
+std::string Snapshot(const std::string& name) {
+  const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  EXPECT_GE(fd, 0) << name;
+  std::string image;
+  struct stat st {};
+  if ((fd >= 0) && (fstat(fd, &st) == 0)) {
+    image.resize(static_cast<std::size_t>(st.st_size));
+    EXPECT_EQ(pread(fd, &image[0], image.size(), 0), static_cast<ssize_t>(image.size()));
+  }
+  close(fd);
+  return image;
+}
+
+}  // namespace
+
+TEST(CrashRingTest, KeepsLatestRecordsInOrder) {
+  CrashRing& ring = CrashRing::instance();
+  std::string recovered;
+  ASSERT_TRUE(ring.Start(MakeConfig("CRT1", MakeDirectory()), recovered));
+  EXPECT_TRUE(recovered.empty());
+  EXPECT_EQ(ring.Name(), "/ara-log-CRT1");
+  for (uint32_t i = 0U; i < 3000U; ++i) {
+    WriteRecord(ring, i);
+  }
+
+  const std::string image = Snapshot(ring.Name());
+  std::string records;
+  const std::size_t count = ReadCrashRing(image.data(), image.size(), records);
+  const std::vector<uint32_t> sequences = Sequences(records);
+  ASSERT_EQ(sequences.size(), count);
+  // 64 KiB of 64 byte slots, three per record, the oldest one may be partly overwritten.
+  EXPECT_GE(count, 340U);
+  EXPECT_LE(count, 342U);
+  for (std::size_t i = 0U; i < sequences.size(); ++i) {
+    EXPECT_EQ(sequences[i], 3000U - sequences.size() + i);
+  }
+
+  // Held by this process.
+  const int fd = shm_open(ring.Name().c_str(), O_RDWR, 0);
+  ASSERT_GE(fd, 0);
+  EXPECT_NE(flock(fd, LOCK_EX | LOCK_NB), 0);
+  close(fd);
+
+  ring.Stop();
+  EXPECT_FALSE(ring.IsRunning());
+  EXPECT_LT(shm_open(ring.Name().c_str(), O_RDONLY, 0), 0);
+  WriteRecord(ring, 0U);
+}
+
+TEST(CrashRingTest, ConcurrentWriters) {
+  CrashRing& ring = CrashRing::instance();
+  std::string recovered;
+  ASSERT_TRUE(ring.Start(MakeConfig("CRT1", MakeDirectory()), recovered));
+  std::vector<std::thread> writers;
+  for (uint32_t thread = 0U; thread < 4U; ++thread) {
+    writers.emplace_back([&ring, thread]() {
+      for (uint32_t i = 0U; i < 80U; ++i) {
+        WriteRecord(ring, thread * 1000U + i);
+      }
+    });
+  }
+  for (std::thread& writer : writers) {
+    writer.join();
+  }
+  const std::string image = Snapshot(ring.Name());
+  ring.Stop();
+
+  std::string records;
+  ASSERT_EQ(ReadCrashRing(image.data(), image.size(), records), 320U);
+  uint32_t next[4] = {0U, 1000U, 2000U, 3000U};
+  for (const uint32_t sequence : Sequences(records)) {
+    ASSERT_LT(sequence / 1000U, 4U);
+    EXPECT_EQ(sequence, next[sequence / 1000U]++);
+  }
+}
+
+TEST(CrashRingTest, SkipsIncompleteRecords) {
+  CrashRing& ring = CrashRing::instance();
+  std::string recovered;
+  ASSERT_TRUE(ring.Start(MakeConfig("CRT1", MakeDirectory()), recovered));
+  for (uint32_t i = 0U; i < 5U; ++i) {
+    WriteRecord(ring, i);
+  }
+  std::string image = Snapshot(ring.Name());
+  ring.Stop();
+
+  // The writer of the third record died before storing its index.
+  const std::size_t third = sizeof(CrashRingHeader) + 2U * 3U * ara::log::internal::kCrashRingSlotSize;
+  std::memset(&image[third], 0, sizeof(uint64_t));  // the slot's index
+  std::string records;
+  EXPECT_EQ(ReadCrashRing(image.data(), image.size(), records), 4U);
+  EXPECT_EQ(Sequences(records), (std::vector<uint32_t>{0U, 1U, 3U, 4U}));
+
+  records.clear();
+  image[0] = 'X';
+  EXPECT_EQ(ReadCrashRing(image.data(), image.size(), records), 0U);
+  EXPECT_EQ(ReadCrashRing(image.data(), 10U, records), 0U);
+}
+
+TEST(CrashRingTest, RecoversAfterCrash) {
+  const std::string directory = MakeDirectory();
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    std::string recovered;
+    if (!CrashRing::instance().Start(MakeConfig("CRT1", directory), recovered)) {
+      _exit(1);
+    }
+    for (uint32_t i = 0U; i < 10U; ++i) {
+      WriteRecord(CrashRing::instance(), i);
+    }
+    abort();
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFSIGNALED(status));
+
+  CrashRing& ring = CrashRing::instance();
+  std::string recovered;
+  ASSERT_TRUE(ring.Start(MakeConfig("CRT1", directory), recovered));
+  ASSERT_EQ(recovered.compare(0U, directory.size() + 13U, directory + "/CRT1_crash_2"), 0) << recovered;
+  EXPECT_EQ(recovered.substr(recovered.size() - 4U), ".dlt");
+  EXPECT_EQ(Sequences(ReadFile(recovered)), (std::vector<uint32_t>{0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U}));
+
+  // The new ring starts empty, a clean exit leaves nothing.
+  std::string records;
+  const std::string image = Snapshot(ring.Name());
+  EXPECT_EQ(ReadCrashRing(image.data(), image.size(), records), 0U);
+  ring.Stop();
+  ASSERT_TRUE(ring.Start(MakeConfig("CRT1", directory), recovered));
+  EXPECT_TRUE(recovered.empty());
+  ring.Stop();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,122 @@
+/*
+ * @Description: structured fields, LogStream::With()
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "ara/log/file_sink.h"
+#include "ara/log/log_field.h"
+#include "ara/log/logger.h"
+
+using ara::log::internal::FieldKeyId;
+using ara::log::internal::FieldValue;
+using ara::log::internal::FileEncode;
+using ara::log::internal::FileSink;
+using ara::log::internal::FileSinkConfig;
+
+namespace {
+
+enum class Gear : uint8_t { kPark, kDrive };
+
+uint32_t Fnv1a(const std::string& text) {
+  uint32_t hash = 2166136261U;
+  for (const char c : text) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619U;
+  }
+  return hash;
+}
+
+// Field as LogStream::With() writes it into the raw argument.
+template <typename T>
+std::string Field(const std::string& key, char code, const T& value) {
+  std::string field(1U, static_cast<char>(ara::log::internal::kFieldTag));
+  field += code;
+  const uint32_t id = Fnv1a(key);
+  field.append(reinterpret_cast<const char*>(&id), sizeof(id));
+  field.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  return field;
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+}  // namespace
+
+TEST(FieldTest, KeyIdAndTypeCodes) {
+  static_assert(FieldKeyId("lat_us", 6U) != FieldKeyId("lat_ms", 6U), "keys collide");
+  EXPECT_EQ(FieldKeyId("lat_us", 6U), Fnv1a("lat_us"));
+  EXPECT_EQ(FieldKeyId("", 0U), 2166136261U);
+
+  static_assert(FieldValue<bool>::kCode == 'b', "");
+  static_assert(FieldValue<int8_t>::kCode == 'c', "");
+  static_assert(FieldValue<int16_t>::kCode == 'h', "");
+  static_assert(FieldValue<int32_t>::kCode == 'i', "");
+  static_assert(FieldValue<int64_t>::kCode == 'l', "");
+  static_assert(FieldValue<uint8_t>::kCode == 'C', "");
+  static_assert(FieldValue<uint16_t>::kCode == 'H', "");
+  static_assert(FieldValue<uint32_t>::kCode == 'I', "");
+  static_assert(FieldValue<uint64_t>::kCode == 'L', "");
+  static_assert(FieldValue<float>::kCode == 'f', "");
+  static_assert(FieldValue<double>::kCode == 'd', "");
+  static_assert(FieldValue<Gear>::kCode == 'C', "");
+  static_assert(std::is_same<FieldValue<long long>::Wire, int64_t>::value, "");
+}
+
+TEST(FieldTest, WithWritesRawFields) {
+  char directory[] = "/tmp/field_test.XXXXXX";
+  ASSERT_NE(mkdtemp(directory), nullptr);
+  FileSinkConfig config;
+  config.directory = directory;
+  config.file_name = "app.dlt";
+  config.file_encode = FileEncode::kBinary;
+  config.app_id = "TEST";
+  FileSink& sink = FileSink::instance();
+  ASSERT_TRUE(sink.Start(config));
+
+  auto& logger = ara::log::CreateLogger("FLD", "field test", ara::log::LogLevel::kInfo);
+  const std::string queue = "q0";
+  (logger.LogInfo() << "served").With("lat_us", int32_t{42}).With("depth", 7U).With("ok", true);
+  logger.LogInfo().With("ratio", 0.5).With("gear", Gear::kDrive).With("queue", queue).With("name", "lidar");
+  logger.LogDebug().With("disabled", int64_t{-1});
+  const ara::core::String lidar("front");
+  char buffer[] = "rear";
+  char* const mutable_text = buffer;
+  logger.LogInfo().With("lidar", lidar).With("buffer", buffer).With("mutable", mutable_text);
+  const std::string path = sink.file().CurrentPath();
+  sink.Stop();
+
+  const std::string content = ReadFile(path);
+  EXPECT_NE(content.find(Field("lat_us", 'i', int32_t{42})), std::string::npos);
+  EXPECT_NE(content.find(Field("depth", 'I', 7U)), std::string::npos);
+  EXPECT_NE(content.find(Field("ok", 'b', uint8_t{1U})), std::string::npos);
+  EXPECT_NE(content.find(Field("ratio", 'd', 0.5)), std::string::npos);
+  EXPECT_NE(content.find(Field("gear", 'C', uint8_t{1U})), std::string::npos);
+  // Strings without their NUL, the raw argument has the length.
+  EXPECT_NE(content.find(Field("queue", 's', 'q') + "0"), std::string::npos);
+  EXPECT_NE(content.find(Field("name", 's', 'l') + "idar"), std::string::npos);
+  EXPECT_NE(content.find(Field("lidar", 's', 'f') + "ront"), std::string::npos);
+  EXPECT_NE(content.find(Field("buffer", 's', 'r') + "ear"), std::string::npos);
+  EXPECT_NE(content.find(Field("mutable", 's', 'r') + "ear"), std::string::npos);
+  EXPECT_EQ(content.find(Field("disabled", 'l', int64_t{-1})), std::string::npos);
+  std::remove(path.c_str());
+  (void)rmdir(directory);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
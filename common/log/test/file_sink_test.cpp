@@ -0,0 +1,406 @@
+/*
+ * @Description: native file sink, rotation, retention and record encoding
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+#include <gtest/gtest.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ara/log/file_sink.h"
+#include "ara/log/log_field.h"
+
+using ara::log::internal::FieldKeyId;
+using ara::log::internal::FileCompression;
+using ara::log::internal::FileCompressor;
+using ara::log::internal::FileEncode;
+using ara::log::internal::FileSaveMode;
+using ara::log::internal::FileSink;
+using ara::log::internal::FileSinkConfig;
+using ara::log::internal::kFieldTag;
+using ara::log::internal::RotatingFile;
+
+namespace {
+
+std::string MakeDirectory() {
+  char path[] = "/tmp/file_sink_test.XXXXXX";
+  EXPECT_NE(mkdtemp(path), nullptr);
+  return path;
+}
+
+std::vector<std::string> ListFiles(const std::string& directory) {
+  std::vector<std::string> names;
+  DIR* const dir = opendir(directory.c_str());
+  while (const struct dirent* const entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      names.emplace_back(entry->d_name);
+    }
+  }
+  closedir(dir);
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+FileSinkConfig MakeConfig(const std::string& directory, FileSaveMode mode, uint32_t max_files, uint32_t file_size) {
+  FileSinkConfig config;
+  config.directory = directory;
+  config.file_name = "app.txt";
+  config.file_save_mode = mode;
+  config.max_files = max_files;
+  config.file_size = file_size;
+  config.app_id = "TEST";
+  return config;
+}
+
+std::string ReadGzipFile(const std::string& path) {
+  std::string content;
+  gzFile in = gzopen(path.c_str(), "rb");
+  EXPECT_NE(in, nullptr) << path;
+  char buffer[4096];
+  int size = 0;
+  while ((size = gzread(in, buffer, sizeof(buffer))) > 0) {
+    content.append(buffer, static_cast<std::size_t>(size));
+  }
+  gzclose(in);
+  return content;
+}
+
+bool EndsWith(const std::string& text, const std::string& suffix) {
+  return (text.size() >= suffix.size()) && (text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+// Verbose argument as DLT writes it, type info and value in host byte order.
+template <typename T>
+void Put(std::vector<unsigned char>& buffer, const T& value) {
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+}  // namespace
+
+TEST(RotatingFileTest, RotatesBySize) {
+  const std::string directory = MakeDirectory();
+  RotatingFile file;
+  ASSERT_TRUE(file.Open(MakeConfig(directory, FileSaveMode::kSize, 0U, 4096U)));
+  const std::string line(1000U, 'x');
+  for (int i = 0; i < 10; ++i) {
+    file.Write(line.data(), line.size(), time(nullptr));
+  }
+  file.Close();
+  const std::vector<std::string> names = ListFiles(directory);
+  ASSERT_EQ(names.size(), 3U);
+  std::size_t total = 0U;
+  for (const std::string& name : names) {
+    EXPECT_EQ(name.compare(0U, 4U, "app_"), 0) << name;
+    EXPECT_EQ(name.substr(name.size() - 4U), ".txt") << name;
+    const std::string content = ReadFile(directory + "/" + name);
+    // Truncated to its content on close, records are never split.
+    EXPECT_EQ(content.size() % line.size(), 0U);
+    total += content.size();
+  }
+  EXPECT_EQ(total, 10U * line.size());
+}
+
+TEST(RotatingFileTest, KeepsMaxFiles) {
+  const std::string directory = MakeDirectory();
+  RotatingFile file;
+  ASSERT_TRUE(file.Open(MakeConfig(directory, FileSaveMode::kSize, 2U, 4096U)));
+  const std::string line(4096U, 'y');
+  for (int i = 0; i < 5; ++i) {
+    file.Write(line.data(), line.size(), time(nullptr));
+    file.Sync();
+  }
+  EXPECT_EQ(ListFiles(directory).size(), 2U);
+  const std::string current = file.CurrentPath();
+  file.Close();
+  const std::vector<std::string> names = ListFiles(directory);
+  ASSERT_EQ(names.size(), 2U);
+  EXPECT_EQ(directory + "/" + names.back(), current);
+}
+
+TEST(RotatingFileTest, KeepsFilesInUseWhenClockGoesBack) {
+  const std::string directory = MakeDirectory();
+  RotatingFile file;
+  ASSERT_TRUE(file.Open(MakeConfig(directory, FileSaveMode::kSize, 2U, 4096U)));
+  const std::string line(4000U, 'z');  // a file each
+  const time_t start = time(nullptr);
+  file.Write(line.data(), line.size(), start + 86400);
+  file.Write(line.data(), line.size(), start + 86400);
+  file.Sync();
+  // Set back by two days, the new file has the oldest stamp.
+  file.Write(line.data(), line.size(), start - 86400);
+  file.Sync();
+  const std::string current = file.CurrentPath();
+  const std::vector<std::string> names = ListFiles(directory);
+  ASSERT_EQ(names.size(), 2U);
+  EXPECT_EQ(directory + "/" + names.front(), current);
+  EXPECT_EQ(access(current.c_str(), F_OK), 0);
+  file.Write("end\n", 4U, start - 86400);
+  file.Close();
+  EXPECT_EQ(ListFiles(directory), names);
+  EXPECT_TRUE(ReadFile(current) == line + "end\n");
+}
+
+TEST(RotatingFileTest, RotatesByTime) {
+  const std::string directory = MakeDirectory();
+  RotatingFile file;
+  ASSERT_TRUE(file.Open(MakeConfig(directory, FileSaveMode::kMinutely, 0U, 65536U)));
+  const time_t start = time(nullptr);
+  file.Write("a\n", 2U, start);
+  file.Write("b\n", 2U, start + 61);
+  file.Write("c\n", 2U, start + 62);
+  file.Write("d\n", 2U, start + 3600);
+  file.Sync();
+  // Hidden until renamed, the current file has its final name now.
+  EXPECT_EQ(file.CurrentPath().find("/.app"), std::string::npos);
+  file.Close();
+  const std::vector<std::string> names = ListFiles(directory);
+  ASSERT_EQ(names.size(), 3U);
+  std::string content;
+  for (const std::string& name : names) {
+    content += ReadFile(directory + "/" + name);
+  }
+  EXPECT_EQ(content, "a\nb\nc\nd\n");
+}
+
+TEST(RotatingFileTest, FailsWithoutDirectory) {
+  RotatingFile file;
+  EXPECT_FALSE(file.Open(MakeConfig("/nonexistent/file_sink_test", FileSaveMode::kSize, 0U, 4096U)));
+  file.Write("lost", 4U, 0);
+}
+
+TEST(RotatingFileTest, CompressesRotatedFiles) {
+  const std::string directory = MakeDirectory();
+  FileSinkConfig config = MakeConfig(directory, FileSaveMode::kSize, 3U, 4096U);
+  config.compression = FileCompression::kGzip;
+  config.compress_cpu_percent = 50U;
+  RotatingFile file;
+  ASSERT_TRUE(file.Open(config));
+  std::string written;
+  for (int i = 0; i < 40; ++i) {
+    const std::string line = "record " + std::to_string(i) + std::string(400U, '.') + "\n";
+    file.Write(line.data(), line.size(), time(nullptr));
+    written += line;
+  }
+  file.Sync();
+  const std::string current = file.CurrentPath();
+  std::vector<std::string> names = ListFiles(directory);
+  // Retention counts compressed files, the current one is never compressed.
+  ASSERT_EQ(names.size(), 3U);
+  std::string content;
+  for (const std::string& name : names) {
+    const std::string path = directory + "/" + name;
+    if (path == current) {
+      // Still preallocated, the tail is zeros.
+      const std::string mapped = ReadFile(path);
+      content += mapped.substr(0U, mapped.find('\0'));
+    } else {
+      EXPECT_TRUE(EndsWith(name, ".txt.gz")) << name;
+      content += ReadGzipFile(path);
+    }
+  }
+  EXPECT_TRUE(EndsWith(written, content));
+  file.Close();
+
+  // The next run compresses what the last one left.
+  ASSERT_TRUE(file.Open(config));
+  file.Sync();
+  EXPECT_TRUE(EndsWith(written, ReadGzipFile(current + ".gz")));
+  names = ListFiles(directory);
+  EXPECT_EQ(names.size(), 3U);
+  EXPECT_EQ(std::count_if(names.begin(), names.end(), [](const std::string& name) { return EndsWith(name, ".txt"); }),
+            1);
+  file.Close();
+}
+
+TEST(FileCompressorTest, ReplacesFileWithGzip) {
+  const std::string directory = MakeDirectory();
+  const std::string path = directory + "/plain.txt";
+  std::string content;
+  for (int i = 0; i < 100000; ++i) {
+    content += "line " + std::to_string(i) + "\n";
+  }
+  std::ofstream(path) << content;
+  FileCompressor compressor;
+  ASSERT_TRUE(compressor.Start(FileCompression::kGzip, 100U, nullptr));
+  EXPECT_TRUE(compressor.Compress(path));
+  EXPECT_NE(access(path.c_str(), F_OK), 0);
+  EXPECT_EQ(ReadGzipFile(path + ".gz"), content);
+  EXPECT_FALSE(compressor.Compress(directory + "/missing.txt"));
+  EXPECT_EQ(ListFiles(directory), std::vector<std::string>{"plain.txt.gz"});
+  compressor.Stop();
+}
+
+TEST(FileSinkTest, WritesTextLines) {
+  const std::string directory = MakeDirectory();
+  FileSink& sink = FileSink::instance();
+  ASSERT_TRUE(sink.Start(MakeConfig(directory, FileSaveMode::kSize, 0U, 65536U)));
+  EXPECT_TRUE(sink.IsRunning());
+
+  DltContext context{};
+  std::memcpy(context.contextID, "CTX1", 4U);
+  context.mcnt = 7U;
+  std::vector<unsigned char> payload;
+  const char text[] = "hello";
+  Put(payload, uint32_t{0x00000200U});  // string
+  Put(payload, uint16_t{sizeof(text)});
+  payload.insert(payload.end(), text, text + sizeof(text));
+  Put(payload, uint32_t{0x00000023U});  // signed, 32 bit
+  Put(payload, int32_t{-42});
+  Put(payload, uint32_t{0x00010043U});  // unsigned, 32 bit, hex
+  Put(payload, uint32_t{100U});
+  DltContextData record{};
+  record.handle = &context;
+  record.buffer = payload.data();
+  record.size = static_cast<int32_t>(payload.size());
+  record.log_level = DLT_LOG_INFO;
+  record.args_num = 3;
+  sink.Write(record);
+  const std::string path = sink.file().CurrentPath();
+  sink.Stop();
+  EXPECT_FALSE(sink.IsRunning());
+
+  const std::string content = ReadFile(path);
+  ASSERT_FALSE(content.empty());
+  EXPECT_EQ(content.back(), '\n');
+  EXPECT_NE(content.find(" 007 ECU1 TEST CTX1 log info V 3 [hello -42 0x00000064]\n"), std::string::npos)
+      << content;
+}
+
+TEST(FileSinkTest, WritesStructuredFields) {
+  const std::string directory = MakeDirectory();
+  FileSink& sink = FileSink::instance();
+  ASSERT_TRUE(sink.Start(MakeConfig(directory, FileSaveMode::kSize, 0U, 65536U)));
+
+  DltContext context{};
+  std::memcpy(context.contextID, "CTX3", 4U);
+  std::vector<unsigned char> payload;
+  // LogStream::With("lat_us", int16_t{-5}) and With("q", "deep"), then raw data that isn't a field.
+  Put(payload, uint32_t{0x00000400U});  // raw
+  Put(payload, uint16_t{8U});
+  Put(payload, kFieldTag);
+  Put(payload, 'h');
+  Put(payload, FieldKeyId("lat_us", 6U));
+  Put(payload, int16_t{-5});
+  Put(payload, uint32_t{0x00000400U});
+  Put(payload, uint16_t{10U});
+  Put(payload, kFieldTag);
+  Put(payload, 's');
+  Put(payload, uint32_t{0x0000abcdU});
+  payload.insert(payload.end(), {'d', 'e', 'e', 'p'});
+  Put(payload, uint32_t{0x00000400U});
+  Put(payload, uint16_t{3U});
+  payload.insert(payload.end(), {0xa5U, 'h', 0x01U});
+  DltContextData record{};
+  record.handle = &context;
+  record.buffer = payload.data();
+  record.size = static_cast<int32_t>(payload.size());
+  record.log_level = DLT_LOG_INFO;
+  record.args_num = 3;
+  sink.Write(record);
+  const std::string path = sink.file().CurrentPath();
+  sink.Stop();
+
+  char lat[16] = {};
+  std::snprintf(lat, sizeof(lat), "#%08x", FieldKeyId("lat_us", 6U));
+  EXPECT_NE(ReadFile(path).find(std::string("[") + lat + "=-5 #0000abcd=deep a5'68'01]\n"), std::string::npos)
+      << ReadFile(path);
+}
+
+TEST(FileSinkTest, KeepsRecordsFromDltWithoutOtherOutput) {
+  const std::string directory = MakeDirectory();
+  FileSinkConfig config = MakeConfig(directory, FileSaveMode::kSize, 0U, 65536U);
+  config.forward_to_dlt = false;  // kFile alone
+  FileSink& sink = FileSink::instance();
+  ASSERT_TRUE(sink.Start(config));
+  EXPECT_FALSE(sink.ForwardsToDlt());
+
+  DltContext context{};
+  std::memcpy(context.contextID, "CTX4", 4U);
+  context.mcnt = 9U;
+  std::vector<unsigned char> payload;
+  const char text[] = "only";
+  Put(payload, uint32_t{0x00000200U});  // string
+  Put(payload, uint16_t{sizeof(text)});
+  payload.insert(payload.end(), text, text + sizeof(text));
+  DltContextData record{};
+  record.handle = &context;
+  // owned like a record from dlt_user_log_write_start()
+  record.buffer = static_cast<unsigned char*>(std::malloc(payload.size()));
+  std::memcpy(record.buffer, payload.data(), payload.size());
+  record.size = static_cast<int32_t>(payload.size());
+  record.log_level = DLT_LOG_INFO;
+  record.args_num = 1;
+  EXPECT_FALSE(ara::log::internal::WriteRecord(record));
+  EXPECT_EQ(record.buffer, nullptr);
+  EXPECT_EQ(context.mcnt, 10U);
+  const std::string path = sink.file().CurrentPath();
+  sink.Stop();
+  EXPECT_TRUE(sink.ForwardsToDlt());
+
+  EXPECT_NE(ReadFile(path).find(" 009 ECU1 TEST CTX4 log info V 1 [only]\n"), std::string::npos) << ReadFile(path);
+}
+
+TEST(FileSinkTest, WritesDltStorageRecords) {
+  const std::string directory = MakeDirectory();
+  FileSinkConfig config = MakeConfig(directory, FileSaveMode::kSize, 0U, 65536U);
+  config.file_name = "app.dlt";
+  config.file_encode = FileEncode::kBinary;
+  FileSink& sink = FileSink::instance();
+  ASSERT_TRUE(sink.Start(config));
+
+  DltContext context{};
+  std::memcpy(context.contextID, "CTX2", 4U);
+  std::vector<unsigned char> payload;
+  Put(payload, uint32_t{0x00000011U});  // bool
+  Put(payload, uint8_t{1U});
+  DltContextData record{};
+  record.handle = &context;
+  record.buffer = payload.data();
+  record.size = static_cast<int32_t>(payload.size());
+  record.log_level = DLT_LOG_WARN;
+  record.args_num = 1;
+  sink.Write(record);
+  sink.Write(record);
+  const std::string path = sink.file().CurrentPath();
+  sink.Stop();
+
+  const std::string content = ReadFile(path);
+  const std::size_t size = 16U + 12U + 10U + payload.size();
+  ASSERT_EQ(content.size(), 2U * size);
+  EXPECT_EQ(content.compare(0U, 4U, "DLT\x01"), 0);
+  EXPECT_EQ(content.compare(12U, 4U, "ECU1"), 0);
+  const unsigned char* standard = reinterpret_cast<const unsigned char*>(content.data()) + 16U;
+  EXPECT_EQ(standard[0] & 0x15U, 0x15U);  // extended header, ECU ID, timestamp
+  EXPECT_EQ((standard[2] << 8U) | standard[3], static_cast<int>(size - 16U));
+  EXPECT_EQ(standard[12], (DLT_LOG_WARN << 4U) | 0x01U);
+  EXPECT_EQ(standard[13], 1U);
+  EXPECT_EQ(content.compare(16U + 14U, 8U, "TESTCTX2"), 0);
+  EXPECT_EQ(content.compare(size - payload.size(), payload.size(),
+                            std::string(payload.begin(), payload.end())),
+            0);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
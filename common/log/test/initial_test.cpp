@@ -11,7 +11,9 @@
 #include <gtest/gtest.h>
 
 #include <thread>
+#include <vector>
 
+#include "ara/log/context_table.h"
 #include "ara/log/logger.h"
 #include "ara/log/logmanager.h"
 
@@ -48,6 +50,57 @@ TEST(LOGTEST, CreateContext) {
   }
 }
 
+TEST(LOGTEST, CreateContextConcurrently) {
+  auto& inst = ara::log::LogManager::instance();
+  std::vector<ara::log::Logger*> loggers(16U, nullptr);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0U; i < loggers.size(); ++i) {
+    threads.emplace_back([&inst, &loggers, i]() {
+      for (int n = 0; n < 1000; ++n) {
+        loggers[i] = &inst.createLogContext(ara::core::StringView("CONC"), ara::core::StringView("TEST CONC"));
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  for (ara::log::Logger* logger : loggers) {
+    EXPECT_EQ(logger, loggers.front());
+  }
+  // IDs longer than four characters are not in the lock free table, they stay distinct.
+  auto& first = inst.createLogContext(ara::core::StringView("LONGA"), ara::core::StringView("TEST LONG"));
+  auto& second = inst.createLogContext(ara::core::StringView("LONGB"), ara::core::StringView("TEST LONG"));
+  EXPECT_NE(&first, &second);
+  EXPECT_EQ(&first, &inst.createLogContext(ara::core::StringView("LONGA"), ara::core::StringView("TEST LONG")));
+}
+
+TEST(LOGTEST, ContextTable) {
+  using ara::log::internal::ContextTable;
+  uint32_t key = 0U;
+  EXPECT_FALSE(ContextTable::Pack(ara::core::StringView(""), key));
+  EXPECT_FALSE(ContextTable::Pack(ara::core::StringView("ABCDE"), key));
+  EXPECT_FALSE(ContextTable::Pack(ara::core::StringView("A\0B", 3U), key));
+  uint32_t other = 0U;
+  ASSERT_TRUE(ContextTable::Pack(ara::core::StringView("AB"), key));
+  ASSERT_TRUE(ContextTable::Pack(ara::core::StringView("ABC"), other));
+  EXPECT_NE(key, other);
+
+  ContextTable table;
+  ara::log::Logger* const logger = reinterpret_cast<ara::log::Logger*>(&table);
+  EXPECT_EQ(table.Find(key), nullptr);
+  uint32_t inserted = 0U;
+  for (uint32_t id = 1U; id <= ContextTable::kCapacity; ++id) {
+    if (table.Insert(id, logger)) {
+      ++inserted;
+    }
+  }
+  EXPECT_EQ(inserted, static_cast<uint32_t>(ContextTable::kMaxEntries));
+  for (uint32_t id = 1U; id <= inserted; ++id) {
+    EXPECT_EQ(table.Find(id), logger);
+  }
+  EXPECT_EQ(table.Find(inserted + 1U), nullptr);
+}
+
 TEST(LOGTEST, InitiLogging) {
   ara::log::InitLogging(
       "TSN1", "example for AP logger", ara::log::LogLevel::kVerbose,
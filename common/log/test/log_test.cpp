@@ -10,7 +10,12 @@
  */
 #include <gtest/gtest.h>
 
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <fstream>
+#include <thread>
 #include <type_traits>
 
 #include "ara/log/logger.h"
@@ -141,6 +146,27 @@ TEST(LOG, Callback) {
   ara::log::RegisterConnectionStateHandler(cb);
 }
 
+TEST(LOG, CurrentThreadId) {
+  const int32_t tid = ara::log::CurrentThreadId();
+  EXPECT_EQ(tid, static_cast<int32_t>(::syscall(SYS_gettid)));
+  EXPECT_EQ(ara::log::CurrentThreadId(), tid);
+
+  int32_t other = 0;
+  std::thread([&other]() { other = ara::log::CurrentThreadId(); }).join();
+  EXPECT_NE(other, 0);
+  EXPECT_NE(other, tid);
+
+  const pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    ::_exit(ara::log::CurrentThreadId() == static_cast<int32_t>(::syscall(SYS_gettid)) ? 0 : 1);
+  }
+  int status = -1;
+  ASSERT_EQ(::waitpid(child, &status, 0), child);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
 int main(int argc, char** argv) {
   try {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,72 @@
+/*
+ * @Description: cached level check and compile-time ARA_LOG_MIN_LEVEL
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+#define ARA_LOG_MIN_LEVEL 4  // kInfo
+
+#include <gtest/gtest.h>
+
+#include "ara/log/logger.h"
+
+namespace {
+
+int g_evaluated = 0;
+
+int Evaluate() { return ++g_evaluated; }
+
+}  // namespace
+
+TEST(MinLevelTest, StrippedStatementsAreNotEvaluated) {
+  auto& logger = ara::log::CreateLogger("MINL", "min level test", ara::log::LogLevel::kVerbose);
+  ASSERT_TRUE(logger.IsEnabled(ara::log::LogLevel::kDebug));
+  g_evaluated = 0;
+  ARA_LOG_DEBUG(logger) << "stripped" << Evaluate();
+  ARA_LOG_VERBOSE(logger) << "stripped" << Evaluate();
+  EXPECT_EQ(g_evaluated, 0);
+  ARA_LOG_INFO(logger) << "kept" << Evaluate();
+  ARA_LOG_WITH_LEVEL(logger, ara::log::LogLevel::kError) << "kept" << Evaluate();
+  EXPECT_EQ(g_evaluated, 2);
+  EXPECT_FALSE(ARA_LOG_ENABLED(logger, ara::log::LogLevel::kDebug));
+  EXPECT_TRUE(ARA_LOG_ENABLED(logger, ara::log::LogLevel::kInfo));
+}
+
+TEST(MinLevelTest, RuntimeLevelStillApplies) {
+  auto& logger = ara::log::CreateLogger("MINW", "min level test", ara::log::LogLevel::kWarn);
+  g_evaluated = 0;
+  ARA_LOG_INFO(logger) << "disabled" << Evaluate();
+  EXPECT_EQ(g_evaluated, 0);
+  ARA_LOG_WARN(logger) << "enabled" << Evaluate();
+  EXPECT_EQ(g_evaluated, 1);
+
+  // dangling else binds to the caller's if
+  bool taken = false;
+  if (g_evaluated == 0)
+    ARA_LOG_WARN(logger) << "not reached";
+  else
+    taken = true;
+  EXPECT_TRUE(taken);
+}
+
+TEST(MinLevelTest, CachedLevelFollowsContext) {
+  auto& logger = ara::log::CreateLogger("MINC", "min level test", ara::log::LogLevel::kInfo);
+  EXPECT_FALSE(logger.IsEnabled(ara::log::LogLevel::kOff));
+  EXPECT_TRUE(logger.IsEnabled(ara::log::LogLevel::kInfo));
+  EXPECT_FALSE(logger.IsEnabled(ara::log::LogLevel::kDebug));
+
+  // What DLT does when a level is injected for the context.
+  int8_t* const level = logger.getContext()->log_level_ptr;
+  ASSERT_NE(level, nullptr);
+  *level = static_cast<int8_t>(ara::log::LogLevel::kError);
+  logger.refreshLogLevel();
+  EXPECT_TRUE(logger.IsEnabled(ara::log::LogLevel::kError));
+  EXPECT_FALSE(logger.IsEnabled(ara::log::LogLevel::kWarn));
+  *level = static_cast<int8_t>(ara::log::LogLevel::kInfo);
+  logger.refreshLogLevel();
+  EXPECT_TRUE(logger.IsEnabled(ara::log::LogLevel::kInfo));
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+/*
+ * @Description: modeled messages and their catalog entries
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "ara/log/modeled_message.h"
+
+using ara::log::internal::MakeCatalogEntry;
+using ara::log::internal::ModeledTypes;
+
+namespace {
+
+enum class Gear : uint8_t { kPark, kDrive };
+
+int g_evaluated = 0;
+
+int Evaluate() { return ++g_evaluated; }
+
+uint32_t Fnv1a(const void* data, std::size_t size) {
+  uint32_t hash = 2166136261U;
+  for (std::size_t i = 0U; i < size; ++i) {
+    hash = (hash ^ static_cast<const uint8_t*>(data)[i]) * 16777619U;
+  }
+  return hash;
+}
+
+}  // namespace
+
+TEST(ModeledTest, CatalogEntryLayout) {
+  constexpr auto entry = MakeCatalogEntry<ModeledTypes<bool, int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t,
+                                                       uint32_t, uint64_t, float, double, const char*, std::string,
+                                                       ara::core::StringView, Gear>>("ARALOG1\0f.cpp\0" "7\0{}");
+  static_assert(sizeof(entry) == sizeof("ARALOG1\0f.cpp\0" "7\0{}") + 16U, "entry is not packed");
+  EXPECT_EQ(std::string(entry.types), "bchilCHILfdsssC");
+  EXPECT_EQ(std::memcmp(entry.text, "ARALOG1\0f.cpp\0" "7\0{}", sizeof(entry.text)), 0);
+
+  constexpr uint32_t id = entry.Id();
+  EXPECT_EQ(id, Fnv1a(&entry, sizeof(entry)));
+  constexpr auto other = MakeCatalogEntry<ModeledTypes<int32_t>>("ARALOG1\0f.cpp\0" "7\0{}");
+  EXPECT_NE(other.Id(), id);
+}
+
+TEST(ModeledTest, LogModeled) {
+  auto& logger = ara::log::CreateLogger("MODL", "modeled test", ara::log::LogLevel::kInfo);
+  const std::string text = "text";
+  ARA_LOG_MODELED(logger, ara::log::LogLevel::kInfo, "no arguments");
+  ARA_LOG_MODELED(logger, ara::log::LogLevel::kInfo, "{} {} {} {} {} {}", true, 1, 2U, 3.0, text, Gear::kDrive);
+  ARA_LOG_MODELED(logger, ara::log::LogLevel::kWarn, "{} {}", "literal", ara::core::StringView("view"));
+
+  g_evaluated = 0;
+  ARA_LOG_MODELED(logger, ara::log::LogLevel::kDebug, "disabled {}", Evaluate());
+  EXPECT_EQ(g_evaluated, 0);
+  ARA_LOG_MODELED(logger, ara::log::LogLevel::kInfo, "enabled {}", Evaluate());
+  EXPECT_EQ(g_evaluated, 1);
+}
+
+// The decoder finds the entries by scanning the binary, they must survive
+// the build even though the code only uses their IDs.
+TEST(ModeledTest, CatalogEntryInBinary) {
+  std::ifstream file("/proc/self/exe", std::ios::binary);
+  ASSERT_TRUE(file.good());
+  const std::string binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  // Built at runtime, a literal of the whole record would be found instead.
+  std::string record(1U, '\0');
+  for (int i = 0; i < 6; ++i) {
+    record += (i == 0) ? "{}" : " {}";
+  }
+  record += '\0';
+  for (const char code : {'b', 'i', 'I', 'd', 's', 'C'}) {
+    record += code;
+  }
+  record += '\0';
+  EXPECT_NE(binary.find(record), std::string::npos);
+  record[record.size() - 2U] = 'L';
+  EXPECT_EQ(binary.find(record), std::string::npos);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
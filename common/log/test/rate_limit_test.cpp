@@ -0,0 +1,182 @@
+/*
+ * @Description: per call site rate limiting, ARA_LOG_EVERY_N/FIRST_N/EVERY_MS
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "ara/log/logger.h"
+
+using ara::log::internal::LogOccurrence;
+using ara::log::internal::LogRateLimiter;
+
+namespace {
+
+int g_evaluated = 0;
+
+int Evaluate() { return ++g_evaluated; }
+
+}  // namespace
+
+TEST(RateLimiterTest, EveryN) {
+  LogRateLimiter limiter;
+  for (int round = 0; round < 3; ++round) {
+    const LogOccurrence first = limiter.EveryN(4U);
+    EXPECT_TRUE(first.pending);
+    EXPECT_EQ(first.suppressed, round == 0 ? 0U : 3U);
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_FALSE(limiter.EveryN(4U).pending);
+    }
+  }
+  LogRateLimiter every;
+  EXPECT_TRUE(every.EveryN(0U).pending);
+  EXPECT_TRUE(every.EveryN(1U).pending);
+}
+
+TEST(RateLimiterTest, FirstN) {
+  LogRateLimiter limiter;
+  EXPECT_TRUE(limiter.FirstN(2U).pending);
+  EXPECT_TRUE(limiter.FirstN(2U).pending);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(limiter.FirstN(2U).pending);
+  }
+}
+
+TEST(RateLimiterTest, EveryMs) {
+  LogRateLimiter limiter;
+  EXPECT_TRUE(limiter.EveryMs(50U).pending);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_FALSE(limiter.EveryMs(50U).pending);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  const LogOccurrence next = limiter.EveryMs(50U);
+  EXPECT_TRUE(next.pending);
+  EXPECT_EQ(next.suppressed, 10U);
+}
+
+TEST(RateLimiterTest, ConcurrentCallSite) {
+  LogRateLimiter limiter;
+  std::vector<std::thread> threads;
+  std::vector<uint64_t> passed(4U, 0U);
+  std::vector<uint64_t> suppressed(4U, 0U);
+  for (std::size_t t = 0U; t < 4U; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < 10000; ++i) {
+        const LogOccurrence occurrence = limiter.EveryN(100U);
+        if (occurrence.pending) {
+          ++passed[t];
+          suppressed[t] += occurrence.suppressed;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  uint64_t total_passed = 0U;
+  uint64_t total_suppressed = 0U;
+  for (std::size_t t = 0U; t < 4U; ++t) {
+    total_passed += passed[t];
+    total_suppressed += suppressed[t];
+  }
+  EXPECT_EQ(total_passed, 400U);
+  // Every drop is reported exactly once, the last ones with the next logged statement.
+  total_suppressed += limiter.EveryN(1U).suppressed;
+  EXPECT_EQ(total_suppressed, 40000U - 400U);
+}
+
+TEST(RateLimiterTest, ConcurrentFirstN) {
+  LogRateLimiter limiter;
+  std::vector<std::thread> threads;
+  std::atomic<uint64_t> passed{0U};
+  for (std::size_t t = 0U; t < 4U; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 10000; ++i) {
+        if (limiter.FirstN(10U).pending) {
+          ++passed;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  // The summary interval starts with the first suppressed statement on any thread.
+  EXPECT_EQ(passed.load(), 10U);
+}
+
+TEST(RateLimitMacroTest, ReportsDropsOfFinalBurst) {
+  auto& logger = ara::log::CreateLogger("RATE", "rate limit test", ara::log::LogLevel::kVerbose);
+  (void)ara::log::internal::ReportSuppressed(true);
+  for (int i = 0; i < 6; ++i) {
+    ARA_LOG_EVERY_MS(logger, ara::log::LogLevel::kWarn, 60000) << "once a minute";
+  }
+  // Not before the next statement would have been logged, but at exit.
+  EXPECT_EQ(ara::log::internal::ReportSuppressed(false), 0U);
+  EXPECT_EQ(ara::log::internal::ReportSuppressed(true), 5U);
+  EXPECT_EQ(ara::log::internal::ReportSuppressed(true), 0U);
+
+  for (int i = 0; i < 4; ++i) {
+    ARA_LOG_EVERY_MS(logger, ara::log::LogLevel::kWarn, 50) << "every 50 ms";
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  EXPECT_EQ(ara::log::internal::ReportSuppressed(false), 3U);
+}
+
+TEST(RateLimitMacroTest, DroppedStatementsAreNotEvaluated) {
+  auto& logger = ara::log::CreateLogger("RATE", "rate limit test", ara::log::LogLevel::kVerbose);
+  g_evaluated = 0;
+  for (int i = 0; i < 10; ++i) {
+    ARA_LOG_EVERY_N(logger, ara::log::LogLevel::kInfo, 3) << "every 3rd" << Evaluate();
+  }
+  EXPECT_EQ(g_evaluated, 4);
+
+  g_evaluated = 0;
+  for (int i = 0; i < 10; ++i) {
+    ARA_LOG_FIRST_N(logger, ara::log::LogLevel::kWarn, 2) << "first 2" << Evaluate();
+  }
+  EXPECT_EQ(g_evaluated, 2);
+
+  g_evaluated = 0;
+  for (int i = 0; i < 10; ++i) {
+    ARA_LOG_EVERY_MS(logger, ara::log::LogLevel::kError, 60000) << "once a minute" << Evaluate();
+  }
+  EXPECT_EQ(g_evaluated, 1);
+}
+
+TEST(RateLimitMacroTest, CallSitesAreIndependent) {
+  auto& logger = ara::log::CreateLogger("RATE", "rate limit test", ara::log::LogLevel::kVerbose);
+  g_evaluated = 0;
+  ARA_LOG_FIRST_N(logger, ara::log::LogLevel::kInfo, 1) << "site a" << Evaluate();
+  ARA_LOG_FIRST_N(logger, ara::log::LogLevel::kInfo, 1) << "site b" << Evaluate();
+  EXPECT_EQ(g_evaluated, 2);
+}
+
+TEST(RateLimitMacroTest, DisabledLevelIsNotCounted) {
+  auto& logger = ara::log::CreateLogger("RATW", "rate limit test", ara::log::LogLevel::kWarn);
+  g_evaluated = 0;
+  for (int i = 0; i < 2; ++i) {
+    const bool warn = (i == 1);
+    ARA_LOG_FIRST_N(logger, warn ? ara::log::LogLevel::kWarn : ara::log::LogLevel::kInfo, 1)
+        << "first enabled one" << Evaluate();
+  }
+  EXPECT_EQ(g_evaluated, 1);
+
+  // dangling else binds to the caller's if
+  bool taken = false;
+  if (g_evaluated == 0)
+    ARA_LOG_EVERY_N(logger, ara::log::LogLevel::kWarn, 1) << "not reached";
+  else
+    taken = true;
+  EXPECT_TRUE(taken);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
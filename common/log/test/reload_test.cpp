@@ -0,0 +1,125 @@
+/*
+ * @Description: reloading log levels from the configuration file
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+#include <gtest/gtest.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "ara/log/config_watcher.h"
+#include "ara/log/logger.h"
+#include "ara/log/logmanager.h"
+
+using ara::log::LogLevel;
+using ara::log::internal::ConfigWatcher;
+
+namespace {
+
+std::string g_directory;
+
+std::string ConfigPath() { return g_directory + "/Log_configure.json"; }
+
+// Written next to the file and renamed over it, as deployment tools do.
+void WriteConfig(const std::string& path, const std::string& content) {
+  const std::string temporary = path + ".new";
+  std::ofstream(temporary) << content;
+  ASSERT_EQ(std::rename(temporary.c_str(), path.c_str()), 0);
+}
+
+std::string MakeConfig(const std::string& level, const std::string& context_levels) {
+  return "{\"log_app_id\": \"RLD\", \"log_default_level\": \"" + level +
+         "\", \"log_mode\": [\"kConsole\"], \"log_config_watch\": true, \"log_context_levels\": {" + context_levels +
+         "}}";
+}
+
+template <typename Predicate>
+bool WaitFor(const Predicate& predicate) {
+  for (int i = 0; i < 500; ++i) {
+    if (predicate()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return predicate();
+}
+
+}  // namespace
+
+TEST(ReloadConfigurationTest, AppliesLevels) {
+  ara::log::Logger& a = ara::log::CreateLogger("RLA1", "reload test");
+  ara::log::Logger& b = ara::log::CreateLogger("RLB1", "reload test");
+  ara::log::Logger& c = ara::log::CreateLogger("RLC1", "reload test", LogLevel::kError);
+  EXPECT_TRUE(a.IsEnabled(LogLevel::kDebug));
+  EXPECT_FALSE(a.IsEnabled(LogLevel::kVerbose));
+  EXPECT_TRUE(b.IsEnabled(LogLevel::kWarn));
+  EXPECT_FALSE(b.IsEnabled(LogLevel::kInfo));
+  EXPECT_FALSE(c.IsEnabled(LogLevel::kWarn));
+
+  WriteConfig(ConfigPath(), MakeConfig("kInfo", "\"RLB1\": \"kVerbose\", \"TOOLONG\": \"kDebug\""));
+  EXPECT_TRUE(ara::log::ReloadConfiguration());
+  // Without an entry a context is back at the default or the level it was created with.
+  EXPECT_TRUE(a.IsEnabled(LogLevel::kInfo));
+  EXPECT_FALSE(a.IsEnabled(LogLevel::kDebug));
+  EXPECT_TRUE(b.IsEnabled(LogLevel::kVerbose));
+  EXPECT_TRUE(c.IsEnabled(LogLevel::kError));
+  EXPECT_FALSE(c.IsEnabled(LogLevel::kWarn));
+  // The API's own context follows the default, DLT changes it with the application.
+  EXPECT_TRUE(ara::log::LogManager::instance().internalLogger().IsEnabled(LogLevel::kInfo));
+  EXPECT_FALSE(ara::log::LogManager::instance().internalLogger().IsEnabled(LogLevel::kDebug));
+
+  // Contexts created later get their level too.
+  EXPECT_FALSE(ara::log::CreateLogger("RLD1", "reload test").IsEnabled(LogLevel::kDebug));
+
+  WriteConfig(ConfigPath(), "{\"log_default_level\": ");
+  EXPECT_FALSE(ara::log::ReloadConfiguration());
+  EXPECT_TRUE(b.IsEnabled(LogLevel::kVerbose));
+}
+
+TEST(ReloadConfigurationTest, WatchesFile) {
+  ara::log::Logger& a = ara::log::CreateLogger("RLA1", "reload test");
+  WriteConfig(ConfigPath(), MakeConfig("kWarn", "\"RLA1\": \"kVerbose\""));
+  EXPECT_TRUE(WaitFor([&a]() { return a.IsEnabled(LogLevel::kVerbose); }));
+  std::ofstream(ConfigPath()) << MakeConfig("kWarn", "\"RLA1\": \"kOff\"");
+  EXPECT_TRUE(WaitFor([&a]() { return !a.IsEnabled(LogLevel::kFatal); }));
+}
+
+TEST(ConfigWatcherTest, ReportsChanges) {
+  const std::string path = g_directory + "/watched.json";
+  std::ofstream(path) << "1";
+  std::atomic<int> changes{0};
+  ConfigWatcher watcher;
+  ASSERT_TRUE(watcher.Start(path, [&changes]() { ++changes; }));
+  std::ofstream(g_directory + "/other.json") << "other";
+  std::ofstream(path) << "22";
+  EXPECT_TRUE(WaitFor([&changes]() { return changes.load() == 1; }));
+  WriteConfig(path, "333");
+  EXPECT_TRUE(WaitFor([&changes]() { return changes.load() == 2; }));
+  // Gone, nothing to reload.
+  ASSERT_EQ(unlink(path.c_str()), 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_EQ(changes.load(), 2);
+  watcher.Stop();
+  EXPECT_FALSE(watcher.IsRunning());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  char directory[] = "/tmp/reload_test.XXXXXX";
+  if (mkdtemp(directory) == nullptr) {
+    return 1;
+  }
+  g_directory = directory;
+  WriteConfig(ConfigPath(), MakeConfig("kWarn", "\"RLA1\": \"kDebug\""));
+  (void)setenv("AP_LOG_CONFIG_FILE", ConfigPath().c_str(), 1);
+  (void)ara::log::Initialize();
+  return RUN_ALL_TESTS();
+}
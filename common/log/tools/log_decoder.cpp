@@ -0,0 +1,800 @@
+/*
+ * @Description: Offline decoder for DLT storage files (kFile with kBinary, dlt-receive -o). Modeled
+ * messages written with ARA_LOG_MODELED() are rebuilt from the catalog entries in the binaries that
+ * logged them, verbose messages are printed argument by argument. The keys of structured fields,
+ * LogStream::With(), are looked up in the strings of the same binaries; -j prints every message as
+ * one JSON object with the fields as members. A crash ring, /dev/shm/ara-log-<app ID>, is read like
+ * a storage file.
+ *
+ * Usage: ara-log-decoder -c <binary or library> [-c ...] [-l] [-j] [file.dlt | ring ...]
+ *
+ * Copyright (c) 2023 by Tusimple, All Rights Reserved.
+ */
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/* Catalog */
+
+constexpr char kEntryMagic[] = "ARALOG1";
+
+struct CatalogMessage {
+  std::string file;
+  std::string line;
+  std::string format;
+  std::string types;
+};
+
+// Strings of one binary that can be field keys, by their hash.
+struct KeyIndex {
+  std::string binary;
+  std::vector<std::pair<uint32_t, uint32_t>> ids;  // key ID and offset into binary, sorted
+};
+
+struct Catalog {
+  std::map<uint32_t, CatalogMessage> messages;
+  std::vector<KeyIndex> keys;
+
+  // Key of a structured field, "#<key ID>" if no binary has it.
+  std::string Key(uint32_t id) const {
+    for (const KeyIndex& index : keys) {
+      const auto it = std::lower_bound(index.ids.begin(), index.ids.end(), std::make_pair(id, uint32_t{0U}));
+      if (it != index.ids.end() && it->first == id) {
+        return index.binary.c_str() + it->second;
+      }
+    }
+    return fmt::format("#{:08x}", id);
+  }
+};
+
+// Same hash as ara::log::internal::CatalogEntry::Id() and FieldKeyId().
+uint32_t Fnv1a(const char* data, std::size_t size) noexcept {
+  uint32_t hash = 2166136261U;
+  for (std::size_t i = 0U; i < size; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619U;
+  }
+  return hash;
+}
+
+bool ReadField(const std::string& binary, std::size_t& pos, std::string& field) {
+  const std::size_t end = binary.find('\0', pos);
+  if (end == std::string::npos) {
+    return false;
+  }
+  field.assign(binary, pos, end - pos);
+  pos = end + 1U;
+  return true;
+}
+
+// "ARALOG1\0<file>\0<line>\0<format>\0<types>\0", see ara/log/modeled_message.h. Returns the
+// entry size, 0 if the magic at @a pos doesn't start an entry.
+std::size_t ParseEntry(const std::string& binary, std::size_t pos, CatalogMessage& message) {
+  std::size_t next = pos + sizeof(kEntryMagic);
+  if (!ReadField(binary, next, message.file) || !ReadField(binary, next, message.line) ||
+      !ReadField(binary, next, message.format) || !ReadField(binary, next, message.types)) {
+    return 0U;
+  }
+  if (message.file.empty() || message.line.empty() ||
+      message.line.find_first_not_of("0123456789") != std::string::npos ||
+      message.types.find_first_not_of("bchilCHILfds") != std::string::npos) {
+    return 0U;
+  }
+  return next - pos;
+}
+
+constexpr std::size_t kMaxKeySize = 32U;
+
+bool IsKeyStart(char c) noexcept { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+
+bool IsKeyChar(char c) noexcept { return IsKeyStart(c) || (c >= '0' && c <= '9') || c == '.'; }
+
+// Field keys are string literals, NUL terminated identifiers somewhere in the binary. The linker
+// may keep "lat_us" as the tail of "max_lat_us", so the suffixes of each string are indexed too.
+KeyIndex IndexKeys(std::string binary) {
+  KeyIndex index;
+  if (binary.size() > UINT32_MAX) {
+    return index;
+  }
+  std::size_t start = 0U;
+  for (std::size_t pos = 0U; pos < binary.size(); ++pos) {
+    const char c = binary[pos];
+    if (c != '\0') {
+      if (!IsKeyChar(c)) {
+        start = pos + 1U;
+      }
+      continue;
+    }
+    for (std::size_t from = pos - std::min(pos - start, kMaxKeySize); from < pos; ++from) {
+      if (IsKeyStart(binary[from])) {
+        index.ids.emplace_back(Fnv1a(binary.data() + from, pos - from), static_cast<uint32_t>(from));
+      }
+    }
+    start = pos + 1U;
+  }
+  std::sort(index.ids.begin(), index.ids.end());
+  index.binary = std::move(binary);
+  return index;
+}
+
+// Entries are plain constants in the binary, wherever the linker put them.
+bool LoadCatalog(const std::string& path, Catalog& catalog) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    std::cerr << "cannot open " << path << '\n';
+    return false;
+  }
+  std::string binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  const std::string magic(kEntryMagic, sizeof(kEntryMagic));
+  std::size_t found = 0U;
+  for (std::size_t pos = binary.find(magic); pos != std::string::npos; pos = binary.find(magic, pos + 1U)) {
+    CatalogMessage message;
+    const std::size_t size = ParseEntry(binary, pos, message);
+    if (size == 0U) {
+      continue;
+    }
+    const uint32_t id = Fnv1a(binary.data() + pos, size);
+    const auto inserted = catalog.messages.emplace(id, message);
+    const CatalogMessage& known = inserted.first->second;
+    if (!inserted.second && (known.format != message.format || known.types != message.types)) {
+      std::cerr << fmt::format("message id 0x{:08x} of {}:{} collides with {}:{}\n", id, message.file, message.line,
+                               known.file, known.line);
+    }
+    ++found;
+  }
+  if (found == 0U) {
+    std::cerr << "no modeled messages in " << path << '\n';
+  }
+  catalog.keys.push_back(IndexKeys(std::move(binary)));
+  return true;
+}
+
+/* DLT messages */
+
+class PayloadReader final {
+ public:
+  PayloadReader(const uint8_t* data, std::size_t size, bool bigEndian) noexcept
+      : data_(data), size_(size), bigEndian_(bigEndian) {}
+
+  bool ReadUnsigned(std::size_t bytes, uint64_t& value) noexcept {
+    if (bytes > sizeof(value) || size_ - pos_ < bytes) {
+      return false;
+    }
+    value = 0U;
+    for (std::size_t i = 0U; i < bytes; ++i) {
+      const std::size_t shift = 8U * (bigEndian_ ? (bytes - 1U - i) : i);
+      value |= static_cast<uint64_t>(data_[pos_ + i]) << shift;
+    }
+    pos_ += bytes;
+    return true;
+  }
+
+  bool ReadSigned(std::size_t bytes, int64_t& value) noexcept {
+    uint64_t raw = 0U;
+    if (!ReadUnsigned(bytes, raw)) {
+      return false;
+    }
+    if (bytes < sizeof(raw) && (raw & (uint64_t{1} << (8U * bytes - 1U))) != 0U) {
+      raw |= ~uint64_t{0} << (8U * bytes);
+    }
+    value = static_cast<int64_t>(raw);
+    return true;
+  }
+
+  bool ReadFloat(std::size_t bytes, double& value) noexcept {
+    uint64_t raw = 0U;
+    if ((bytes != sizeof(float) && bytes != sizeof(double)) || !ReadUnsigned(bytes, raw)) {
+      return false;
+    }
+    if (bytes == sizeof(float)) {
+      const uint32_t bits = static_cast<uint32_t>(raw);
+      float f = 0.0F;
+      std::memcpy(&f, &bits, sizeof(f));
+      value = f;
+    } else {
+      std::memcpy(&value, &raw, sizeof(value));
+    }
+    return true;
+  }
+
+  // uint16 length followed by the bytes, strings include their NUL.
+  bool ReadSized(std::string& value, bool isString) {
+    uint64_t length = 0U;
+    if (!ReadUnsigned(2U, length)) {
+      return false;
+    }
+    return isString ? ReadText(static_cast<std::size_t>(length), value)
+                    : ReadBytes(static_cast<std::size_t>(length), value);
+  }
+
+  bool ReadBytes(std::size_t length, std::string& value) {
+    if (size_ - pos_ < length) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char*>(data_ + pos_), length);
+    pos_ += length;
+    return true;
+  }
+
+  // @a length bytes, up to the first NUL.
+  bool ReadText(std::size_t length, std::string& value) {
+    if (size_ - pos_ < length) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char*>(data_ + pos_), length);
+    value.resize(std::strlen(value.c_str()));
+    pos_ += length;
+    return true;
+  }
+
+  bool BigEndian() const noexcept { return bigEndian_; }
+
+  std::string RemainingHex() const {
+    std::string hex;
+    for (std::size_t i = pos_; i < size_; ++i) {
+      hex += fmt::format("{}{:02x}", hex.empty() ? "" : " ", data_[i]);
+    }
+    return hex;
+  }
+
+ private:
+  const uint8_t* data_;
+  std::size_t size_;
+  std::size_t pos_{0U};
+  bool bigEndian_;
+};
+
+std::size_t IntegerSize(char code) noexcept {
+  switch (code) {
+    case 'b':
+    case 'c':
+    case 'C':
+      return 1U;
+    case 'h':
+    case 'H':
+      return 2U;
+    case 'i':
+    case 'I':
+    case 'f':
+      return 4U;
+    default:
+      return 8U;
+  }
+}
+
+std::string DecodeModeled(const Catalog& catalog, PayloadReader& payload) {
+  uint64_t id = 0U;
+  if (!payload.ReadUnsigned(4U, id)) {
+    return "[non-verbose message without message id]";
+  }
+  const auto it = catalog.messages.find(static_cast<uint32_t>(id));
+  if (it == catalog.messages.end()) {
+    return fmt::format("[message id 0x{:08x} not in catalog] {}", id, payload.RemainingHex());
+  }
+  const CatalogMessage& message = it->second;
+  fmt::dynamic_format_arg_store<fmt::format_context> args;
+  for (const char code : message.types) {
+    bool ok = false;
+    switch (code) {
+      case 'b': {
+        uint64_t value = 0U;
+        ok = payload.ReadUnsigned(1U, value);
+        args.push_back(value != 0U);
+        break;
+      }
+      case 'c':
+      case 'h':
+      case 'i':
+      case 'l': {
+        int64_t value = 0;
+        ok = payload.ReadSigned(IntegerSize(code), value);
+        args.push_back(value);
+        break;
+      }
+      case 'C':
+      case 'H':
+      case 'I':
+      case 'L': {
+        uint64_t value = 0U;
+        ok = payload.ReadUnsigned(IntegerSize(code), value);
+        args.push_back(value);
+        break;
+      }
+      case 'f':
+      case 'd': {
+        double value = 0.0;
+        ok = payload.ReadFloat(IntegerSize(code), value);
+        args.push_back(value);
+        break;
+      }
+      default: {
+        std::string value;
+        ok = payload.ReadSized(value, true);
+        args.push_back(value);
+        break;
+      }
+    }
+    if (!ok) {
+      return fmt::format("{} [truncated arguments, {}:{}]", message.format, message.file, message.line);
+    }
+  }
+  try {
+    return fmt::vformat(message.format, args);
+  } catch (const fmt::format_error& error) {
+    return fmt::format("{} [{}, {}:{}]", message.format, error.what(), message.file, message.line);
+  }
+}
+
+/* Type info of verbose arguments, DLT protocol 7.7.7.1 */
+constexpr uint32_t kTypeLength = 0x0000000FU;
+constexpr uint32_t kTypeBool = 0x00000010U;
+constexpr uint32_t kTypeSigned = 0x00000020U;
+constexpr uint32_t kTypeUnsigned = 0x00000040U;
+constexpr uint32_t kTypeFloat = 0x00000080U;
+constexpr uint32_t kTypeString = 0x00000200U;
+constexpr uint32_t kTypeRaw = 0x00000400U;
+constexpr uint32_t kTypeVariableInfo = 0x00000800U;
+constexpr uint32_t kTypeCoding = 0x00038000U;
+constexpr uint32_t kCodingHex = 0x00010000U;
+constexpr uint32_t kCodingBin = 0x00018000U;
+
+/* Structured fields, see ara/log/log_field.h */
+constexpr uint8_t kFieldTag = 0xA5U;
+constexpr std::size_t kFieldHeaderSize = 6U;
+
+struct Field {
+  std::string key;
+  std::string text;  // value in text lines
+  std::string json;  // value in JSON objects
+};
+
+std::string JsonString(const std::string& text) {
+  std::string json = "\"";
+  for (const char c : text) {
+    switch (c) {
+      case '"':
+        json += "\\\"";
+        break;
+      case '\\':
+        json += "\\\\";
+        break;
+      case '\n':
+        json += "\\n";
+        break;
+      case '\t':
+        json += "\\t";
+        break;
+      default:
+        if (static_cast<uint8_t>(c) < 0x20U) {
+          json += fmt::format("\\u{:04x}", static_cast<unsigned>(c));
+        } else {
+          json += c;
+        }
+        break;
+    }
+  }
+  return json + "\"";
+}
+
+// Tag, type code, key ID and the value, all in the byte order of the logging host. Raw arguments
+// that don't have this form exactly are ordinary raw data.
+bool DecodeField(const Catalog& catalog, const std::string& raw, bool bigEndian, Field& field) {
+  if (raw.size() < kFieldHeaderSize || static_cast<uint8_t>(raw[0]) != kFieldTag) {
+    return false;
+  }
+  const char code = raw[1];
+  const std::size_t size = raw.size() - kFieldHeaderSize;
+  if (std::string("bchilCHILfds").find(code) == std::string::npos || (code != 's' && size != IntegerSize(code))) {
+    return false;
+  }
+  PayloadReader value(reinterpret_cast<const uint8_t*>(raw.data()) + 2U, raw.size() - 2U, bigEndian);
+  uint64_t id = 0U;
+  (void)value.ReadUnsigned(4U, id);
+  field.key = catalog.Key(static_cast<uint32_t>(id));
+  switch (code) {
+    case 'b': {
+      uint64_t flag = 0U;
+      (void)value.ReadUnsigned(1U, flag);
+      field.text = flag != 0U ? "true" : "false";
+      break;
+    }
+    case 'c':
+    case 'h':
+    case 'i':
+    case 'l': {
+      int64_t number = 0;
+      (void)value.ReadSigned(size, number);
+      field.text = fmt::format("{}", number);
+      break;
+    }
+    case 'C':
+    case 'H':
+    case 'I':
+    case 'L': {
+      uint64_t number = 0U;
+      (void)value.ReadUnsigned(size, number);
+      field.text = fmt::format("{}", number);
+      break;
+    }
+    case 'f':
+    case 'd': {
+      double number = 0.0;
+      (void)value.ReadFloat(size, number);
+      // Shortest text that reads back as the logged float, not as its double.
+      field.text = code == 'f' ? fmt::format("{}", static_cast<float>(number)) : fmt::format("{}", number);
+      field.json = std::isfinite(number) ? field.text : "null";
+      return true;
+    }
+    default:
+      field.text = raw.substr(kFieldHeaderSize);
+      field.json = JsonString(field.text);
+      return true;
+  }
+  field.json = field.text;
+  return true;
+}
+
+// One argument as @a text, or a structured field appended to @a fields.
+bool DecodeVerboseArgument(const Catalog& catalog, PayloadReader& payload, std::string& text,
+                           std::vector<Field>& fields) {
+  uint64_t typeInfo = 0U;
+  if (!payload.ReadUnsigned(4U, typeInfo)) {
+    return false;
+  }
+  const uint32_t type = static_cast<uint32_t>(typeInfo);
+  const std::size_t bytes = (type & kTypeLength) == 0U ? 0U : (std::size_t{1} << ((type & kTypeLength) - 1U));
+  const bool numeric = (type & (kTypeSigned | kTypeUnsigned | kTypeFloat)) != 0U;
+  const bool sized = (type & (kTypeString | kTypeRaw)) != 0U;
+
+  // Strings and raw data start with their length, then comes the variable info.
+  uint64_t length = 0U;
+  if (sized && !payload.ReadUnsigned(2U, length)) {
+    return false;
+  }
+  std::string name;
+  std::string unit;
+  if ((type & kTypeVariableInfo) != 0U) {
+    // Both lengths come first, then the texts. Only numbers have a unit.
+    uint64_t nameLength = 0U;
+    uint64_t unitLength = 0U;
+    if (!payload.ReadUnsigned(2U, nameLength) || (numeric && !payload.ReadUnsigned(2U, unitLength)) ||
+        !payload.ReadText(static_cast<std::size_t>(nameLength), name) ||
+        !payload.ReadText(static_cast<std::size_t>(unitLength), unit)) {
+      return false;
+    }
+  }
+
+  std::string value;
+  if ((type & kTypeBool) != 0U) {
+    uint64_t raw = 0U;
+    if (!payload.ReadUnsigned(1U, raw)) {
+      return false;
+    }
+    value = raw != 0U ? "true" : "false";
+  } else if ((type & kTypeSigned) != 0U) {
+    int64_t raw = 0;
+    if (!payload.ReadSigned(bytes, raw)) {
+      return false;
+    }
+    value = fmt::format("{}", raw);
+  } else if ((type & kTypeUnsigned) != 0U) {
+    uint64_t raw = 0U;
+    if (!payload.ReadUnsigned(bytes, raw)) {
+      return false;
+    }
+    if ((type & kTypeCoding) == kCodingHex) {
+      value = fmt::format("0x{:0{}x}", raw, 2U * bytes);
+    } else if ((type & kTypeCoding) == kCodingBin) {
+      value = fmt::format("0b{:0{}b}", raw, 8U * bytes);
+    } else {
+      value = fmt::format("{}", raw);
+    }
+  } else if ((type & kTypeFloat) != 0U) {
+    double raw = 0.0;
+    if (!payload.ReadFloat(bytes, raw)) {
+      return false;
+    }
+    value = fmt::format("{}", raw);
+  } else if ((type & kTypeString) != 0U) {
+    if (!payload.ReadText(static_cast<std::size_t>(length), value)) {
+      return false;
+    }
+  } else if ((type & kTypeRaw) != 0U) {
+    std::string raw;
+    if (!payload.ReadBytes(static_cast<std::size_t>(length), raw)) {
+      return false;
+    }
+    Field field;
+    if (name.empty() && DecodeField(catalog, raw, payload.BigEndian(), field)) {
+      fields.push_back(std::move(field));
+      return true;
+    }
+    for (const char c : raw) {
+      value += fmt::format("{}{:02x}", value.empty() ? "" : "'", static_cast<uint8_t>(c));
+    }
+  } else {
+    // Arrays, structs, fixed point and trace info aren't written by ara::log.
+    return false;
+  }
+  text = name.empty() ? value : name + ":" + value;
+  if (!unit.empty()) {
+    text += " " + unit;
+  }
+  return true;
+}
+
+std::string DecodeVerbose(const Catalog& catalog, PayloadReader& payload, uint8_t argumentCount,
+                          std::vector<Field>& fields) {
+  std::string text;
+  bool first = true;
+  for (uint8_t i = 0U; i < argumentCount; ++i) {
+    std::string argument;
+    const std::size_t fieldCount = fields.size();
+    if (!DecodeVerboseArgument(catalog, payload, argument, fields)) {
+      return text + (first ? "" : " ") + "[undecodable] " + payload.RemainingHex();
+    }
+    if (fields.size() == fieldCount) {
+      text += (first ? "" : " ") + argument;
+      first = false;
+    }
+  }
+  return text;
+}
+
+/* Storage file, DLT protocol 7.7.5 */
+constexpr uint8_t kStorageMagic[] = {'D', 'L', 'T', 0x01U};
+constexpr std::size_t kStorageHeaderSize = 16U;
+constexpr std::size_t kStandardHeaderSize = 4U;
+constexpr std::size_t kExtendedHeaderSize = 10U;
+constexpr uint8_t kUseExtendedHeader = 0x01U;
+constexpr uint8_t kMostSignificantByteFirst = 0x02U;
+constexpr uint8_t kWithEcuId = 0x04U;
+constexpr uint8_t kWithSessionId = 0x08U;
+constexpr uint8_t kWithTimestamp = 0x10U;
+constexpr uint8_t kVerbose = 0x01U;
+
+const char* LevelName(uint8_t messageInfo) noexcept {
+  static const char* const kNames[] = {"-", "fatal", "error", "warn", "info", "debug", "verbose"};
+  const uint8_t level = static_cast<uint8_t>(messageInfo >> 4U);
+  return level < sizeof(kNames) / sizeof(kNames[0]) ? kNames[level] : "-";
+}
+
+uint32_t BigEndian32(const uint8_t* data) noexcept {
+  return (static_cast<uint32_t>(data[0]) << 24U) | (static_cast<uint32_t>(data[1]) << 16U) |
+         (static_cast<uint32_t>(data[2]) << 8U) | static_cast<uint32_t>(data[3]);
+}
+
+uint32_t LittleEndian32(const uint8_t* data) noexcept {
+  return (static_cast<uint32_t>(data[3]) << 24U) | (static_cast<uint32_t>(data[2]) << 16U) |
+         (static_cast<uint32_t>(data[1]) << 8U) | static_cast<uint32_t>(data[0]);
+}
+
+std::string Id4(const uint8_t* data) {
+  std::string id(reinterpret_cast<const char*>(data), 4U);
+  id.resize(std::strlen(id.c_str()));
+  return id.empty() ? "----" : id;
+}
+
+// Prints one message, as text line or JSON object, returns false if the record is malformed.
+bool DecodeMessage(const Catalog& catalog, bool json, const uint8_t* record, std::size_t size) {
+  const uint8_t* const standard = record + kStorageHeaderSize;
+  const uint8_t headerType = standard[0];
+  const std::size_t length = (static_cast<std::size_t>(standard[2]) << 8U) | standard[3];
+  std::size_t extras = ((headerType & kWithEcuId) != 0U ? 4U : 0U) + ((headerType & kWithSessionId) != 0U ? 4U : 0U) +
+                       ((headerType & kWithTimestamp) != 0U ? 4U : 0U);
+  const std::size_t headers =
+      kStandardHeaderSize + extras + ((headerType & kUseExtendedHeader) != 0U ? kExtendedHeaderSize : 0U);
+  if (length < headers || kStorageHeaderSize + length > size) {
+    return false;
+  }
+  const uint8_t* cursor = standard + kStandardHeaderSize;
+  std::string ecu = Id4(record + 12U);
+  if ((headerType & kWithEcuId) != 0U) {
+    ecu = Id4(cursor);
+    cursor += 4U;
+  }
+  if ((headerType & kWithSessionId) != 0U) {
+    cursor += 4U;
+  }
+  std::string timestamp = "-";
+  if ((headerType & kWithTimestamp) != 0U) {
+    const uint32_t ticks = BigEndian32(cursor);  // 0.1 ms
+    timestamp = fmt::format("{}.{:04}", ticks / 10000U, ticks % 10000U);
+    cursor += 4U;
+  }
+  uint8_t messageInfo = 0U;
+  uint8_t argumentCount = 0U;
+  std::string app = "----";
+  std::string context = "----";
+  if ((headerType & kUseExtendedHeader) != 0U) {
+    messageInfo = cursor[0];
+    argumentCount = cursor[1];
+    app = Id4(cursor + 2U);
+    context = Id4(cursor + 6U);
+    cursor += kExtendedHeaderSize;
+    if (((messageInfo >> 1U) & 0x07U) != 0U) {
+      return true;  // traces and control messages
+    }
+  }
+
+  const time_t seconds = static_cast<time_t>(LittleEndian32(record + 4U));
+  const uint32_t micros = LittleEndian32(record + 8U);
+  struct tm local {};
+  (void)localtime_r(&seconds, &local);
+  char date[32] = {};
+  (void)std::strftime(date, sizeof(date), "%Y/%m/%d %H:%M:%S", &local);
+
+  PayloadReader payload(cursor, length - headers, (headerType & kMostSignificantByteFirst) != 0U);
+  const bool verbose = (headerType & kUseExtendedHeader) != 0U && (messageInfo & kVerbose) != 0U;
+  std::vector<Field> fields;
+  const std::string text =
+      verbose ? DecodeVerbose(catalog, payload, argumentCount, fields) : DecodeModeled(catalog, payload);
+  std::string line;
+  if (json) {
+    line = fmt::format("{{\"time\":\"{}.{:06}\",\"timestamp\":{},\"ecu\":{},\"app\":{},\"ctx\":{},\"level\":\"{}\","
+                       "\"text\":{},\"fields\":{{",
+                       date, micros, timestamp == "-" ? "null" : timestamp, JsonString(ecu), JsonString(app),
+                       JsonString(context), LevelName(messageInfo), JsonString(text));
+    for (const Field& field : fields) {
+      line += fmt::format("{}{}:{}", &field == &fields.front() ? "" : ",", JsonString(field.key), field.json);
+    }
+    line += "}}";
+  } else {
+    line = fmt::format("{}.{:06} {} {} {} {} {} {}", date, micros, timestamp, ecu, app, context,
+                       LevelName(messageInfo), text);
+    for (const Field& field : fields) {
+      line += fmt::format(" {}={}", field.key, field.text);
+    }
+  }
+  std::cout << line << '\n';
+  return true;
+}
+
+/* Crash ring, see ara/log/crash_ring.h */
+constexpr char kRingMagic[8] = {'A', 'R', 'A', 'R', 'I', 'N', 'G', '1'};
+constexpr std::size_t kRingSlotSize = 64U;
+constexpr std::size_t kRingSlotHeaderSize = 16U;
+constexpr uint32_t kRingCheck = 0x41524C52U;
+
+template <typename T>
+T Native(const uint8_t* data) noexcept {
+  T value{};
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+// The complete records of a ring, oldest first, as a storage file. The ring is in the byte order
+// of the host that wrote it. A live ring is read while written: @a headAfter, its head read again
+// afterwards, drops the records whose slots were taken again meanwhile.
+std::vector<uint8_t> RingRecords(const std::vector<uint8_t>& ring, uint64_t headAfter) {
+  std::vector<uint8_t> records;
+  const uint64_t count = ring.size() >= kRingSlotSize ? Native<uint64_t>(ring.data() + 16U) : 0U;
+  if (count == 0U || (count & (count - 1U)) != 0U || Native<uint32_t>(ring.data() + 8U) != kRingSlotSize ||
+      count > ring.size() / kRingSlotSize - 1U) {
+    std::cerr << "not a crash ring of this host\n";
+    return records;
+  }
+  const uint8_t* const slots = ring.data() + kRingSlotSize;
+  const std::size_t mask = static_cast<std::size_t>(count) * kRingSlotSize - 1U;
+  const uint64_t head = Native<uint64_t>(ring.data() + 24U);
+  for (uint64_t index = head > count ? head - count : 0U; index < head;) {
+    const std::size_t pos = static_cast<std::size_t>(index & (count - 1U)) * kRingSlotSize;
+    const uint32_t size = Native<uint32_t>(slots + pos + 8U);
+    const uint64_t used = (kRingSlotHeaderSize + size + kRingSlotSize - 1U) / kRingSlotSize;
+    const uint32_t check = static_cast<uint32_t>(index) ^ static_cast<uint32_t>(index >> 32U) ^ size ^ kRingCheck;
+    if (Native<uint64_t>(slots + pos) != index || Native<uint32_t>(slots + pos + 12U) != check ||
+        used > count / 4U || index + used > head || headAfter > index + count) {
+      ++index;  // overwritten or not complete
+      continue;
+    }
+    for (std::size_t i = 0U; i < size; ++i) {
+      records.push_back(slots[(pos + kRingSlotHeaderSize + i) & mask]);
+    }
+    index += used;
+  }
+  return records;
+}
+
+bool DecodeFile(const Catalog& catalog, bool json, std::istream& in) {
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  if (data.size() >= sizeof(kRingMagic) && std::memcmp(data.data(), kRingMagic, sizeof(kRingMagic)) == 0) {
+    // Read again unless it's a pipe.
+    uint64_t headAfter = data.size() >= 32U ? Native<uint64_t>(data.data() + 24U) : 0U;
+    uint8_t head[sizeof(uint64_t)] = {};
+    in.clear();
+    if (in.seekg(24) && in.read(reinterpret_cast<char*>(head), sizeof(head))) {
+      headAfter = Native<uint64_t>(head);
+    }
+    data = RingRecords(data, headAfter);
+  }
+  std::size_t pos = 0U;
+  std::size_t skipped = 0U;
+  while (pos + kStorageHeaderSize + kStandardHeaderSize <= data.size()) {
+    const uint8_t* const record = data.data() + pos;
+    if (std::memcmp(record, kStorageMagic, sizeof(kStorageMagic)) != 0 ||
+        !DecodeMessage(catalog, json, record, data.size() - pos)) {
+      ++pos;  // resynchronize on the next storage header
+      ++skipped;
+      continue;
+    }
+    const std::size_t length = (static_cast<std::size_t>(record[kStorageHeaderSize + 2U]) << 8U) |
+                               record[kStorageHeaderSize + 3U];
+    pos += kStorageHeaderSize + length;
+  }
+  if (skipped != 0U) {
+    std::cerr << "skipped " << skipped << " bytes that are not DLT storage records\n";
+  }
+  return skipped == 0U;
+}
+
+void Usage(const char* program) {
+  std::cerr << "Usage: " << program << " -c <binary> [-c <binary> ...] [-l] [-j] [file.dlt ...]\n"
+            << "  -c  executable or shared library with ARA_LOG_MODELED() messages or With() fields\n"
+            << "  -l  print the message catalog and exit\n"
+            << "  -j  print JSON lines, one object per message with its fields\n"
+            << "  Reads DLT storage files and crash rings (/dev/shm/ara-log-<app ID>), or stdin if no file is given.\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Catalog catalog;
+  bool list = false;
+  bool json = false;
+  std::vector<std::string> inputs;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "-c" && i + 1 < argc) {
+      if (!LoadCatalog(argv[++i], catalog)) {
+        return 1;
+      }
+    } else if (arg == "-l") {
+      list = true;
+    } else if (arg == "-j") {
+      json = true;
+    } else if (arg == "-h" || arg == "--help" || (arg.size() > 1U && arg[0] == '-')) {
+      Usage(argv[0]);
+      return arg == "-h" || arg == "--help" ? 0 : 1;
+    } else {
+      inputs.push_back(arg);
+    }
+  }
+
+  if (list) {
+    for (const auto& entry : catalog.messages) {
+      std::cout << fmt::format("0x{:08x} {}:{} [{}] {}\n", entry.first, entry.second.file, entry.second.line,
+                               entry.second.types, entry.second.format);
+    }
+    return 0;
+  }
+
+  bool ok = true;
+  if (inputs.empty()) {
+    ok = DecodeFile(catalog, json, std::cin);
+  }
+  for (const std::string& input : inputs) {
+    std::ifstream file(input, std::ios::binary);
+    if (!file) {
+      std::cerr << "cannot open " << input << '\n';
+      ok = false;
+      continue;
+    }
+    ok = DecodeFile(catalog, json, file) && ok;
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,33 @@
+#!/bin/sh
+# Decode a DLT storage file with a named string argument, as written by
+# dlt_user_log_write_string_attr() (Argument<String>): type info, length,
+# name length, name, then the string.
+#
+# usage: decoder_test.sh <ara-log-decoder>
+
+set -eu
+
+DECODER=${1:-ara-log-decoder}
+DLT=$(mktemp)
+trap 'rm -f "$DLT"' EXIT
+
+# storage header, standard header with ECU ID and timestamp, extended header
+# (verbose, log info, 2 arguments), little endian payload
+printf 'DLT\001\000\000\000\000\000\000\000\000ECU1' > "$DLT"
+printf '\025\000\000\065ECU1\000\000\000\000\101\002APP1CTX1' >> "$DLT"
+# "path" = "hello", then an unnamed "world"
+printf '\000\012\000\000\006\000\005\000path\000hello\000' >> "$DLT"
+printf '\000\002\000\000\006\000world\000' >> "$DLT"
+
+status=0
+text=$("$DECODER" "$DLT")
+case "$text" in
+  *" path:hello world") ;;
+  *) echo "unexpected text output: $text" >&2; status=1 ;;
+esac
+json=$("$DECODER" -j "$DLT")
+case "$json" in
+  *'path:hello world'*) ;;
+  *) echo "unexpected JSON output: $json" >&2; status=1 ;;
+esac
+exit $status
@@ -91,53 +91,53 @@ class Connection::pImpl : public std::enable_shared_from_this<pImpl> {
   //   }
   // };
 
-  void write(std::unique_ptr<promise_type<std::size_t>>&& p, const void* data,
+  void write(promise_type<std::size_t>&& p, const void* data,
              std::size_t size) {
     boost::asio::async_write(
         socket_, boost::asio::const_buffer(data, size),
         boost::asio::transfer_exactly(size),
         [p1 = std::move(p)](const boost::system::error_code& ec,
-                            std::size_t t) {
+                            std::size_t t) mutable {
           if (!ec) {
             logger.LogVerbose() << "connection write message. size:" << t;
-            p1->set_value(t);
+            p1.set_value(t);
           } else {
-            p1->SetError(static_cast<ara::core::CoreErrc>(ec.value()));
+            p1.SetError(static_cast<ara::core::CoreErrc>(ec.value()));
             logger.LogWarn() << ec.message();
           }
         });
   }
 
-  void write(std::unique_ptr<promise_type<std::size_t>>&& p,
+  void write(promise_type<std::size_t>&& p,
              SocketBufferType& data) {
     write(std::move(p), data.Data(), data.Size());
   }
 
-  void write(std::unique_ptr<promise_type<std::size_t>>&& p,
+  void write(promise_type<std::size_t>&& p,
              SocketBufferType&& data) {
     auto r_data = std::move(data);
     write(std::move(p), r_data);
   }
 
-  void read(std::unique_ptr<promise_type<std::size_t>>&& p, void* data,
+  void read(promise_type<std::size_t>&& p, void* data,
             std::size_t size) {
     boost::asio::async_read(
         socket_, boost::asio::buffer(data, size),
         boost::asio::transfer_exactly(size),
         [&data, size, p1 = std::move(p)](const boost::system::error_code& ec,
-                                         std::size_t length) {
+                                         std::size_t length) mutable {
           if (!ec) {
             logger.LogVerbose()
                 << "connection read message(void*). size:" << size;
-            p1->set_value(size);
+            p1.set_value(size);
           } else {
-            p1->SetError(static_cast<ara::core::CoreErrc>(ec.value()));
+            p1.SetError(static_cast<ara::core::CoreErrc>(ec.value()));
             logger.LogWarn() << ec.message();
           }
         });
   }
 
-  void read(std::unique_ptr<promise_type<SocketBufferType>>&& p,
+  void read(promise_type<SocketBufferType>&& p,
             std::size_t size) {
     auto data_ptr = std::make_shared<SocketBufferType>(make_buffer(size));
     boost::asio::async_read(
@@ -149,43 +149,43 @@ class Connection::pImpl : public std::enable_shared_from_this<pImpl> {
                                       std::size_t length) mutable {
           if (!ec) {
             logger.LogVerbose() << "connection read message. size:" << length;
-            p1->set_value(std::move(*data_ptr));
+            p1.set_value(std::move(*data_ptr));
           } else {
-            p1->SetError(static_cast<ara::core::CoreErrc>(ec.value()));
+            p1.SetError(static_cast<ara::core::CoreErrc>(ec.value()));
             logger.LogWarn() << ec.message();
           }
         });
   }
 
-  void readsome(std::unique_ptr<promise_type<std::size_t>>&& p, void* data,
+  void readsome(promise_type<std::size_t>&& p, void* data,
                 std::size_t max_size) {
     socket_.async_read_some(
         boost::asio::buffer(data, max_size),
         [p1 = std::move(p)](const boost::system::error_code& ec,
-                            std::size_t t) {
+                            std::size_t t) mutable {
           if (!ec) {
             logger.LogVerbose()
                 << "connection readsome message(void*). size:" << t;
-            p1->set_value(t);
+            p1.set_value(t);
           } else {
-            p1->SetError(static_cast<ara::core::CoreErrc>(ec.value()));
+            p1.SetError(static_cast<ara::core::CoreErrc>(ec.value()));
             logger.LogWarn() << ec.message();
           }
         });
   }
 
-  void readsome(std::unique_ptr<promise_type<SocketBufferType>>&& p) {
+  void readsome(promise_type<SocketBufferType>&& p) {
     socket_.async_read_some(
         boost::asio::buffer(static_cast<void*>(data_.Data()), data_.Size()),
         [this, p1 = std::move(p)](const boost::system::error_code& ec,
-                                  std::size_t t) {
+                                  std::size_t t) mutable {
           if (!ec) {
             auto data = make_buffer(t);
             data.CopyFrom(data_.Data());
             logger.LogVerbose() << "connection readsome message. size:" << t;
-            p1->set_value(std::move(data));
+            p1.set_value(std::move(data));
           } else {
-            p1->SetError(static_cast<ara::core::CoreErrc>(ec.value()));
+            p1.SetError(static_cast<ara::core::CoreErrc>(ec.value()));
             logger.LogWarn() << ec.message();
           }
         });
@@ -223,25 +223,22 @@ future_type<std::size_t> Connection::Write(SocketBufferType& data) {
 }
 
 future_type<std::size_t> Connection::Write(SocketBufferType&& data) {
-  auto p_send =
-      std::make_unique<promise_type<std::size_t>>(promise_type<std::size_t>());
-  auto f = p_send->get_future();
+  promise_type<std::size_t> p_send;
+  auto f = p_send.get_future();
   pImpl_->write(std::move(p_send), std::move(data));
   return f;
 }
 
 future_type<std::size_t> Connection::Write(const void* data, std::size_t size) {
-  auto p_send =
-      std::make_unique<promise_type<std::size_t>>(promise_type<std::size_t>());
-  auto f = p_send->get_future();
+  promise_type<std::size_t> p_send;
+  auto f = p_send.get_future();
   pImpl_->write(std::move(p_send), data, size);
   return f;
 }
 
 future_type<SocketBufferType> Connection::Readsome() {
-  auto p_read = std::make_unique<promise_type<SocketBufferType>>(
-      promise_type<SocketBufferType>());
-  auto f = p_read->get_future();
+  promise_type<SocketBufferType> p_read;
+  auto f = p_read.get_future();
   // auto buf = make_buffer(SocketBufferType::max_size);
   pImpl_->readsome(std::move(p_read));
   return f;
@@ -249,25 +246,22 @@ future_type<SocketBufferType> Connection::Readsome() {
 
 future_type<std::size_t> Connection::Readsome(void* data,
                                               std::size_t max_size) {
-  auto p_read =
-      std::make_unique<promise_type<std::size_t>>(promise_type<std::size_t>());
-  auto f = p_read->get_future();
+  promise_type<std::size_t> p_read;
+  auto f = p_read.get_future();
   pImpl_->readsome(std::move(p_read), data, max_size);
   return f;
 }
 
 future_type<SocketBufferType> Connection::Read(std::size_t size) {
-  auto p_read = std::make_unique<promise_type<SocketBufferType>>(
-      promise_type<SocketBufferType>());
-  auto f = p_read->get_future();
+  promise_type<SocketBufferType> p_read;
+  auto f = p_read.get_future();
   pImpl_->read(std::move(p_read), size);
   return f;
 }
 
 future_type<std::size_t> Connection::Read(void* data, std::size_t size) {
-  auto p_read =
-      std::make_unique<promise_type<std::size_t>>(promise_type<std::size_t>());
-  auto f = p_read->get_future();
+  promise_type<std::size_t> p_read;
+  auto f = p_read.get_future();
   pImpl_->read(std::move(p_read), data, size);
   return f;
 }
@@ -83,7 +83,8 @@ class SocketUdp::pImpl final : public BaseSocket {
         boost::asio::buffer(static_cast<void*>(data_.Data()), data_.Size()),
         remote_endpoint_,
         [this](boost::system::error_code ec, std::size_t length) {
-          logger.LogVerbose() << "udp receive data. size:" << length;
+          ARA_LOG_EVERY_MS(logger.ap_logger(), ara::log::LogLevel::kVerbose, 1000)
+              << "udp receive data. size:" << length;
           if (!ec) {
             auto data = make_buffer(length);
             data.CopyFrom(data_.Data());
@@ -91,7 +92,8 @@ class SocketUdp::pImpl final : public BaseSocket {
                   remote_endpoint_.port());
             do_receive();
           } else {
-            logger.LogWarn() << ec.message();
+            ARA_LOG_EVERY_MS(logger.ap_logger(), ara::log::LogLevel::kWarn, 1000)
+                << ec.message();
           }
         });
   }
@@ -123,7 +125,7 @@ class SocketUdp::pImpl final : public BaseSocket {
     return GetInterfaceFromName(GetNameFromIp(local_ip_)).broadcast_address;
   }
 
-  void SendTo(std::unique_ptr<promise_type<std::size_t>>&& p,
+  void SendTo(promise_type<std::size_t>&& p,
               const std::string& ip, const std::uint32_t& port,
               const void* data, std::size_t size) {
     try {
@@ -133,13 +135,15 @@ class SocketUdp::pImpl final : public BaseSocket {
           boost::asio::ip::udp::endpoint(boost::asio::ip::make_address(ip),
                                          port),
           [p1 = std::move(p), this](boost::system::error_code ec,
-                                    std::size_t length) {
+                                    std::size_t length) mutable {
             if (!ec) {
-              logger.LogVerbose() << "udp send data. size:" << length;
-              p1->set_value(length);
+              ARA_LOG_EVERY_MS(logger.ap_logger(), ara::log::LogLevel::kVerbose, 1000)
+                  << "udp send data. size:" << length;
+              p1.set_value(length);
             } else {
-              p1->SetError(static_cast<ara::core::CoreErrc>(ec.value()));
-              logger.LogWarn() << ec.message();
+              p1.SetError(static_cast<ara::core::CoreErrc>(ec.value()));
+              ARA_LOG_EVERY_MS(logger.ap_logger(), ara::log::LogLevel::kWarn, 1000)
+                  << ec.message();
             }
           });
     } catch (const std::exception& e) {
@@ -192,9 +196,8 @@ future_type<std::size_t> SocketUdp::SendTo(const std::string& ip,
 future_type<std::size_t> SocketUdp::SendTo(const std::string& ip,
                                            const std::uint32_t& port,
                                            const void* data, std::size_t size) {
-  auto p_send =
-      std::make_unique<promise_type<std::size_t>>(promise_type<std::size_t>());
-  auto f = p_send->get_future();
+  promise_type<std::size_t> p_send;
+  auto f = p_send.get_future();
   pImpl_->SendTo(std::move(p_send), ip, port, data, size);
   return f;
 }
@@ -53,7 +53,7 @@ std::string GetNameFromIp(const std::string& ip) {
     char* p = inet_ntoa(((struct sockaddr_in*)(&ifr.ifr_addr))->sin_addr);
     // strncpy(addr, p, sizeof(addr) - 1);
     // addr[sizeof(addr) - 1] = '\0';
-    if (std::string(p) == ip) {
+    if (ip == p) {
       close(sock);
       return name;
     }
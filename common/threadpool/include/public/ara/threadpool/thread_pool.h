@@ -10,7 +10,6 @@
  */
 #ifndef AEG_ADAPTIVE_AUTOSAR_PUBLIC_ARA_THREADPOOL_THREAD_POOL_H_
 
-#include <condition_variable>
 #include <functional>
 #include <future>
 #include <memory>
@@ -20,6 +19,8 @@
 #include <thread>
 #include <vector>
 
+#include "ara/core/futex_condition_variable.h"
+
 namespace ara {
 namespace threadpool {
 class ThreadPool {
@@ -37,7 +38,7 @@ class ThreadPool {
 
   // synchronization
   std::mutex queue_mutex;
-  std::condition_variable condition;
+  ara::core::FutexConditionVariable condition;
   bool stop;
 };
 
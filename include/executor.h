@@ -11,7 +11,6 @@
 #ifndef UTILITY_EXECUTOR_H
 #define UTILITY_EXECUTOR_H
 
-#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <mutex>
@@ -19,6 +18,8 @@
 #include <thread>
 #include <atomic>
 
+#include "ara/core/futex_condition_variable.h"
+
 namespace utility
 {
 
@@ -94,7 +95,7 @@ namespace utility
         // threading var
         std::thread thread_;
         // conditional variable to block the thread
-        std::condition_variable cond_var_;
+        ara::core::FutexConditionVariable cond_var_;
         // flag to terminate the thread
         std::atomic<bool> exit_request_;
         // flag th start the thread
@@ -11,7 +11,6 @@
 #include <string.h>
 #include <time.h>
 #include <sys/time.h>
-#include <sys/timeb.h>
 
 #ifdef __cplusplus
 
@@ -24,6 +23,7 @@
 #include <stdarg.h>
 #include <string>
 #include <libgen.h>
+#include <type_traits>
 #include <fmt/format.h>
 // #include <ara/log/logger.h>
 
@@ -31,7 +31,7 @@ extern "C"
 {
 #endif /* __cplusplus */
 
-    static uint64_t getTimeStamp()
+    static inline uint64_t getTimeStamp()
     {
         struct timeval time_now;
         gettimeofday(&time_now, NULL);
@@ -39,18 +39,42 @@ extern "C"
         return timestamp;
     }
 
-    static char *log_time(void)
+    /* Wall clock time of a HAL_PRINT, text "YYYY-MM-DD HH:MM:SS.mmm" and microseconds since the epoch. */
+    struct hal_log_clock
     {
-        struct tm *ptm;
-        struct timeb stTimeb;
-        static char szTime[128];
-
-        ftime(&stTimeb);
-        ptm = localtime(&stTimeb.time);
-        sprintf(szTime, "%04d-%02d-%02d %02d:%02d:%02d.%03d",
-                ptm->tm_year + 1900, ptm->tm_mon + 1, ptm->tm_mday, ptm->tm_hour, ptm->tm_min, ptm->tm_sec, stTimeb.millitm);
-        szTime[23] = 0;
-        return szTime;
+        time_t second;
+        char text[24];
+        uint64_t timestamp;
+    };
+
+    /* Reads the clock once. The date and time are formatted once a second per thread, in between
+     * only the milliseconds are patched. The result stays valid until the thread calls again. */
+    static inline const struct hal_log_clock *hal_log_now(void)
+    {
+        static __thread struct hal_log_clock cached = {-1, {0}, 0};
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        if (now.tv_sec != cached.second) {
+            struct tm tm_now;
+            localtime_r(&now.tv_sec, &tm_now);
+            if (strftime(cached.text, sizeof(cached.text), "%Y-%m-%d %H:%M:%S.", &tm_now) != 20) {
+                memcpy(cached.text, "0000-00-00 00:00:00.", 20);
+            }
+            cached.second = now.tv_sec;
+        }
+        const unsigned int millis = (unsigned int)(now.tv_nsec / 1000000);
+        cached.text[20] = (char)('0' + millis / 100);
+        cached.text[21] = (char)('0' + millis / 10 % 10);
+        cached.text[22] = (char)('0' + millis % 10);
+        cached.text[23] = '\0';
+        cached.timestamp = 1000000UL * (uint64_t)now.tv_sec + (uint64_t)now.tv_nsec / 1000;
+        return &cached;
+    }
+
+    /* Per thread buffer, see hal_log_now(). */
+    static inline char *log_time(void)
+    {
+        return (char *)hal_log_now()->text;
     }
 
 #define HAL_TIMESTAMP getTimeStamp
@@ -65,9 +89,11 @@ extern "C"
 #define HAL_LOG_LEVEL_DEBUG (5)
 #define HAL_LOG_LEVEL_VERBOSE (6)
 
-#define HAL_PRINT(level, format, args...)                                                                                                                     \
-    {                                                                                                                                                         \
-        printf("%s [%s] %s:%d <%d> %lu " format "\n", log_time(), log_levels[level], basename((char *)__FILE__), __LINE__, gettid(), getTimeStamp(), ##args); \
+#define HAL_PRINT(level, format, args...)                                                                                              \
+    {                                                                                                                                  \
+        const struct hal_log_clock *hal_log_clock_now = hal_log_now();                                                                 \
+        printf("%s [%s] %s:%d <%d> %lu " format "\n", hal_log_clock_now->text, log_levels[level], basename((char *)__FILE__), __LINE__, \
+               gettid(), hal_log_clock_now->timestamp, ##args);                                                                        \
     }
 
 #ifdef __cplusplus
@@ -75,67 +101,101 @@ extern "C"
     extern void hal_log_init_level(ara::log::LogLevel level);
 
     extern ara::log::Logger *hal_logger;
-#define HAL_LOG_FATAL() \
-    hal_log_init();     \
-    hal_logger->LogFatal() << basename((char *)__FILE__) << __LINE__ << gettid()
-#define HAL_LOG_ERROR() \
-    hal_log_init();     \
-    hal_logger->LogError() << basename((char *)__FILE__) << __LINE__ << gettid()
-#define HAL_LOG_WARN() \
-    hal_log_init();    \
-    hal_logger->LogWarn() << basename((char *)__FILE__) << __LINE__ << gettid()
-#define HAL_LOG_INFO() \
-    hal_log_init();    \
-    hal_logger->LogInfo() << basename((char *)__FILE__) << __LINE__ << gettid()
-#define HAL_LOG_DEBUG() \
-    hal_log_init();     \
-    hal_logger->LogDebug() << basename((char *)__FILE__) << __LINE__ << gettid()
-#define HAL_LOG_VERBOSE() \
-    hal_log_init();       \
-    hal_logger->LogVerbose() << basename((char *)__FILE__) << __LINE__ << gettid()
-
-#define HAL_LOG_FATAL_FMT(format, args...)                                \
-    {                                                                     \
-        fmt::memory_buffer out;                                           \
-        fmt::format_to(std::back_inserter(out), format, ##args);          \
-        HAL_LOG_FATAL() << ara::core::StringView(out.data(), out.size()); \
-    }
 
-#define HAL_LOG_ERROR_FMT(format, args...)                                \
-    {                                                                     \
-        fmt::memory_buffer out;                                           \
-        fmt::format_to(std::back_inserter(out), format, ##args);          \
-        HAL_LOG_ERROR() << ara::core::StringView(out.data(), out.size()); \
-    }
+/* hal_log_init() only until it has set hal_logger. */
+#define HAL_LOG_LOGGER() (hal_logger != NULL ? hal_logger : (hal_log_init(), hal_logger))
 
-#define HAL_LOG_WARN_FMT(format, args...)                                \
-    {                                                                    \
-        fmt::memory_buffer out;                                          \
-        fmt::format_to(std::back_inserter(out), format, ##args);         \
-        HAL_LOG_WARN() << ara::core::StringView(out.data(), out.size()); \
-    }
+/* Compiled out below ARA_LOG_MIN_LEVEL (see ara/log/logger.h), otherwise one cached level check
+ * before anything is formatted or streamed. */
+#define HAL_LOG_ENABLED(level) \
+    ((static_cast<int>(level) <= ARA_LOG_MIN_LEVEL) && HAL_LOG_LOGGER()->IsEnabled(level))
 
-#define HAL_LOG_INFO_FMT(format, args...)                                \
-    {                                                                    \
-        fmt::memory_buffer out;                                          \
-        fmt::format_to(std::back_inserter(out), format, ##args);         \
-        HAL_LOG_INFO() << ara::core::StringView(out.data(), out.size()); \
+    /* Offset of the file name in a source path, evaluated by the compiler for HAL_LOG_FILE. */
+    static constexpr size_t hal_log_basename_offset(const char *path)
+    {
+        size_t offset = 0;
+        for (size_t i = 0; path[i] != '\0'; ++i) {
+            if (path[i] == '/') {
+                offset = i + 1;
+            }
+        }
+        return offset;
     }
 
-#define HAL_LOG_DEBUG_FMT(format, args...)                                \
-    {                                                                     \
-        fmt::memory_buffer out;                                           \
-        fmt::format_to(std::back_inserter(out), format, ##args);          \
-        HAL_LOG_DEBUG() << ara::core::StringView(out.data(), out.size()); \
+#if defined(__FILE_NAME__)
+#define HAL_LOG_FILE __FILE_NAME__
+#else
+#define HAL_LOG_FILE (__FILE__ + std::integral_constant<size_t, hal_log_basename_offset(__FILE__)>::value)
+#endif
+
+/* Prefix of every HAL_LOG_* record: file name, line and thread id (cached per thread). */
+#define HAL_LOG_LOCATION() HAL_LOG_FILE << __LINE__ << ara::log::CurrentThreadId()
+
+#define HAL_LOG_FATAL()                                 \
+    if (!HAL_LOG_ENABLED(ara::log::LogLevel::kFatal)) { \
+    } else                                              \
+        hal_logger->LogFatal() << HAL_LOG_LOCATION()
+#define HAL_LOG_ERROR()                                 \
+    if (!HAL_LOG_ENABLED(ara::log::LogLevel::kError)) { \
+    } else                                              \
+        hal_logger->LogError() << HAL_LOG_LOCATION()
+#define HAL_LOG_WARN()                                 \
+    if (!HAL_LOG_ENABLED(ara::log::LogLevel::kWarn)) { \
+    } else                                             \
+        hal_logger->LogWarn() << HAL_LOG_LOCATION()
+#define HAL_LOG_INFO()                                 \
+    if (!HAL_LOG_ENABLED(ara::log::LogLevel::kInfo)) { \
+    } else                                             \
+        hal_logger->LogInfo() << HAL_LOG_LOCATION()
+#define HAL_LOG_DEBUG()                                 \
+    if (!HAL_LOG_ENABLED(ara::log::LogLevel::kDebug)) { \
+    } else                                              \
+        hal_logger->LogDebug() << HAL_LOG_LOCATION()
+#define HAL_LOG_VERBOSE()                                 \
+    if (!HAL_LOG_ENABLED(ara::log::LogLevel::kVerbose)) { \
+    } else                                                \
+        hal_logger->LogVerbose() << HAL_LOG_LOCATION()
+
+/* Rate limited HAL_LOG_X(), see ARA_LOG_EVERY_N/ARA_LOG_FIRST_N/ARA_LOG_EVERY_MS in ara/log/logger.h.
+ * Usage: HAL_LOG_EVERY_MS(ara::log::LogLevel::kWarn, 1000) << "can bus off"; */
+#define HAL_LOG_EVERY_N(level, n) ARA_LOG_EVERY_N(*HAL_LOG_LOGGER(), level, n) << HAL_LOG_LOCATION()
+#define HAL_LOG_FIRST_N(level, n) ARA_LOG_FIRST_N(*HAL_LOG_LOGGER(), level, n) << HAL_LOG_LOCATION()
+#define HAL_LOG_EVERY_MS(level, ms) ARA_LOG_EVERY_MS(*HAL_LOG_LOGGER(), level, ms) << HAL_LOG_LOCATION()
+
+/* Longest text of a HAL_LOG_*_FMT statement, longer ones are cut and end with "...". */
+#ifndef HAL_LOG_FMT_MAX_SIZE
+#define HAL_LOG_FMT_MAX_SIZE 1024
+#endif
+
+    /* Length of a text fmt::format_to_n() produced into capacity bytes, marks a cut text. */
+    static inline size_t hal_log_fmt_size(size_t formatted, char *text, size_t capacity)
+    {
+        if (formatted <= capacity) {
+            return formatted;
+        }
+        memcpy(text + capacity - 3, "...", 3);
+        return capacity;
     }
 
-#define HAL_LOG_VERBOSE_FMT(format, args...)                                \
-    {                                                                       \
-        fmt::memory_buffer out;                                             \
-        fmt::format_to(std::back_inserter(out), format, ##args);            \
-        HAL_LOG_VERBOSE() << ara::core::StringView(out.data(), out.size()); \
+/* Formats once into a stack buffer that the record copies by length, nothing is allocated. */
+#define HAL_LOG_FMT_(level, stream, format, args...)                                                        \
+    {                                                                                                       \
+        if (HAL_LOG_ENABLED(level)) {                                                                       \
+            char hal_log_text[HAL_LOG_FMT_MAX_SIZE];                                                        \
+            const size_t hal_log_size = hal_log_fmt_size(                                                   \
+                fmt::format_to_n(hal_log_text, sizeof(hal_log_text), format, ##args).size, hal_log_text,    \
+                sizeof(hal_log_text));                                                                      \
+            stream() << ara::core::StringView(hal_log_text, hal_log_size);                                  \
+        }                                                                                                   \
     }
 
+#define HAL_LOG_FATAL_FMT(format, args...) HAL_LOG_FMT_(ara::log::LogLevel::kFatal, HAL_LOG_FATAL, format, ##args)
+#define HAL_LOG_ERROR_FMT(format, args...) HAL_LOG_FMT_(ara::log::LogLevel::kError, HAL_LOG_ERROR, format, ##args)
+#define HAL_LOG_WARN_FMT(format, args...) HAL_LOG_FMT_(ara::log::LogLevel::kWarn, HAL_LOG_WARN, format, ##args)
+#define HAL_LOG_INFO_FMT(format, args...) HAL_LOG_FMT_(ara::log::LogLevel::kInfo, HAL_LOG_INFO, format, ##args)
+#define HAL_LOG_DEBUG_FMT(format, args...) HAL_LOG_FMT_(ara::log::LogLevel::kDebug, HAL_LOG_DEBUG, format, ##args)
+#define HAL_LOG_VERBOSE_FMT(format, args...) HAL_LOG_FMT_(ara::log::LogLevel::kVerbose, HAL_LOG_VERBOSE, format, ##args)
+
 #endif /* __cplusplus */
 
 #define HAL_PRINT_FATAL(format, args...)                \
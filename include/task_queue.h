@@ -6,7 +6,7 @@
 
 #include <memory>
 #include <mutex>
-#include <condition_variable>
+#include "ara/core/futex_condition_variable.h"
 
 #include <list>
 #include <deque>
@@ -384,7 +384,7 @@ private:
     struct Condition
     {
         std::mutex mutexCond;
-        std::condition_variable condVar;
+        ara::core::FutexConditionVariable condVar;
         bool isRouse;
     };
     Condition _condi;
@@ -455,6 +455,6 @@ public:
 private:
     std::deque<T> _bufferQ;
     std::mutex _mutexB;
-    std::condition_variable _condB;
+    ara::core::FutexConditionVariable _condB;
     int _size = 0;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "ara/log/logger.h"
 #include <atomic>
 
+#include "ara/core/static_string.h"
 #include "ara/core/string.h"
 #include "ara/log/logmanager.h"
 #include <nlohmann/json.hpp>
@@ -27,7 +28,7 @@ namespace ara
                  const LogLevel ctxDefLogLevel) noexcept
                 : parent(logger_parent), isRegistered_(false)
             {
-                const ara::core::String id(ctxId.data(), ctxId.size());
+                const ara::core::StaticString<DLT_ID_SIZE> id(ctxId);
                 const ara::core::String desc(ctxDescription.data(), ctxDescription.size());
 
                 DltReturnValue ret = dlt_register_context_ll_ts_use_default_level(
@@ -36,7 +37,7 @@ namespace ara
 
                 if (ret < DltReturnValue::DLT_RETURN_OK)
                 {
-                    const std::string err_msg = "logging: unable to register context [" + id +
+                    const std::string err_msg = "logging: unable to register context [" + id.ToString() +
                                                 "] to DLT back-end. Error-code: " + std::to_string(static_cast<int8_t>(ret));
                     DltContextData log_local;
                     DltReturnValue dlt_local = dlt_user_log_write_start(dltContext_.get(), &log_local, DLT_LOG_ERROR);
@@ -126,7 +127,7 @@ namespace ara
             {
                 // string ctor usage might not be no-throw guaranteed - implementation not to be used for series SW
                 const char *ctx_id = dltContext_->contextID;
-                return ara::core::String(ctx_id, static_cast<size_t>(DLT_ID_SIZE)).c_str();
+                return ara::core::StaticString<DLT_ID_SIZE>(ctx_id, static_cast<size_t>(DLT_ID_SIZE)).c_str();
             }
 
             DltContext *getContext() noexcept { return dltContext_.get(); }